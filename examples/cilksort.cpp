@@ -152,22 +152,14 @@ void cilksort(ityr::global_span<T> a, ityr::global_span<T> b) {
   cilkmerge(b12, b34, a);
 }
 
-template <typename T, typename Rng>
-T get_random_elem(Rng& r) {
-  static std::uniform_int_distribution<T> dist(0, std::numeric_limits<T>::max());
-  return dist(r);
-}
-
 template <typename T>
 void fill_array(ityr::global_span<T> s) {
   static int seed = 0;
-  std::mt19937 engine(seed++);
-
-  ityr::for_each(
-      ityr::execution::sequenced_policy{.checkout_count = cutoff_count},
-      ityr::make_global_iterator(s.begin(), ityr::checkout_mode::write),
-      ityr::make_global_iterator(s.end()  , ityr::checkout_mode::write),
-      [&](T& v) { v = get_random_elem<T>(engine); });
+  ityr::fill_random(
+      ityr::execution::parallel_policy{.cutoff_count   = cutoff_count,
+                                       .checkout_count = cutoff_count},
+      s.begin(), s.end(), seed++,
+      std::uniform_int_distribution<T>(0, std::numeric_limits<T>::max()));
 }
 
 template <typename T>
@@ -0,0 +1,152 @@
+/*
+ * Benchmark for collective memory allocation and deallocation
+ *
+ * Repeats cycles of collective allocation, initialization in the root thread, and deallocation,
+ * which often happens for temporary buffers allocated per iteration (e.g., the temporary array of
+ * cilksort and per-level frontiers of BFS). Allocation sizes are fixed or randomly chosen from
+ * [n/2, n] in each cycle.
+ *
+ * To measure the effect of recycling freed collective memory, compare the results with and without
+ * `ITYR_ORI_COLL_MEM_POOL_SIZE` (e.g., `ITYR_ORI_COLL_MEM_POOL_SIZE=1073741824`).
+ */
+
+#include "ityr/ityr.hpp"
+
+using elem_t = long;
+
+std::size_t n_elems      = std::size_t(1) * 1024 * 1024;
+int         n_cycles     = 100;
+int         n_repeats    = 10;
+std::size_t cutoff_count = std::size_t(16) * 1024;
+bool        vary_size    = false;
+
+std::size_t alloc_count(int r, int i) {
+  if (!vary_size) return n_elems;
+
+  // splitmix64-style hash to choose the same size on all processes
+  uint64_t z = static_cast<uint64_t>(r) * n_cycles + i + 0x9e3779b97f4a7c15;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+  z = z ^ (z >> 31);
+  return n_elems / 2 + z % (n_elems - n_elems / 2 + 1);
+}
+
+void run() {
+  for (int r = 0; r < n_repeats; r++) {
+    ityr::profiler_begin();
+
+    uint64_t alloc_time = 0;
+    uint64_t free_time  = 0;
+
+    auto t0 = ityr::gettime_ns();
+
+    for (int i = 0; i < n_cycles; i++) {
+      std::size_t n = alloc_count(r, i);
+
+      auto t1 = ityr::gettime_ns();
+
+      ityr::ori::global_ptr<elem_t> p = ityr::ori::malloc_coll<elem_t>(n);
+
+      auto t2 = ityr::gettime_ns();
+
+      ityr::root_exec([=] {
+        ityr::execution::parallel_policy policy {.cutoff_count   = cutoff_count,
+                                                 .checkout_count = cutoff_count};
+        ityr::fill(policy, p, p + n, elem_t(i));
+      });
+
+      auto t3 = ityr::gettime_ns();
+
+      ityr::ori::free_coll(p);
+
+      auto t4 = ityr::gettime_ns();
+
+      alloc_time += t2 - t1;
+      free_time  += t4 - t3;
+    }
+
+    auto t5 = ityr::gettime_ns();
+
+    ityr::profiler_end();
+
+    if (ityr::is_master()) {
+      printf("[%d] %'14ld ns - malloc_coll: %'10ld ns/cycle, free_coll: %'10ld ns/cycle\n",
+             r, t5 - t0, alloc_time / n_cycles, free_time / n_cycles);
+      fflush(stdout);
+    }
+
+    ityr::profiler_flush();
+  }
+}
+
+void show_help_and_exit(int argc [[maybe_unused]], char** argv) {
+  if (ityr::is_master()) {
+    printf("Usage: %s [options]\n"
+           "  options:\n"
+           "    -n : (Maximum) number of elements per allocation (size_t)\n"
+           "    -i : # of allocation cycles per repeat (int)\n"
+           "    -r : # of repeats (int)\n"
+           "    -c : cutoff count for leaf tasks (size_t)\n"
+           "    -v : vary allocation sizes in [n/2, n] (int)\n", argv[0]);
+  }
+  exit(1);
+}
+
+int main(int argc, char** argv) {
+  ityr::init();
+
+  int opt;
+  while ((opt = getopt(argc, argv, "n:i:r:c:v:h")) != EOF) {
+    switch (opt) {
+      case 'n':
+        n_elems = atoll(optarg);
+        break;
+      case 'i':
+        n_cycles = atoi(optarg);
+        break;
+      case 'r':
+        n_repeats = atoi(optarg);
+        break;
+      case 'c':
+        cutoff_count = atoll(optarg);
+        break;
+      case 'v':
+        vary_size = atoi(optarg);
+        break;
+      case 'h':
+      default:
+        show_help_and_exit(argc, argv);
+    }
+  }
+
+  if (n_elems < 2 || n_cycles <= 0) {
+    show_help_and_exit(argc, argv);
+  }
+
+  if (ityr::is_master()) {
+    setlocale(LC_NUMERIC, "en_US.UTF-8");
+    printf("=============================================================\n"
+           "[Collective allocation]\n"
+           "# of processes:               %d\n"
+           "# of elements:                %ld\n"
+           "# of cycles:                  %d\n"
+           "# of repeats:                 %d\n"
+           "Cutoff count:                 %ld\n"
+           "Vary sizes:                   %d\n"
+           "-------------------------------------------------------------\n",
+           ityr::n_ranks(), n_elems, n_cycles, n_repeats, cutoff_count, vary_size);
+
+    printf("[Compile Options]\n");
+    ityr::print_compile_options();
+    printf("-------------------------------------------------------------\n");
+    printf("[Runtime Options]\n");
+    ityr::print_runtime_options();
+    printf("=============================================================\n\n");
+    fflush(stdout);
+  }
+
+  run();
+
+  ityr::fini();
+  return 0;
+}
@@ -0,0 +1,158 @@
+/*
+ * Benchmark for short-circuiting search algorithms over global memory
+ *
+ * A global array of n elements is filled with zeros except for a single target element. The
+ * position of the target is either near the beginning (early hit) or at the end (late hit) of the
+ * array. `ityr::find()` and `ityr::any_of()` are compared with `ityr::count_if()`, which always
+ * scans the entire array.
+ */
+
+#include "ityr/ityr.hpp"
+
+using elem_t = long;
+
+std::size_t n_input        = std::size_t(1) * 1024 * 1024;
+int         n_repeats      = 10;
+std::size_t cutoff_count   = std::size_t(16) * 1024;
+std::size_t checkout_count = std::size_t(1) * 1024;
+double      hit_ratio      = 0.01;
+
+template <typename Kernel>
+void run_kernel(const char* name, int r, Kernel kernel) {
+  ityr::profiler_begin();
+
+  auto t0 = ityr::gettime_ns();
+
+  auto ret = ityr::root_exec(kernel);
+
+  auto t1 = ityr::gettime_ns();
+
+  ityr::profiler_end();
+
+  if (ityr::is_master()) {
+    printf("[%d] %-24s %'14ld ns  (result = %ld)\n", r, name, t1 - t0, static_cast<long>(ret));
+    fflush(stdout);
+  }
+
+  ityr::profiler_flush();
+}
+
+void run() {
+  ityr::global_vector_options gvec_coll_opts {
+    .collective         = true,
+    .parallel_construct = true,
+    .parallel_destruct  = true,
+    .cutoff_count       = cutoff_count,
+  };
+
+  ityr::global_vector<elem_t> a_vec(gvec_coll_opts, n_input);
+  ityr::global_span<elem_t> a(a_vec.begin(), a_vec.end());
+
+  ityr::execution::parallel_policy policy {.cutoff_count   = cutoff_count,
+                                           .checkout_count = checkout_count};
+
+  ityr::root_exec([=] {
+    ityr::fill(policy, a.begin(), a.end(), 0);
+  });
+
+  std::size_t early_pos = std::min(static_cast<std::size_t>(n_input * hit_ratio), n_input - 1);
+  std::size_t late_pos  = n_input - 1;
+
+  for (auto [label, pos] : {std::make_pair("early", early_pos),
+                            std::make_pair("late" , late_pos)}) {
+    ityr::root_exec([=] {
+      a[pos].put(1);
+    });
+
+    if (ityr::is_master()) {
+      printf("-- %s hit (position = %ld) --\n", label, pos);
+      fflush(stdout);
+    }
+
+    for (int r = 0; r < n_repeats; r++) {
+      run_kernel("find", r, [=] {
+        return ityr::find(policy, a.begin(), a.end(), 1) - a.begin();
+      });
+      run_kernel("any_of", r, [=] {
+        return ityr::any_of(policy, a.begin(), a.end(), [](elem_t x) { return x == 1; });
+      });
+      run_kernel("count_if (full scan)", r, [=] {
+        return ityr::count_if(policy, a.begin(), a.end(), [](elem_t x) { return x == 1; });
+      });
+    }
+
+    ityr::root_exec([=] {
+      a[pos].put(0);
+    });
+  }
+}
+
+void show_help_and_exit(int argc [[maybe_unused]], char** argv) {
+  if (ityr::is_master()) {
+    printf("Usage: %s [options]\n"
+           "  options:\n"
+           "    -n : Number of elements (size_t)\n"
+           "    -r : # of repeats (int)\n"
+           "    -c : cutoff count for leaf tasks (size_t)\n"
+           "    -s : checkout count (size_t)\n"
+           "    -p : relative position of the target element for early hits (double)\n", argv[0]);
+  }
+  exit(1);
+}
+
+int main(int argc, char** argv) {
+  ityr::init();
+
+  int opt;
+  while ((opt = getopt(argc, argv, "n:r:c:s:p:h")) != EOF) {
+    switch (opt) {
+      case 'n':
+        n_input = atoll(optarg);
+        break;
+      case 'r':
+        n_repeats = atoi(optarg);
+        break;
+      case 'c':
+        cutoff_count = atoll(optarg);
+        break;
+      case 's':
+        checkout_count = atoll(optarg);
+        break;
+      case 'p':
+        hit_ratio = atof(optarg);
+        break;
+      case 'h':
+      default:
+        show_help_and_exit(argc, argv);
+    }
+  }
+
+  if (ityr::is_master()) {
+    setlocale(LC_NUMERIC, "en_US.UTF-8");
+    printf("=============================================================\n"
+           "[find]\n"
+           "# of processes:               %d\n"
+           "Element size:                 %ld bytes\n"
+           "N:                            %ld\n"
+           "# of repeats:                 %d\n"
+           "Cutoff count:                 %ld\n"
+           "Checkout count:               %ld\n"
+           "Early hit position:           %f\n"
+           "-------------------------------------------------------------\n",
+           ityr::n_ranks(), sizeof(elem_t), n_input, n_repeats,
+           cutoff_count, checkout_count, hit_ratio);
+
+    printf("[Compile Options]\n");
+    ityr::print_compile_options();
+    printf("-------------------------------------------------------------\n");
+    printf("[Runtime Options]\n");
+    ityr::print_runtime_options();
+    printf("=============================================================\n\n");
+    fflush(stdout);
+  }
+
+  run();
+
+  ityr::fini();
+  return 0;
+}
@@ -0,0 +1,144 @@
+/*
+ * Benchmark for contended global locks
+ *
+ * All processes repeatedly acquire and release the same global lock on the target process,
+ * holding it for a short critical section that updates a counter in the target process.
+ * The average acquisition latency and the number of RMA operations issued per acquisition are
+ * reported for the spinlock (`ityr::common::global_lock_spin`) and the MCS queue lock
+ * (`ityr::common::global_lock_mcs`).
+ *
+ * With the spinlock, waiting processes keep issuing remote CAS operations to the target, and thus
+ * the number of RMA operations per acquisition grows with the number of processes. With the MCS
+ * lock, each waiter spins on a flag in its own window, and it stays constant.
+ */
+
+#include "ityr/ityr.hpp"
+
+std::size_t n_acquires = 1000;
+int         target     = 0;
+int         n_repeats  = 10;
+uint64_t    cs_time_ns = 1000;
+
+template <typename Lock>
+void run_lock(const char* name) {
+  Lock lock;
+
+  using value_t = std::size_t;
+  ityr::common::mpi_win_manager<value_t> counter_win(ityr::common::topology::mpicomm(), 1);
+
+  for (int r = 0; r < n_repeats; r++) {
+    ityr::common::mpi_barrier(ityr::common::topology::mpicomm());
+
+    std::size_t n_ops0 = lock.n_rma_ops();
+    uint64_t acquire_time = 0;
+
+    auto t0 = ityr::gettime_ns();
+
+    for (std::size_t i = 0; i < n_acquires; i++) {
+      auto t1 = ityr::gettime_ns();
+      lock.lock(target);
+      acquire_time += ityr::gettime_ns() - t1;
+
+      auto v = ityr::common::mpi_get_value<value_t>(target, 0, counter_win.win());
+
+      auto t2 = ityr::gettime_ns();
+      while (ityr::gettime_ns() - t2 < cs_time_ns);
+
+      ityr::common::mpi_put_value<value_t>(v + 1, target, 0, counter_win.win());
+
+      lock.unlock(target);
+    }
+
+    ityr::common::mpi_barrier(ityr::common::topology::mpicomm());
+
+    auto t3 = ityr::gettime_ns();
+
+    std::size_t n_ops = lock.n_rma_ops() - n_ops0;
+
+    auto total_acquire_time = ityr::common::mpi_reduce_value(acquire_time, 0, ityr::common::topology::mpicomm());
+    auto total_ops          = ityr::common::mpi_reduce_value(n_ops, 0, ityr::common::topology::mpicomm());
+
+    if (ityr::is_master()) {
+      std::size_t n_total = n_acquires * ityr::n_ranks();
+      printf("[%s][%d] %'14ld ns - acquisition latency: %'10ld ns, RMA ops per acquisition: %.2f\n",
+             name, r, t3 - t0, total_acquire_time / n_total, static_cast<double>(total_ops) / n_total);
+      fflush(stdout);
+    }
+  }
+
+  if (ityr::common::topology::my_rank() == target) {
+    std::size_t expected = n_acquires * n_repeats * ityr::n_ranks();
+    if (counter_win.local_buf()[0] != expected) {
+      printf("[%s] Wrong result: counter = %ld (expected: %ld)\n", name, counter_win.local_buf()[0], expected);
+      fflush(stdout);
+    }
+  }
+}
+
+void show_help_and_exit(int argc [[maybe_unused]], char** argv) {
+  if (ityr::is_master()) {
+    printf("Usage: %s [options]\n"
+           "  options:\n"
+           "    -n : # of lock acquisitions per process (size_t)\n"
+           "    -t : rank of the target process holding the lock (int)\n"
+           "    -s : time spent in the critical section in ns (uint64_t)\n"
+           "    -r : # of repeats (int)\n", argv[0]);
+  }
+  exit(1);
+}
+
+int main(int argc, char** argv) {
+  ityr::init();
+
+  int opt;
+  while ((opt = getopt(argc, argv, "n:t:s:r:h")) != EOF) {
+    switch (opt) {
+      case 'n':
+        n_acquires = atoll(optarg);
+        break;
+      case 't':
+        target = atoi(optarg);
+        break;
+      case 's':
+        cs_time_ns = atoll(optarg);
+        break;
+      case 'r':
+        n_repeats = atoi(optarg);
+        break;
+      case 'h':
+      default:
+        show_help_and_exit(argc, argv);
+    }
+  }
+
+  if (target < 0 || target >= ityr::n_ranks()) {
+    show_help_and_exit(argc, argv);
+  }
+
+  if (ityr::is_master()) {
+    setlocale(LC_NUMERIC, "en_US.UTF-8");
+    printf("=============================================================\n"
+           "[Lock contention]\n"
+           "# of processes:               %d\n"
+           "# of acquisitions:            %ld\n"
+           "Target rank:                  %d\n"
+           "Critical section time (ns):   %ld\n"
+           "# of repeats:                 %d\n"
+           "-------------------------------------------------------------\n",
+           ityr::n_ranks(), n_acquires, target, cs_time_ns, n_repeats);
+
+    printf("[Compile Options]\n");
+    ityr::print_compile_options();
+    printf("-------------------------------------------------------------\n");
+    printf("[Runtime Options]\n");
+    ityr::print_runtime_options();
+    printf("=============================================================\n\n");
+    fflush(stdout);
+  }
+
+  run_lock<ityr::common::global_lock_spin>("spin");
+  run_lock<ityr::common::global_lock_mcs>("mcs");
+
+  ityr::fini();
+  return 0;
+}
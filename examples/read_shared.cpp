@@ -0,0 +1,186 @@
+/*
+ * Benchmark for read-shared access to a small global table
+ *
+ * A global table of n elements (e.g., pivots or hub vertices) is read by many tasks spread over
+ * all processes. Each of m queries reads a window of w consecutive elements at a pseudo-random
+ * position of the table and sums them up. As all processes read the same table, the same remote
+ * blocks are fetched by every process on the same node unless the node-shared cache is enabled.
+ *
+ * To measure the reduction of inter-node traffic, compare the results with and without
+ * `ITYR_ORI_NODE_CACHE_SIZE` (e.g., `ITYR_ORI_NODE_CACHE_SIZE=67108864`), compiled with
+ * `-DITYR_ORI_CACHE_PROF=stats`. "Fetched" bytes minus "Node cache hit" bytes is the amount of
+ * data transferred via RMA.
+ */
+
+#include "ityr/ityr.hpp"
+
+using elem_t = long;
+
+std::size_t n_table       = std::size_t(1) * 1024 * 1024;
+std::size_t n_queries     = std::size_t(1) * 1024 * 1024;
+std::size_t window        = 16;
+int         n_repeats     = 10;
+std::size_t cutoff_count  = std::size_t(1) * 1024;
+bool        verify_result = true;
+
+std::size_t query_pos(std::size_t i) {
+  // splitmix64-style hash to scatter queries over the table
+  uint64_t z = i + 0x9e3779b97f4a7c15;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+  z = z ^ (z >> 31);
+  return z % (n_table - window + 1);
+}
+
+elem_t run_queries(ityr::global_span<elem_t> table) {
+  ityr::execution::parallel_policy policy {.cutoff_count   = cutoff_count,
+                                           .checkout_count = cutoff_count};
+
+  return ityr::transform_reduce(
+      policy,
+      ityr::count_iterator<std::size_t>(0),
+      ityr::count_iterator<std::size_t>(n_queries),
+      elem_t(0),
+      std::plus<elem_t>{},
+      [=](std::size_t i) {
+        auto cs = ityr::make_checkout(table.data() + query_pos(i), window, ityr::checkout_mode::read);
+        elem_t sum = 0;
+        for (std::size_t j = 0; j < window; j++) {
+          sum += cs[j];
+        }
+        return sum;
+      });
+}
+
+elem_t expected_result() {
+  // table[k] = k
+  elem_t ret = 0;
+  for (std::size_t i = 0; i < n_queries; i++) {
+    elem_t p = query_pos(i);
+    ret += p * window + window * (window - 1) / 2;
+  }
+  return ret;
+}
+
+void run() {
+  ityr::global_vector_options gvec_coll_opts {
+    .collective         = true,
+    .parallel_construct = true,
+    .parallel_destruct  = true,
+    .cutoff_count       = cutoff_count,
+  };
+
+  ityr::global_vector<elem_t> table_vec(gvec_coll_opts, n_table);
+  ityr::global_span<elem_t> table(table_vec.begin(), table_vec.end());
+
+  ityr::root_exec([=] {
+    ityr::execution::parallel_policy policy {.cutoff_count   = cutoff_count,
+                                             .checkout_count = cutoff_count};
+    ityr::iota(policy, table.begin(), table.end(), elem_t(0));
+  });
+
+  elem_t expected = verify_result ? expected_result() : 0;
+
+  for (int r = 0; r < n_repeats; r++) {
+    ityr::profiler_begin();
+
+    auto t0 = ityr::gettime_ns();
+
+    elem_t result = ityr::root_exec([=] {
+      return run_queries(table);
+    });
+
+    auto t1 = ityr::gettime_ns();
+
+    ityr::profiler_end();
+
+    if (ityr::is_master()) {
+      printf("[%d] %'14ld ns", r, t1 - t0);
+      if (verify_result) {
+        printf(" - %s", result == expected ? "Result verified" : "Wrong result");
+      }
+      printf("\n");
+      fflush(stdout);
+    }
+
+    ityr::profiler_flush();
+  }
+}
+
+void show_help_and_exit(int argc [[maybe_unused]], char** argv) {
+  if (ityr::is_master()) {
+    printf("Usage: %s [options]\n"
+           "  options:\n"
+           "    -n : Number of elements in the table (size_t)\n"
+           "    -m : Number of queries (size_t)\n"
+           "    -w : Number of elements read by each query (size_t)\n"
+           "    -r : # of repeats (int)\n"
+           "    -c : cutoff count for leaf tasks (size_t)\n"
+           "    -v : verify the result (int)\n", argv[0]);
+  }
+  exit(1);
+}
+
+int main(int argc, char** argv) {
+  ityr::init();
+
+  int opt;
+  while ((opt = getopt(argc, argv, "n:m:w:r:c:v:h")) != EOF) {
+    switch (opt) {
+      case 'n':
+        n_table = atoll(optarg);
+        break;
+      case 'm':
+        n_queries = atoll(optarg);
+        break;
+      case 'w':
+        window = atoll(optarg);
+        break;
+      case 'r':
+        n_repeats = atoi(optarg);
+        break;
+      case 'c':
+        cutoff_count = atoll(optarg);
+        break;
+      case 'v':
+        verify_result = atoi(optarg);
+        break;
+      case 'h':
+      default:
+        show_help_and_exit(argc, argv);
+    }
+  }
+
+  if (window == 0 || window > n_table) {
+    show_help_and_exit(argc, argv);
+  }
+
+  if (ityr::is_master()) {
+    setlocale(LC_NUMERIC, "en_US.UTF-8");
+    printf("=============================================================\n"
+           "[Read-shared table]\n"
+           "# of processes:               %d\n"
+           "# of table elements:          %ld\n"
+           "# of queries:                 %ld\n"
+           "Window size:                  %ld\n"
+           "# of repeats:                 %d\n"
+           "Cutoff count:                 %ld\n"
+           "Verify result:                %d\n"
+           "-------------------------------------------------------------\n",
+           ityr::n_ranks(), n_table, n_queries, window, n_repeats,
+           cutoff_count, verify_result);
+
+    printf("[Compile Options]\n");
+    ityr::print_compile_options();
+    printf("-------------------------------------------------------------\n");
+    printf("[Runtime Options]\n");
+    ityr::print_runtime_options();
+    printf("=============================================================\n\n");
+    fflush(stdout);
+  }
+
+  run();
+
+  ityr::fini();
+  return 0;
+}
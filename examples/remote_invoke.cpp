@@ -0,0 +1,197 @@
+/*
+ * Benchmark for small updates on remote data (function shipping vs. checkout/checkin)
+ *
+ * m updates are issued in parallel to n counters (e.g., buckets of a global hash table) at
+ * pseudo-random positions, and each update increments the counter by one. Counters are
+ * distributed over all processes.
+ *
+ * The update is performed in two ways:
+ * - "remote_invoke": the increment is shipped to the owner of the counter with
+ *   `ityr::remote_invoke()`, which executes it atomically at the owner process.
+ * - "checkout": the counter is checked out with the read-write mode and incremented by the
+ *   requester, which takes a global lock at the owner process and fences to make the update
+ *   atomic and visible to other processes.
+ */
+
+#include "ityr/ityr.hpp"
+
+using counter_t = long;
+
+std::size_t n_counters    = std::size_t(1) * 1024 * 1024;
+std::size_t n_updates     = std::size_t(1) * 1024 * 1024;
+int         n_repeats     = 10;
+std::size_t cutoff_count  = std::size_t(1) * 1024;
+bool        verify_result = true;
+
+constexpr int n_locks = 64;
+ityr::common::global_lock_spin* counter_lock;
+
+std::size_t update_pos(std::size_t i) {
+  // splitmix64-style hash to scatter updates over the counters
+  uint64_t z = i + 0x9e3779b97f4a7c15;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+  z = z ^ (z >> 31);
+  return z % n_counters;
+}
+
+void update_remote_invoke(ityr::global_span<counter_t> counters, std::size_t i) {
+  ityr::remote_invoke(counters.data() + update_pos(i), [](counter_t& c) { c++; });
+}
+
+void update_checkout(ityr::global_span<counter_t> counters, std::size_t i) {
+  std::size_t pos = update_pos(i);
+  auto target_rank = ityr::ori::get_owner(counters.data() + pos);
+  int idx = pos % n_locks;
+
+  counter_lock->lock(target_rank, idx);
+  ityr::ori::acquire();
+
+  {
+    auto cs = ityr::make_checkout(counters.data() + pos, 1, ityr::checkout_mode::read_write);
+    cs[0]++;
+  }
+
+  ityr::ori::release();
+  counter_lock->unlock(target_rank, idx);
+}
+
+template <typename UpdateFn>
+void run_update(const char* name, ityr::global_span<counter_t> counters, UpdateFn update_fn) {
+  ityr::execution::parallel_policy policy {.cutoff_count   = cutoff_count,
+                                           .checkout_count = cutoff_count};
+
+  for (int r = 0; r < n_repeats; r++) {
+    ityr::root_exec([=] {
+      ityr::fill(policy, counters.begin(), counters.end(), counter_t(0));
+    });
+
+    ityr::profiler_begin();
+
+    auto t0 = ityr::gettime_ns();
+
+    ityr::root_exec([=] {
+      ityr::for_each(
+          policy,
+          ityr::count_iterator<std::size_t>(0),
+          ityr::count_iterator<std::size_t>(n_updates),
+          [=](std::size_t i) { update_fn(counters, i); });
+    });
+
+    auto t1 = ityr::gettime_ns();
+
+    ityr::profiler_end();
+
+    if (ityr::is_master()) {
+      printf("[%s][%d] %'14ld ns - %'10ld ns/update", name, r, t1 - t0, (t1 - t0) / n_updates);
+      fflush(stdout);
+    }
+
+    ityr::profiler_flush();
+
+    if (verify_result) {
+      counter_t sum = ityr::root_exec([=] {
+        return ityr::reduce(policy, counters.begin(), counters.end());
+      });
+      if (ityr::is_master()) {
+        printf(" - %s", sum == counter_t(n_updates) ? "Result verified" : "Wrong result");
+      }
+    }
+
+    if (ityr::is_master()) {
+      printf("\n");
+      fflush(stdout);
+    }
+  }
+}
+
+void run() {
+  ityr::global_vector_options gvec_coll_opts {
+    .collective         = true,
+    .parallel_construct = true,
+    .parallel_destruct  = true,
+    .cutoff_count       = cutoff_count,
+  };
+
+  ityr::global_vector<counter_t> counters_vec(gvec_coll_opts, n_counters);
+  ityr::global_span<counter_t> counters(counters_vec.begin(), counters_vec.end());
+
+  ityr::common::global_lock_spin lock(n_locks);
+  counter_lock = &lock;
+
+  run_update("remote_invoke", counters, update_remote_invoke);
+  run_update("checkout", counters, update_checkout);
+}
+
+void show_help_and_exit(int argc [[maybe_unused]], char** argv) {
+  if (ityr::is_master()) {
+    printf("Usage: %s [options]\n"
+           "  options:\n"
+           "    -n : Number of counters (size_t)\n"
+           "    -m : Number of updates (size_t)\n"
+           "    -r : # of repeats (int)\n"
+           "    -c : cutoff count for leaf tasks (size_t)\n"
+           "    -v : verify the result (int)\n", argv[0]);
+  }
+  exit(1);
+}
+
+int main(int argc, char** argv) {
+  ityr::init();
+
+  int opt;
+  while ((opt = getopt(argc, argv, "n:m:r:c:v:h")) != EOF) {
+    switch (opt) {
+      case 'n':
+        n_counters = atoll(optarg);
+        break;
+      case 'm':
+        n_updates = atoll(optarg);
+        break;
+      case 'r':
+        n_repeats = atoi(optarg);
+        break;
+      case 'c':
+        cutoff_count = atoll(optarg);
+        break;
+      case 'v':
+        verify_result = atoi(optarg);
+        break;
+      case 'h':
+      default:
+        show_help_and_exit(argc, argv);
+    }
+  }
+
+  if (n_counters == 0) {
+    show_help_and_exit(argc, argv);
+  }
+
+  if (ityr::is_master()) {
+    setlocale(LC_NUMERIC, "en_US.UTF-8");
+    printf("=============================================================\n"
+           "[Remote updates]\n"
+           "# of processes:               %d\n"
+           "# of counters:                %ld\n"
+           "# of updates:                 %ld\n"
+           "# of repeats:                 %d\n"
+           "Cutoff count:                 %ld\n"
+           "Verify result:                %d\n"
+           "-------------------------------------------------------------\n",
+           ityr::n_ranks(), n_counters, n_updates, n_repeats,
+           cutoff_count, verify_result);
+
+    printf("[Compile Options]\n");
+    ityr::print_compile_options();
+    printf("-------------------------------------------------------------\n");
+    printf("[Runtime Options]\n");
+    ityr::print_runtime_options();
+    printf("=============================================================\n\n");
+    fflush(stdout);
+  }
+
+  run();
+
+  ityr::fini();
+  return 0;
+}
@@ -0,0 +1,282 @@
+/*
+ * Delta-stepping single-source shortest paths (SSSP) on a synthetic random graph
+ *
+ * The graph has n vertices, each of which has d outgoing edges to uniformly random vertices with
+ * uniformly random weights in [0, 1). Edges are stored in global memory in a CSR-like format
+ * (without an offset array, as every vertex has the same degree).
+ *
+ * Vertices are processed in buckets of tentative distances of width delta, using
+ * `ityr::relaxed_priority_queue`. All edges of each vertex in the current bucket are relaxed in
+ * parallel, and vertices improved into the same bucket are processed again in the next round.
+ *
+ * Reference: U. Meyer and P. Sanders, "Delta-stepping: a parallelizable shortest path algorithm",
+ * J. Algorithms, 2003.
+ */
+
+#include <queue>
+
+#include "ityr/ityr.hpp"
+
+using vertex_t = long;
+using weight_t = double;
+
+using pq_t = ityr::relaxed_priority_queue<vertex_t, weight_t>;
+
+std::size_t n_vertices    = std::size_t(1) * 1024 * 1024;
+std::size_t degree        = 8;
+weight_t    delta         = 0.1;
+int         n_repeats     = 10;
+std::size_t cutoff_count  = 64;
+bool        verify_result = true;
+
+void relax(ityr::global_span<vertex_t> dst,
+           ityr::global_span<weight_t> weight,
+           pq_t::handle                h,
+           const pq_t::item&           it) {
+  std::size_t e_begin = it.key * degree;
+
+  auto dst_cs    = ityr::make_checkout(dst.data()    + e_begin, degree, ityr::checkout_mode::read);
+  auto weight_cs = ityr::make_checkout(weight.data() + e_begin, degree, ityr::checkout_mode::read);
+
+  for (std::size_t j = 0; j < degree; j++) {
+    h.push(dst_cs[j], it.priority + weight_cs[j]);
+  }
+}
+
+std::pair<std::size_t, std::size_t> sssp(ityr::global_span<vertex_t> dst,
+                                         ityr::global_span<weight_t> weight,
+                                         pq_t::handle                h) {
+  ityr::execution::parallel_policy policy {.cutoff_count   = cutoff_count,
+                                           .checkout_count = cutoff_count};
+
+  h.push(0, 0);
+
+  std::size_t n_rounds = 0;
+  std::size_t n_relaxed = 0;
+
+  while (true) {
+    auto frontier = h.pop_bucket();
+    if (frontier.empty()) break;
+
+    ityr::for_each(policy,
+                   ityr::make_global_iterator(frontier.begin(), ityr::checkout_mode::read),
+                   ityr::make_global_iterator(frontier.end()  , ityr::checkout_mode::read),
+                   [=](const pq_t::item& it) { relax(dst, weight, h, it); });
+
+    n_rounds++;
+    n_relaxed += frontier.size();
+  }
+
+  return {n_rounds, n_relaxed};
+}
+
+bool verify(ityr::global_span<vertex_t> dst,
+            ityr::global_span<weight_t> weight,
+            const pq_t&                 pq) {
+  constexpr weight_t inf = std::numeric_limits<weight_t>::max();
+
+  ityr::global_vector_options gvec_coll_opts {
+    .collective         = true,
+    .parallel_construct = true,
+    .parallel_destruct  = true,
+    .cutoff_count       = cutoff_count,
+  };
+
+  ityr::global_vector<weight_t> dist_vec(gvec_coll_opts, n_vertices, inf);
+  ityr::global_span<weight_t> dist(dist_vec.begin(), dist_vec.end());
+
+  // Gather the final distances from the owner processes
+  pq.for_each_local([&](vertex_t v, weight_t d) {
+    dist[v].put(d);
+  });
+
+  ityr::barrier();
+
+  bool success = true;
+
+  if (ityr::is_master()) {
+    // Serial Dijkstra's algorithm as the reference
+    std::vector<vertex_t> dst_local(n_vertices * degree);
+    std::vector<weight_t> weight_local(n_vertices * degree);
+    std::vector<weight_t> dist_local(n_vertices);
+
+    ityr::execution::sequenced_policy seq_policy {.checkout_count = 4096};
+    ityr::for_each(seq_policy,
+                   ityr::make_global_iterator(dst.begin(), ityr::checkout_mode::read),
+                   ityr::make_global_iterator(dst.end()  , ityr::checkout_mode::read),
+                   dst_local.begin(),
+                   [](vertex_t d, vertex_t& d_) { d_ = d; });
+    ityr::for_each(seq_policy,
+                   ityr::make_global_iterator(weight.begin(), ityr::checkout_mode::read),
+                   ityr::make_global_iterator(weight.end()  , ityr::checkout_mode::read),
+                   weight_local.begin(),
+                   [](weight_t w, weight_t& w_) { w_ = w; });
+    ityr::for_each(seq_policy,
+                   ityr::make_global_iterator(dist.begin(), ityr::checkout_mode::read),
+                   ityr::make_global_iterator(dist.end()  , ityr::checkout_mode::read),
+                   dist_local.begin(),
+                   [](weight_t d, weight_t& d_) { d_ = d; });
+
+    std::vector<weight_t> ref(n_vertices, inf);
+    using pq_elem_t = std::pair<weight_t, vertex_t>;
+    std::priority_queue<pq_elem_t, std::vector<pq_elem_t>, std::greater<pq_elem_t>> q;
+    ref[0] = 0;
+    q.push({0, 0});
+    while (!q.empty()) {
+      auto [d, v] = q.top();
+      q.pop();
+      if (d > ref[v]) continue;
+      for (std::size_t j = v * degree; j < (v + 1) * degree; j++) {
+        weight_t d_new = d + weight_local[j];
+        if (d_new < ref[dst_local[j]]) {
+          ref[dst_local[j]] = d_new;
+          q.push({d_new, dst_local[j]});
+        }
+      }
+    }
+
+    for (std::size_t v = 0; v < n_vertices; v++) {
+      // Distances are accumulated in different orders
+      if (std::abs(dist_local[v] - ref[v]) > 1e-9 * std::max(weight_t(1), ref[v])) {
+        printf("dist[%ld] = %f, but %f expected\n", v, dist_local[v], ref[v]);
+        success = false;
+        break;
+      }
+    }
+  }
+
+  return ityr::common::mpi_bcast_value(success, 0, ityr::common::topology::mpicomm());
+}
+
+void run() {
+  ityr::global_vector_options gvec_coll_opts {
+    .collective         = true,
+    .parallel_construct = true,
+    .parallel_destruct  = true,
+    .cutoff_count       = cutoff_count,
+  };
+
+  ityr::global_vector<vertex_t> dst_vec(gvec_coll_opts, n_vertices * degree);
+  ityr::global_vector<weight_t> weight_vec(gvec_coll_opts, n_vertices * degree);
+
+  ityr::global_span<vertex_t> dst(dst_vec.begin(), dst_vec.end());
+  ityr::global_span<weight_t> weight(weight_vec.begin(), weight_vec.end());
+
+  ityr::root_exec([=] {
+    ityr::execution::parallel_policy policy {.cutoff_count   = cutoff_count * degree,
+                                             .checkout_count = cutoff_count * degree};
+    ityr::fill_random(policy, dst.begin(), dst.end(), 0,
+                      std::uniform_int_distribution<vertex_t>(0, n_vertices - 1));
+    ityr::fill_random(policy, weight.begin(), weight.end(), 1,
+                      std::uniform_real_distribution<weight_t>(0, 1));
+  });
+
+  for (int r = 0; r < n_repeats; r++) {
+    pq_t pq(delta);
+
+    ityr::profiler_begin();
+
+    auto t0 = ityr::gettime_ns();
+
+    auto [n_rounds, n_relaxed] = ityr::root_exec([=, h = pq.get_handle()] {
+      return sssp(dst, weight, h);
+    });
+
+    auto t1 = ityr::gettime_ns();
+
+    ityr::profiler_end();
+
+    if (ityr::is_master()) {
+      printf("[%d] %ld ns (%ld rounds, %ld vertices relaxed)", r, t1 - t0, n_rounds, n_relaxed);
+      fflush(stdout);
+    }
+
+    ityr::profiler_flush();
+
+    if (verify_result) {
+      bool success = verify(dst, weight, pq);
+      if (ityr::is_master()) {
+        printf(" - %s", success ? "Result verified" : "Wrong result");
+      }
+    }
+
+    if (ityr::is_master()) {
+      printf("\n");
+      fflush(stdout);
+    }
+  }
+}
+
+void show_help_and_exit(int argc [[maybe_unused]], char** argv) {
+  if (ityr::is_master()) {
+    printf("Usage: %s [options]\n"
+           "  options:\n"
+           "    -n : Number of vertices (size_t)\n"
+           "    -d : Out-degree of each vertex (size_t)\n"
+           "    -e : Bucket width (delta) of Delta-stepping (double)\n"
+           "    -r : # of repeats (int)\n"
+           "    -c : cutoff count for leaf tasks (size_t)\n"
+           "    -v : verify the result (int)\n", argv[0]);
+  }
+  exit(1);
+}
+
+int main(int argc, char** argv) {
+  ityr::init();
+
+  int opt;
+  while ((opt = getopt(argc, argv, "n:d:e:r:c:v:h")) != EOF) {
+    switch (opt) {
+      case 'n':
+        n_vertices = atoll(optarg);
+        break;
+      case 'd':
+        degree = atoll(optarg);
+        break;
+      case 'e':
+        delta = atof(optarg);
+        break;
+      case 'r':
+        n_repeats = atoi(optarg);
+        break;
+      case 'c':
+        cutoff_count = atoll(optarg);
+        break;
+      case 'v':
+        verify_result = atoi(optarg);
+        break;
+      case 'h':
+      default:
+        show_help_and_exit(argc, argv);
+    }
+  }
+
+  if (ityr::is_master()) {
+    setlocale(LC_NUMERIC, "en_US.UTF-8");
+    printf("=============================================================\n"
+           "[SSSP (Delta-stepping)]\n"
+           "# of processes:               %d\n"
+           "# of vertices:                %ld\n"
+           "Degree:                       %ld\n"
+           "Delta:                        %f\n"
+           "# of repeats:                 %d\n"
+           "Cutoff count:                 %ld\n"
+           "Verify result:                %d\n"
+           "-------------------------------------------------------------\n",
+           ityr::n_ranks(), n_vertices, degree, delta, n_repeats,
+           cutoff_count, verify_result);
+
+    printf("[Compile Options]\n");
+    ityr::print_compile_options();
+    printf("-------------------------------------------------------------\n");
+    printf("[Runtime Options]\n");
+    ityr::print_runtime_options();
+    printf("=============================================================\n\n");
+    fflush(stdout);
+  }
+
+  run();
+
+  ityr::fini();
+  return 0;
+}
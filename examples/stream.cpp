@@ -0,0 +1,232 @@
+/*
+ * STREAM-style memory bandwidth benchmark over global memory
+ *
+ * Kernels (a, b, c are global arrays of n elements):
+ *   Copy:  c[i] = a[i]
+ *   Scale: b[i] = s * c[i]
+ *   Add:   c[i] = a[i] + b[i]
+ *   Triad: a[i] = b[i] + s * c[i]
+ *
+ * Reference: John D. McCalpin, "Memory Bandwidth and Machine Balance in Current High
+ * Performance Computers", IEEE TCCA Newsletter, 1995.
+ */
+
+#include "ityr/ityr.hpp"
+
+using elem_t = double;
+
+std::size_t n_input       = std::size_t(1) * 1024 * 1024;
+int         n_repeats     = 10;
+std::size_t cutoff_count  = std::size_t(16) * 1024;
+int         use_chunk     = 1;
+bool        verify_result = true;
+
+constexpr elem_t scalar = 3.0;
+
+template <typename Kernel>
+void run_kernel(const char* name, std::size_t bytes_per_elem, int r, Kernel kernel) {
+  ityr::profiler_begin();
+
+  auto t0 = ityr::gettime_ns();
+
+  ityr::root_exec(kernel);
+
+  auto t1 = ityr::gettime_ns();
+
+  ityr::profiler_end();
+
+  if (ityr::is_master()) {
+    double gbps = static_cast<double>(bytes_per_elem * n_input) / (t1 - t0);
+    printf("[%d] %-6s %'12ld ns  %8.3f GB/s\n", r, name, t1 - t0, gbps);
+    fflush(stdout);
+  }
+
+  ityr::profiler_flush();
+}
+
+void run() {
+  ityr::global_vector_options gvec_coll_opts {
+    .collective         = true,
+    .parallel_construct = true,
+    .parallel_destruct  = true,
+    .cutoff_count       = cutoff_count,
+  };
+
+  ityr::global_vector<elem_t> a_vec(gvec_coll_opts, n_input);
+  ityr::global_vector<elem_t> b_vec(gvec_coll_opts, n_input);
+  ityr::global_vector<elem_t> c_vec(gvec_coll_opts, n_input);
+
+  ityr::global_span<elem_t> a(a_vec.begin(), a_vec.end());
+  ityr::global_span<elem_t> b(b_vec.begin(), b_vec.end());
+  ityr::global_span<elem_t> c(c_vec.begin(), c_vec.end());
+
+  ityr::execution::parallel_policy policy {.cutoff_count   = cutoff_count,
+                                           .checkout_count = cutoff_count};
+
+  ityr::root_exec([=] {
+    ityr::fill(policy, a.begin(), a.end(), 1.0);
+    ityr::fill(policy, b.begin(), b.end(), 2.0);
+    ityr::fill(policy, c.begin(), c.end(), 0.0);
+  });
+
+  for (int r = 0; r < n_repeats; r++) {
+    if (use_chunk) {
+      run_kernel("Copy", 2 * sizeof(elem_t), r, [=] {
+        ityr::transform_chunk(policy, a.begin(), a.end(), c.begin(),
+                              [](const elem_t* first, const elem_t* last, elem_t* d) {
+                                std::size_t n = last - first;
+                                for (std::size_t i = 0; i < n; i++) d[i] = first[i];
+                              });
+      });
+      run_kernel("Scale", 2 * sizeof(elem_t), r, [=] {
+        ityr::transform_chunk(policy, c.begin(), c.end(), b.begin(),
+                              [](const elem_t* first, const elem_t* last, elem_t* d) {
+                                std::size_t n = last - first;
+                                for (std::size_t i = 0; i < n; i++) d[i] = scalar * first[i];
+                              });
+      });
+      run_kernel("Add", 3 * sizeof(elem_t), r, [=] {
+        ityr::transform_chunk(policy, a.begin(), a.end(), b.begin(), c.begin(),
+                              [](const elem_t* first1, const elem_t* last1, const elem_t* first2, elem_t* d) {
+                                std::size_t n = last1 - first1;
+                                for (std::size_t i = 0; i < n; i++) d[i] = first1[i] + first2[i];
+                              });
+      });
+      run_kernel("Triad", 3 * sizeof(elem_t), r, [=] {
+        ityr::transform_chunk(policy, b.begin(), b.end(), c.begin(), a.begin(),
+                              [](const elem_t* first1, const elem_t* last1, const elem_t* first2, elem_t* d) {
+                                std::size_t n = last1 - first1;
+                                for (std::size_t i = 0; i < n; i++) d[i] = first1[i] + scalar * first2[i];
+                              });
+      });
+    } else {
+      run_kernel("Copy", 2 * sizeof(elem_t), r, [=] {
+        ityr::for_each(policy,
+                       ityr::make_global_iterator(a.begin(), ityr::checkout_mode::read),
+                       ityr::make_global_iterator(a.end()  , ityr::checkout_mode::read),
+                       ityr::make_global_iterator(c.begin(), ityr::checkout_mode::write),
+                       [](const elem_t& x, elem_t& y) { y = x; });
+      });
+      run_kernel("Scale", 2 * sizeof(elem_t), r, [=] {
+        ityr::for_each(policy,
+                       ityr::make_global_iterator(c.begin(), ityr::checkout_mode::read),
+                       ityr::make_global_iterator(c.end()  , ityr::checkout_mode::read),
+                       ityr::make_global_iterator(b.begin(), ityr::checkout_mode::write),
+                       [](const elem_t& x, elem_t& y) { y = scalar * x; });
+      });
+      run_kernel("Add", 3 * sizeof(elem_t), r, [=] {
+        ityr::for_each(policy,
+                       ityr::make_global_iterator(a.begin(), ityr::checkout_mode::read),
+                       ityr::make_global_iterator(a.end()  , ityr::checkout_mode::read),
+                       ityr::make_global_iterator(b.begin(), ityr::checkout_mode::read),
+                       ityr::make_global_iterator(c.begin(), ityr::checkout_mode::write),
+                       [](const elem_t& x, const elem_t& y, elem_t& z) { z = x + y; });
+      });
+      run_kernel("Triad", 3 * sizeof(elem_t), r, [=] {
+        ityr::for_each(policy,
+                       ityr::make_global_iterator(b.begin(), ityr::checkout_mode::read),
+                       ityr::make_global_iterator(b.end()  , ityr::checkout_mode::read),
+                       ityr::make_global_iterator(c.begin(), ityr::checkout_mode::read),
+                       ityr::make_global_iterator(a.begin(), ityr::checkout_mode::write),
+                       [](const elem_t& x, const elem_t& y, elem_t& z) { z = x + scalar * y; });
+      });
+    }
+  }
+
+  if (verify_result) {
+    // Replay the kernels on scalars to get the expected values
+    elem_t aj = 1.0, bj = 2.0, cj = 0.0;
+    for (int r = 0; r < n_repeats; r++) {
+      cj = aj;
+      bj = scalar * cj;
+      cj = aj + bj;
+      aj = bj + scalar * cj;
+    }
+
+    auto [a_sum, b_sum, c_sum] = ityr::root_exec([=] {
+      return std::make_tuple(ityr::reduce(policy, a.begin(), a.end()),
+                             ityr::reduce(policy, b.begin(), b.end()),
+                             ityr::reduce(policy, c.begin(), c.end()));
+    });
+
+    auto check = [](elem_t sum, elem_t expected) {
+      return std::abs(sum - expected * n_input) <= 1e-8 * std::abs(expected * n_input);
+    };
+    bool success = check(a_sum, aj) && check(b_sum, bj) && check(c_sum, cj);
+
+    if (ityr::is_master()) {
+      printf(success ? "Result verified\n" : "Wrong result\n");
+      fflush(stdout);
+    }
+  }
+}
+
+void show_help_and_exit(int argc [[maybe_unused]], char** argv) {
+  if (ityr::is_master()) {
+    printf("Usage: %s [options]\n"
+           "  options:\n"
+           "    -n : Number of elements in each array (size_t)\n"
+           "    -r : # of repeats (int)\n"
+           "    -c : cutoff/checkout count for leaf tasks (size_t)\n"
+           "    -k : use chunked leaf kernels (int)\n"
+           "    -v : verify the result (int)\n", argv[0]);
+  }
+  exit(1);
+}
+
+int main(int argc, char** argv) {
+  ityr::init();
+
+  int opt;
+  while ((opt = getopt(argc, argv, "n:r:c:k:v:h")) != EOF) {
+    switch (opt) {
+      case 'n':
+        n_input = atoll(optarg);
+        break;
+      case 'r':
+        n_repeats = atoi(optarg);
+        break;
+      case 'c':
+        cutoff_count = atoll(optarg);
+        break;
+      case 'k':
+        use_chunk = atoi(optarg);
+        break;
+      case 'v':
+        verify_result = atoi(optarg);
+        break;
+      case 'h':
+      default:
+        show_help_and_exit(argc, argv);
+    }
+  }
+
+  if (ityr::is_master()) {
+    setlocale(LC_NUMERIC, "en_US.UTF-8");
+    printf("=============================================================\n"
+           "[STREAM]\n"
+           "# of processes:               %d\n"
+           "Element size:                 %ld bytes\n"
+           "N:                            %ld\n"
+           "# of repeats:                 %d\n"
+           "Cutoff count:                 %ld\n"
+           "Chunked kernels:              %d\n"
+           "Verify result:                %d\n"
+           "-------------------------------------------------------------\n",
+           ityr::n_ranks(), sizeof(elem_t), n_input, n_repeats,
+           cutoff_count, use_chunk, verify_result);
+
+    printf("[Compile Options]\n");
+    ityr::print_compile_options();
+    printf("-------------------------------------------------------------\n");
+    printf("[Runtime Options]\n");
+    ityr::print_runtime_options();
+    printf("=============================================================\n\n");
+    fflush(stdout);
+  }
+
+  run();
+
+  ityr::fini();
+  return 0;
+}
@@ -0,0 +1,225 @@
+/*
+ * Benchmark for spawning a dynamic number of child tasks
+ *
+ * The root thread spawns n tasks, each of which computes fib(k) (or fib(k + i % 4) for the i-th
+ * task if irregular) serially and writes the result to a global array.
+ *
+ * The tasks are spawned in two ways:
+ * - "task_group": tasks are registered to `ityr::task_group` and executed by `wait()`, which
+ *   arranges them as a balanced spawn tree with work hints proportional to the cost of each task.
+ * - "thread_array": tasks are forked one by one as `ityr::ito::thread`s, whose handles are kept
+ *   in an array on the root thread's stack, and then joined sequentially.
+ */
+
+#include <array>
+#include <cmath>
+
+#include "ityr/ityr.hpp"
+
+using result_t = uint64_t;
+
+std::size_t n_tasks       = 4096;
+int         n_input       = 20;
+bool        irregular     = false;
+int         n_repeats     = 10;
+bool        verify_result = true;
+
+// The thread array is allocated on the stack of the root thread
+constexpr std::size_t max_thread_array_tasks = 8192;
+
+result_t fib_serial(int n) {
+  if (n <= 1) {
+    return 1;
+  } else {
+    return fib_serial(n - 1) + fib_serial(n - 2);
+  }
+}
+
+int task_input(std::size_t i) {
+  return irregular ? n_input + static_cast<int>(i % 4) : n_input;
+}
+
+double task_work(std::size_t i) {
+  // the cost of fib(n) grows by a factor of the golden ratio
+  return std::pow(1.618, task_input(i) - n_input);
+}
+
+void run_task_group(ityr::global_span<result_t> results) {
+  ityr::root_exec([=] {
+    ityr::task_group tg;
+    for (std::size_t i = 0; i < n_tasks; i++) {
+      int input = task_input(i);
+      tg.run([=] { results[i].put(fib_serial(input)); }, task_work(i));
+    }
+    tg.wait();
+  });
+}
+
+void run_thread_array(ityr::global_span<result_t> results) {
+  ityr::root_exec([=] {
+    std::array<ityr::ito::thread<void>, max_thread_array_tasks> ths;
+
+    auto rh = ityr::ori::release_lazy();
+    auto tgdata = ityr::ito::task_group_begin();
+
+    bool all_serialized = true;
+    for (std::size_t i = 0; i < n_tasks; i++) {
+      int input = task_input(i);
+      ths[i] = ityr::ito::thread<void>(
+          ityr::ito::with_callback, [=] { ityr::ori::acquire(rh); }, [] { ityr::ori::release(); },
+          ityr::ito::with_workhint, task_work(i), double(n_tasks - i - 1),
+          [=] { results[i].put(fib_serial(input)); });
+      all_serialized &= ths[i].serialized();
+    }
+
+    for (std::size_t i = 0; i < n_tasks; i++) {
+      if (!ths[i].serialized()) {
+        ityr::ori::release();
+      }
+      ths[i].join();
+    }
+
+    ityr::ito::task_group_end(tgdata,
+                              [] { ityr::ori::release(); },
+                              [] { ityr::ori::acquire(); });
+
+    if (!all_serialized) {
+      ityr::ori::acquire();
+    }
+  });
+}
+
+template <typename SpawnFn>
+void run_spawn(const char* name, ityr::global_span<result_t> results, SpawnFn spawn_fn) {
+  for (int r = 0; r < n_repeats; r++) {
+    ityr::root_exec([=] {
+      ityr::fill(ityr::execution::par, results.begin(), results.end(), result_t(0));
+    });
+
+    ityr::profiler_begin();
+
+    auto t0 = ityr::gettime_ns();
+
+    spawn_fn(results);
+
+    auto t1 = ityr::gettime_ns();
+
+    ityr::profiler_end();
+
+    if (ityr::is_master()) {
+      printf("[%s][%d] %'14ld ns - %'10ld ns/task", name, r, t1 - t0, (t1 - t0) / n_tasks);
+      fflush(stdout);
+    }
+
+    ityr::profiler_flush();
+
+    if (verify_result) {
+      result_t sum = ityr::root_exec([=] {
+        return ityr::reduce(ityr::execution::par, results.begin(), results.end());
+      });
+      if (ityr::is_master()) {
+        result_t answer = 0;
+        for (std::size_t i = 0; i < n_tasks; i++) {
+          answer += fib_serial(task_input(i));
+        }
+        printf(" - %s", sum == answer ? "Result verified" : "Wrong result");
+      }
+    }
+
+    if (ityr::is_master()) {
+      printf("\n");
+      fflush(stdout);
+    }
+  }
+}
+
+void run() {
+  ityr::global_vector_options gvec_coll_opts {
+    .collective         = true,
+    .parallel_construct = true,
+    .parallel_destruct  = true,
+  };
+
+  ityr::global_vector<result_t> results_vec(gvec_coll_opts, n_tasks);
+  ityr::global_span<result_t> results(results_vec.begin(), results_vec.end());
+
+  run_spawn("task_group", results, run_task_group);
+
+  if (n_tasks <= max_thread_array_tasks) {
+    run_spawn("thread_array", results, run_thread_array);
+  } else if (ityr::is_master()) {
+    printf("[thread_array] skipped (more than %ld tasks)\n", max_thread_array_tasks);
+  }
+}
+
+void show_help_and_exit(int argc [[maybe_unused]], char** argv) {
+  if (ityr::is_master()) {
+    printf("Usage: %s [options]\n"
+           "  options:\n"
+           "    -n : Number of tasks (size_t)\n"
+           "    -k : Input size of fib for each task (int)\n"
+           "    -i : irregular task sizes (int)\n"
+           "    -r : # of repeats (int)\n"
+           "    -v : verify the result (int)\n", argv[0]);
+  }
+  exit(1);
+}
+
+int main(int argc, char** argv) {
+  ityr::init();
+
+  int opt;
+  while ((opt = getopt(argc, argv, "n:k:i:r:v:h")) != EOF) {
+    switch (opt) {
+      case 'n':
+        n_tasks = atoll(optarg);
+        break;
+      case 'k':
+        n_input = atoi(optarg);
+        break;
+      case 'i':
+        irregular = atoi(optarg);
+        break;
+      case 'r':
+        n_repeats = atoi(optarg);
+        break;
+      case 'v':
+        verify_result = atoi(optarg);
+        break;
+      case 'h':
+      default:
+        show_help_and_exit(argc, argv);
+    }
+  }
+
+  if (n_tasks == 0) {
+    show_help_and_exit(argc, argv);
+  }
+
+  if (ityr::is_master()) {
+    setlocale(LC_NUMERIC, "en_US.UTF-8");
+    printf("=============================================================\n"
+           "[Task group]\n"
+           "# of processes:               %d\n"
+           "# of tasks:                   %ld\n"
+           "Input size of fib:            %d\n"
+           "Irregular:                    %d\n"
+           "# of repeats:                 %d\n"
+           "Verify result:                %d\n"
+           "-------------------------------------------------------------\n",
+           ityr::n_ranks(), n_tasks, n_input, irregular, n_repeats, verify_result);
+
+    printf("[Compile Options]\n");
+    ityr::print_compile_options();
+    printf("-------------------------------------------------------------\n");
+    printf("[Runtime Options]\n");
+    ityr::print_runtime_options();
+    printf("=============================================================\n\n");
+    fflush(stdout);
+  }
+
+  run();
+
+  ityr::fini();
+  return 0;
+}
@@ -55,7 +55,7 @@ public:
     void* ret = reinterpret_cast<void*>(*s);
 
     if constexpr (use_dynamic_win) {
-      MPI_Win_attach(win_, ret, real_bytes);
+      mpi_win_attach(ret, real_bytes, win_);
     }
 
     return ret;
@@ -70,7 +70,7 @@ public:
     std::size_t real_bytes = round_up_pow2(bytes, get_page_size());
 
     if constexpr (use_dynamic_win) {
-      MPI_Win_detach(win_, p);
+      mpi_win_detach(p, win_);
 
       if (madvise(p, real_bytes, MADV_REMOVE) == -1) {
         perror("madvise");
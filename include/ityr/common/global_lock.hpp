@@ -4,6 +4,7 @@
 #include <atomic>
 
 #include "ityr/common/util.hpp"
+#include "ityr/common/options.hpp"
 #include "ityr/common/mpi_util.hpp"
 #include "ityr/common/mpi_rma.hpp"
 #include "ityr/common/topology.hpp"
@@ -12,9 +13,10 @@
 
 namespace ityr::common {
 
-class global_lock {
+// Spinlock with remote CAS; waiters repeatedly issue RMA atomics to the target process
+class global_lock_spin {
 public:
-  global_lock(int n_locks = 1)
+  global_lock_spin(int n_locks = 1)
     : n_locks_(n_locks),
       lock_win_(topology::mpicomm(), n_locks_, 0) {}
 
@@ -23,6 +25,7 @@ public:
 
     ITYR_CHECK(idx < n_locks_);
 
+    n_rma_ops_++;
     lock_t result = mpi_atomic_cas_value<lock_t>(1, 0, target_rank, get_disp(idx), lock_win_.win());
 
     ITYR_CHECK(0 <= result);
@@ -41,13 +44,16 @@ public:
 
     ITYR_CHECK(idx < n_locks_);
 
+    n_rma_ops_++;
     lock_t result = mpi_atomic_faa_value<lock_t>(1, target_rank, get_disp(idx), lock_win_.win());
     if (result == 0) {
       return;
     }
 
     // Wait until the previous lock holder releases the lock
-    while (mpi_atomic_get_value<lock_t>(target_rank, get_disp(idx), lock_win_.win()) != 1);
+    do {
+      n_rma_ops_++;
+    } while (mpi_atomic_get_value<lock_t>(target_rank, get_disp(idx), lock_win_.win()) != 1);
   }
 
   void unlock(topology::rank_t target_rank, int idx = 0) const {
@@ -55,6 +61,7 @@ public:
 
     ITYR_CHECK(idx < n_locks_);
 
+    n_rma_ops_++;
     mpi_atomic_faa_value<lock_t>(-1, target_rank, get_disp(idx), lock_win_.win());
   }
 
@@ -65,6 +72,9 @@ public:
     return result > 0;
   }
 
+  // Number of RMA operations issued by this process so far (for benchmarking)
+  std::size_t n_rma_ops() const { return n_rma_ops_; }
+
 private:
   using lock_t = int;
 
@@ -80,8 +90,154 @@ private:
 
   int                           n_locks_;
   mpi_win_manager<lock_wrapper> lock_win_;
+  mutable std::size_t           n_rma_ops_ = 0;
 };
 
+// MCS lock (J. M. Mellor-Crummey and M. L. Scott, ACM TOCS, 1991) over MPI RMA.
+// Each lock has a tail pointer in the target process, and waiters are linked into a queue in FIFO
+// order. Each waiter spins on a flag in its own window, so waiting does not generate any network
+// traffic; the lock holder directly hands over the lock to the successor on unlock.
+//
+// Each process has two queue nodes for each lock index: one for the lock on its own rank and the
+// other for locks on other ranks. Thus, a process can hold its local lock and a remote lock with
+// the same index at the same time, but not two remote locks with the same index.
+class global_lock_mcs {
+public:
+  global_lock_mcs(int n_locks = 1)
+    : n_locks_(n_locks),
+      tail_win_(topology::mpicomm(), n_locks_, none),
+      node_win_(topology::mpicomm(), n_locks_ * 2) {}
+
+  bool trylock(topology::rank_t target_rank, int idx = 0) const {
+    ITYR_PROFILER_RECORD(prof_event_global_lock_trylock, target_rank);
+
+    ITYR_CHECK(idx < n_locks_);
+
+    queue_node& qn = local_node(target_rank, idx);
+    qn.next.store(none, std::memory_order_relaxed);
+    qn.locked.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    auto me = topology::my_rank();
+
+    n_rma_ops_++;
+    rank_t prev = mpi_atomic_cas_value<rank_t>(me, none, target_rank, get_tail_disp(idx), tail_win_.win());
+    return prev == none;
+  }
+
+  void lock(topology::rank_t target_rank, int idx = 0) const {
+    ITYR_CHECK(idx < n_locks_);
+
+    queue_node& qn = local_node(target_rank, idx);
+    qn.next.store(none, std::memory_order_relaxed);
+    qn.locked.store(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    auto me = topology::my_rank();
+
+    // Append this process to the tail of the queue
+    n_rma_ops_++;
+    rank_t prev = mpi_atomic_put_value<rank_t>(me, target_rank, get_tail_disp(idx), tail_win_.win());
+    if (prev == none) {
+      return;
+    }
+
+    ITYR_CHECK(prev != me);
+
+    // Link this process to the predecessor
+    n_rma_ops_++;
+    mpi_atomic_put_value<rank_t>(me, prev, get_node_disp(target_rank, prev, idx) + offsetof(queue_node, next),
+                                 node_win_.win());
+
+    // Wait until the predecessor hands over the lock
+    while (qn.locked.load(std::memory_order_acquire)) {
+      mpi_win_sync(node_win_.win());
+    }
+  }
+
+  void priolock(topology::rank_t target_rank, int idx = 0) const {
+    // As waiters are served in FIFO order, the lock owner waits at most for the lock holder and
+    // the processes already waiting in the queue; later trylock() calls fail while it is waiting.
+    ITYR_PROFILER_RECORD(prof_event_global_lock_priolock, target_rank);
+    lock(target_rank, idx);
+  }
+
+  void unlock(topology::rank_t target_rank, int idx = 0) const {
+    ITYR_PROFILER_RECORD(prof_event_global_lock_unlock, target_rank);
+
+    ITYR_CHECK(idx < n_locks_);
+
+    queue_node& qn = local_node(target_rank, idx);
+    auto me = topology::my_rank();
+
+    rank_t next = qn.next.load(std::memory_order_acquire);
+    if (next == none) {
+      // No successor is visible; release the lock if this process is still the tail
+      n_rma_ops_++;
+      rank_t tail = mpi_atomic_cas_value<rank_t>(none, me, target_rank, get_tail_disp(idx), tail_win_.win());
+      if (tail == me) {
+        return;
+      }
+
+      // A successor has swapped the tail but has not linked itself yet
+      while ((next = qn.next.load(std::memory_order_acquire)) == none) {
+        mpi_win_sync(node_win_.win());
+      }
+    }
+
+    // Hand over the lock to the successor
+    n_rma_ops_++;
+    mpi_atomic_put_value<rank_t>(0, next, get_node_disp(target_rank, next, idx) + offsetof(queue_node, locked),
+                                 node_win_.win());
+  }
+
+  bool is_locked(topology::rank_t target_rank, int idx = 0) const {
+    ITYR_CHECK(idx < n_locks_);
+
+    rank_t tail = mpi_atomic_get_value<rank_t>(target_rank, get_tail_disp(idx), tail_win_.win());
+    return tail != none;
+  }
+
+  // Number of RMA operations issued by this process so far (for benchmarking)
+  std::size_t n_rma_ops() const { return n_rma_ops_; }
+
+private:
+  using rank_t = int;
+
+  static constexpr rank_t none = -1;
+
+  struct alignas(common::hardware_destructive_interference_size) tail_wrapper {
+    template <typename... Args>
+    tail_wrapper(Args&&... args) : value(std::forward<Args>(args)...) {}
+    std::atomic<rank_t> value;
+  };
+
+  struct alignas(common::hardware_destructive_interference_size) queue_node {
+    std::atomic<rank_t> locked = 0;
+    std::atomic<rank_t> next   = none;
+  };
+
+  std::size_t get_tail_disp(int idx) const {
+    return idx * sizeof(tail_wrapper) + offsetof(tail_wrapper, value);
+  }
+
+  // Displacement of the queue node of `waiter_rank` for the lock of `target_rank`
+  std::size_t get_node_disp(topology::rank_t target_rank, topology::rank_t waiter_rank, int idx) const {
+    return (idx * 2 + (waiter_rank == target_rank ? 0 : 1)) * sizeof(queue_node);
+  }
+
+  queue_node& local_node(topology::rank_t target_rank, int idx) const {
+    return node_win_.local_buf()[get_node_disp(target_rank, topology::my_rank(), idx) / sizeof(queue_node)];
+  }
+
+  int                           n_locks_;
+  mpi_win_manager<tail_wrapper> tail_win_;
+  mpi_win_manager<queue_node>   node_win_;
+  mutable std::size_t           n_rma_ops_ = 0;
+};
+
+using global_lock = ITYR_CONCAT(global_lock_, ITYR_GLOBAL_LOCK_IMPL);
+
 ITYR_TEST_CASE("[ityr::common::global_lock] lock and unlock") {
   runtime_options opts;
   singleton_initializer<topology::instance> topo;
@@ -152,4 +308,56 @@ ITYR_TEST_CASE("[ityr::common::global_lock] lock and unlock") {
   }
 }
 
+ITYR_TEST_CASE("[ityr::common::global_lock_mcs] lock, trylock, and priolock") {
+  runtime_options opts;
+  singleton_initializer<topology::instance> topo;
+
+  int n_elems = 2;
+  global_lock_mcs lock(n_elems);
+
+  using value_t = std::size_t;
+  mpi_win_manager<value_t> value_win(topology::mpicomm(), n_elems);
+
+  auto my_rank = topology::my_rank();
+  auto n_ranks = topology::n_ranks();
+
+  std::size_t n_updates = 1000;
+  std::size_t n_success = 0;
+
+  for (topology::rank_t target_rank = 0; target_rank < n_ranks; target_rank++) {
+    for (std::size_t i = 0; i < n_updates; i++) {
+      int idx = i % n_elems;
+      if (i % 3 == 0) {
+        if (!lock.trylock(target_rank, idx)) continue;
+      } else if (target_rank == my_rank) {
+        lock.priolock(target_rank, idx);
+      } else {
+        lock.lock(target_rank, idx);
+      }
+
+      ITYR_CHECK(lock.is_locked(target_rank, idx));
+
+      auto v = common::mpi_get_value<value_t>(target_rank, idx * sizeof(value_t), value_win.win());
+      common::mpi_put_value<value_t>(v + 1, target_rank, idx * sizeof(value_t), value_win.win());
+
+      lock.unlock(target_rank, idx);
+      n_success++;
+    }
+
+    mpi_barrier(topology::mpicomm());
+  }
+
+  for (int i = 0; i < n_elems; i++) {
+    ITYR_CHECK(!lock.is_locked(my_rank, i));
+  }
+
+  value_t sum = 0;
+  for (int i = 0; i < n_elems; i++) {
+    sum += value_win.local_buf()[i];
+  }
+
+  ITYR_CHECK(mpi_allreduce_value(sum, topology::mpicomm()) ==
+             mpi_allreduce_value(n_success, topology::mpicomm()));
+}
+
 }
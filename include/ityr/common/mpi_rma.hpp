@@ -8,17 +8,37 @@
 #include "ityr/common/options.hpp"
 #include "ityr/common/profiler.hpp"
 #include "ityr/common/prof_events.hpp"
+#include "ityr/common/netemu.hpp"
 
 namespace ityr::common {
 
 inline void mpi_win_flush(int target_rank, MPI_Win win) {
   ITYR_PROFILER_RECORD(prof_event_mpi_rma_flush);
   MPI_Win_flush(target_rank, win);
+  netemu::on_flush();
 }
 
 inline void mpi_win_flush_all(MPI_Win win) {
   ITYR_PROFILER_RECORD(prof_event_mpi_rma_flush);
   MPI_Win_flush_all(win);
+  netemu::on_flush();
+}
+
+// Synchronize the public and private copies of the local window memory, e.g., while spinning on
+// a local variable updated by remote processes with RMA
+inline void mpi_win_sync(MPI_Win win) {
+  MPI_Win_sync(win);
+}
+
+// For dynamic windows; regions must be detached before the window is freed
+inline void mpi_win_attach(void* addr, std::size_t size, MPI_Win win) {
+  ITYR_CHECK(win != MPI_WIN_NULL);
+  MPI_Win_attach(win, addr, size);
+}
+
+inline void mpi_win_detach(const void* addr, MPI_Win win) {
+  ITYR_CHECK(win != MPI_WIN_NULL);
+  MPI_Win_detach(win, addr);
 }
 
 template <typename T>
@@ -29,6 +49,7 @@ inline void mpi_get_nb(T*          origin,
                        MPI_Win     win) {
   ITYR_PROFILER_RECORD(prof_event_mpi_rma_get, target_rank);
   ITYR_CHECK(win != MPI_WIN_NULL);
+  netemu::on_issue(target_rank, sizeof(T) * count);
   MPI_Get(origin,
           sizeof(T) * count,
           MPI_BYTE,
@@ -56,6 +77,7 @@ inline MPI_Request mpi_rget(T*          origin,
                             std::size_t target_disp,
                             MPI_Win     win) {
   ITYR_CHECK(win != MPI_WIN_NULL);
+  netemu::on_issue(target_rank, sizeof(T) * count);
   MPI_Request req;
   MPI_Rget(origin,
            sizeof(T) * count,
@@ -86,6 +108,7 @@ inline void mpi_put_nb(const T*    origin,
                        MPI_Win     win) {
   ITYR_PROFILER_RECORD(prof_event_mpi_rma_put, target_rank);
   ITYR_CHECK(win != MPI_WIN_NULL);
+  netemu::on_issue(target_rank, sizeof(T) * count);
   MPI_Put(origin,
           sizeof(T) * count,
           MPI_BYTE,
@@ -113,6 +136,7 @@ inline MPI_Request mpi_rput(const T*    origin,
                             std::size_t target_disp,
                             MPI_Win     win) {
   ITYR_CHECK(win != MPI_WIN_NULL);
+  netemu::on_issue(target_rank, sizeof(T) * count);
   MPI_Request req;
   MPI_Rput(origin,
            sizeof(T) * count,
@@ -142,6 +166,7 @@ inline void mpi_atomic_faa_nb(const T*    origin,
                               MPI_Win     win) {
   ITYR_PROFILER_RECORD(prof_event_mpi_rma_atomic_faa, target_rank);
   ITYR_CHECK(win != MPI_WIN_NULL);
+  netemu::on_issue(target_rank, sizeof(T));
   MPI_Fetch_and_op(origin,
                    result,
                    mpi_type<T>(),
@@ -171,6 +196,7 @@ inline void mpi_atomic_cas_nb(const T*    origin,
                               MPI_Win     win) {
   ITYR_PROFILER_RECORD(prof_event_mpi_rma_atomic_cas, target_rank);
   ITYR_CHECK(win != MPI_WIN_NULL);
+  netemu::on_issue(target_rank, sizeof(T));
   MPI_Compare_and_swap(origin,
                        compare,
                        result,
@@ -199,6 +225,7 @@ inline void mpi_atomic_get_nb(T*          origin,
                               MPI_Win     win) {
   ITYR_PROFILER_RECORD(prof_event_mpi_rma_atomic_get, target_rank);
   ITYR_CHECK(win != MPI_WIN_NULL);
+  netemu::on_issue(target_rank, sizeof(T));
   MPI_Fetch_and_op(nullptr,
                    origin,
                    mpi_type<T>(),
@@ -226,6 +253,7 @@ inline void mpi_atomic_put_nb(const T*    origin,
                               MPI_Win     win) {
   ITYR_PROFILER_RECORD(prof_event_mpi_rma_atomic_put, target_rank);
   ITYR_CHECK(win != MPI_WIN_NULL);
+  netemu::on_issue(target_rank, sizeof(T));
   MPI_Fetch_and_op(origin,
                    result,
                    mpi_type<T>(),
@@ -256,7 +284,8 @@ public:
   mpi_win_manager(MPI_Comm comm) {
     MPI_Win_create_dynamic(MPI_INFO_NULL, comm, &win_);
     MPI_Win_lock_all(MPI_MODE_NOCHECK, win_);
-    wireup(comm);
+    // Wireup is deferred to the first static window, as no memory is attached to dynamic
+    // windows yet and displacement 0 is not a valid address for them
   }
   mpi_win_manager(MPI_Comm comm, std::size_t size, std::size_t alignment = alignof(max_align_t)) {
     if (rma_use_mpi_win_allocate::value()) {
@@ -13,6 +13,7 @@ template <>           inline MPI_Datatype mpi_type<long>()          { return MPI
 template <>           inline MPI_Datatype mpi_type<unsigned long>() { return MPI_UNSIGNED_LONG;     }
 template <>           inline MPI_Datatype mpi_type<bool>()          { return MPI_CXX_BOOL;          }
 template <>           inline MPI_Datatype mpi_type<void*>()         { return mpi_type<uintptr_t>(); }
+template <>           inline MPI_Datatype mpi_type<std::byte>()     { return MPI_BYTE;              }
 
 inline int mpi_comm_rank(MPI_Comm comm) {
   int rank;
@@ -213,6 +214,66 @@ inline T mpi_scatter_value(const T* sendbuf,
   return result;
 }
 
+template <typename T>
+inline T mpi_exscan_value(const T& value,
+                          MPI_Comm comm,
+                          MPI_Op   op = MPI_SUM) {
+  T result {};
+  MPI_Exscan(&value, &result, 1, mpi_type<T>(), op, comm);
+  // The result on rank 0 is undefined in MPI
+  if (mpi_comm_rank(comm) == 0) {
+    result = T{};
+  }
+  return result;
+}
+
+template <typename T>
+inline void mpi_allgather(const T*    sendbuf,
+                          T*          recvbuf,
+                          std::size_t count,
+                          MPI_Comm    comm) {
+  MPI_Allgather(sendbuf,
+                count,
+                mpi_type<T>(),
+                recvbuf,
+                count,
+                mpi_type<T>(),
+                comm);
+}
+
+template <typename T>
+inline void mpi_alltoall(const T*    sendbuf,
+                         T*          recvbuf,
+                         std::size_t count,
+                         MPI_Comm    comm) {
+  MPI_Alltoall(sendbuf,
+               count,
+               mpi_type<T>(),
+               recvbuf,
+               count,
+               mpi_type<T>(),
+               comm);
+}
+
+template <typename T>
+inline void mpi_alltoallv(const T*   sendbuf,
+                          const int* sendcounts,
+                          const int* sdispls,
+                          T*         recvbuf,
+                          const int* recvcounts,
+                          const int* rdispls,
+                          MPI_Comm   comm) {
+  MPI_Alltoallv(sendbuf,
+                sendcounts,
+                sdispls,
+                mpi_type<T>(),
+                recvbuf,
+                recvcounts,
+                rdispls,
+                mpi_type<T>(),
+                comm);
+}
+
 inline void mpi_wait(MPI_Request& req) {
   MPI_Wait(&req, MPI_STATUS_IGNORE);
 }
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <algorithm>
+
+#include "ityr/common/util.hpp"
+#include "ityr/common/options.hpp"
+#include "ityr/common/topology.hpp"
+#include "ityr/common/logger.hpp"
+
+namespace ityr::common::netemu {
+
+// Emulation of inter-node network latency and bandwidth for RMA operations.
+// Each RMA operation to a process on another (possibly fake) node is assumed to be completed
+// after the data transfer (serialized on the link of the local process) plus the latency.
+// Flushes wait for the completion of all RMA operations issued so far.
+class network_emulator {
+public:
+  network_emulator()
+    : latency_ns_(netemu_latency_option::value()),
+      bandwidth_mbps_(netemu_bandwidth_option::value()),
+      ranks_per_node_(netemu_ranks_per_node_option::value()),
+      enabled_(latency_ns_ > 0 || bandwidth_mbps_ > 0) {}
+
+  ~network_emulator() {
+    if (enabled_) {
+      verbose("Network emulation: %ld RMA operations delayed by %ld ns in total",
+              n_delayed_ops_, total_delay_ns_);
+    }
+  }
+
+  bool enabled() const { return enabled_; }
+
+  bool is_remote(int target_rank) const {
+    if (ranks_per_node_ > 0) {
+      return static_cast<std::size_t>(target_rank) / ranks_per_node_ !=
+             static_cast<std::size_t>(topology::my_rank()) / ranks_per_node_;
+    } else {
+      return !topology::is_locally_accessible(target_rank);
+    }
+  }
+
+  void on_issue(int target_rank, std::size_t bytes) {
+    if (!enabled_ || !is_remote(target_rank)) return;
+
+    uint64_t t = clock_gettime_ns();
+    uint64_t transfer_begin = std::max(t, link_free_time_);
+    link_free_time_ = transfer_begin + transfer_time_ns(bytes);
+    complete_time_ = std::max(complete_time_, link_free_time_ + latency_ns_);
+
+    n_delayed_ops_++;
+  }
+
+  void on_flush() {
+    if (!enabled_ || complete_time_ == 0) return;
+
+    uint64_t t0 = clock_gettime_ns();
+    uint64_t t = t0;
+    while (t < complete_time_) {
+      t = clock_gettime_ns();
+    }
+    total_delay_ns_ += t - t0;
+
+    complete_time_ = 0;
+  }
+
+private:
+  uint64_t transfer_time_ns(std::size_t bytes) const {
+    // 1 MB/s = 1 byte/us
+    return bandwidth_mbps_ > 0 ? bytes * 1000 / bandwidth_mbps_ : 0;
+  }
+
+  uint64_t    latency_ns_;
+  std::size_t bandwidth_mbps_;
+  std::size_t ranks_per_node_;
+  bool        enabled_;
+  uint64_t    link_free_time_ = 0;
+  uint64_t    complete_time_  = 0;
+  std::size_t n_delayed_ops_  = 0;
+  uint64_t    total_delay_ns_ = 0;
+};
+
+using instance = singleton<network_emulator>;
+
+// Called when an RMA operation to `target_rank` is issued
+inline void on_issue(int target_rank, std::size_t bytes) {
+  if (instance::initialized()) {
+    instance::get().on_issue(target_rank, bytes);
+  }
+}
+
+// Called when issued RMA operations are completed
+inline void on_flush() {
+  if (instance::initialized()) {
+    instance::get().on_flush();
+  }
+}
+
+}
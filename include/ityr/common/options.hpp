@@ -11,6 +11,15 @@
 #define ITYR_STR(x) ITYR_STR_EXPAND(x)
 #define ITYR_PRINT_MACRO(x) printf(#x "=" ITYR_STR_EXPAND(x) "\n")
 
+// Identifiers in preprocessor conditionals are evaluated as 0 if they are not defined as macros,
+// so the RMA implementations are compared by their IDs (e.g., `ITYR_RMA_IMPL_ID(ITYR_RMA_IMPL) ==
+// ITYR_RMA_IMPL_ID_utofu`), not by their names (`ITYR_RMA_IMPL == utofu` is always true).
+#define ITYR_RMA_IMPL_ID_default 1
+#define ITYR_RMA_IMPL_ID_mpi     2
+#define ITYR_RMA_IMPL_ID_utofu   3
+#define ITYR_RMA_IMPL_ID_shm     4
+#define ITYR_RMA_IMPL_ID(impl)   ITYR_CONCAT(ITYR_RMA_IMPL_ID_, impl)
+
 namespace ityr::common {
 
 inline void print_compile_options() {
@@ -24,15 +33,23 @@ inline void print_compile_options() {
 #endif
   ITYR_PRINT_MACRO(ITYR_PROFILER_MODE);
 
-#if !defined(ITYR_RMA_IMPL) || ITYR_RMA_IMPL == default
+#if !defined(ITYR_RMA_IMPL) || ITYR_RMA_IMPL_ID(ITYR_RMA_IMPL) == ITYR_RMA_IMPL_ID_default
+#undef ITYR_RMA_IMPL
 #if __has_include(<utofu.h>)
 #define ITYR_RMA_IMPL utofu
 #else
 #define ITYR_RMA_IMPL mpi
 #endif
+#elif ITYR_RMA_IMPL_ID(ITYR_RMA_IMPL) == 0
+#error "Unknown ITYR_RMA_IMPL (must be one of default, mpi, utofu, and shm)"
 #endif
   ITYR_PRINT_MACRO(ITYR_RMA_IMPL);
 
+#ifndef ITYR_GLOBAL_LOCK_IMPL
+#define ITYR_GLOBAL_LOCK_IMPL spin
+#endif
+  ITYR_PRINT_MACRO(ITYR_GLOBAL_LOCK_IMPL);
+
 #ifndef ITYR_ALLOCATOR_USE_BOOST
 #define ITYR_ALLOCATOR_USE_BOOST 0
 #endif
@@ -126,6 +143,18 @@ struct global_clock_sync_round_trips_option : public option<global_clock_sync_ro
   static std::size_t default_value() { return 100; }
 };
 
+struct global_clock_sync_tree_option : public option<global_clock_sync_tree_option, bool> {
+  using option::option;
+  static std::string name() { return "ITYR_GLOBAL_CLOCK_SYNC_TREE"; }
+  static bool default_value() { return true; }
+};
+
+struct global_clock_drift_compensation_option : public option<global_clock_drift_compensation_option, bool> {
+  using option::option;
+  static std::string name() { return "ITYR_GLOBAL_CLOCK_DRIFT_COMPENSATION"; }
+  static bool default_value() { return false; }
+};
+
 struct prof_output_per_rank_option : public option<prof_output_per_rank_option, bool> {
   using option::option;
   static std::string name() { return "ITYR_PROF_OUTPUT_PER_RANK"; }
@@ -150,13 +179,36 @@ struct allocator_max_unflushed_free_objs_option : public option<allocator_max_un
   static std::size_t default_value() { return 10; }
 };
 
+struct netemu_latency_option : public option<netemu_latency_option, std::size_t> {
+  using option::option;
+  static std::string name() { return "ITYR_NETEMU_LATENCY"; }
+  static std::size_t default_value() { return 0; } // in ns
+};
+
+struct netemu_bandwidth_option : public option<netemu_bandwidth_option, std::size_t> {
+  using option::option;
+  static std::string name() { return "ITYR_NETEMU_BANDWIDTH"; }
+  static std::size_t default_value() { return 0; } // in MB/s (0 = unlimited)
+};
+
+struct netemu_ranks_per_node_option : public option<netemu_ranks_per_node_option, std::size_t> {
+  using option::option;
+  static std::string name() { return "ITYR_NETEMU_RANKS_PER_NODE"; }
+  static std::size_t default_value() { return 0; } // 0 = physical node boundaries
+};
+
 struct runtime_options {
   option_initializer<enable_shared_memory_option>              ITYR_ANON_VAR;
   option_initializer<global_clock_sync_round_trips_option>     ITYR_ANON_VAR;
+  option_initializer<global_clock_sync_tree_option>            ITYR_ANON_VAR;
+  option_initializer<global_clock_drift_compensation_option>   ITYR_ANON_VAR;
   option_initializer<prof_output_per_rank_option>              ITYR_ANON_VAR;
   option_initializer<rma_use_mpi_win_allocate>                 ITYR_ANON_VAR;
   option_initializer<allocator_block_size_option>              ITYR_ANON_VAR;
   option_initializer<allocator_max_unflushed_free_objs_option> ITYR_ANON_VAR;
+  option_initializer<netemu_latency_option>                    ITYR_ANON_VAR;
+  option_initializer<netemu_bandwidth_option>                  ITYR_ANON_VAR;
+  option_initializer<netemu_ranks_per_node_option>             ITYR_ANON_VAR;
 };
 
 }
@@ -327,6 +327,8 @@ inline void switch_phase() {
 }
 
 inline void begin() {
+  // Update the clock drift rate so that timestamps are aligned across processes in long runs
+  wallclock::instance::get().resync();
   mpi_barrier(topology::mpicomm());
   instance::get().begin();
 }
@@ -1,11 +1,16 @@
 #pragma once
 
+#include <sstream>
+
 #include "ityr/common/util.hpp"
 #include "ityr/common/options.hpp"
 #include "ityr/common/profiler.hpp"
 #include "ityr/common/prof_events.hpp"
+#include "ityr/common/physical_mem.hpp"
+#include "ityr/common/virtual_mem.hpp"
 #include "ityr/common/rma/mpi.hpp"
 #include "ityr/common/rma/utofu.hpp"
+#include "ityr/common/rma/shm.hpp"
 
 namespace ityr::common::rma {
 
@@ -21,6 +26,23 @@ inline std::unique_ptr<win> create_win(T* baseptr, std::size_t count) {
   }
 }
 
+inline constexpr bool support_dynamic_win = ITYR_RMA_IMPL::support_dynamic_win;
+
+inline constexpr bool support_atomic = ITYR_RMA_IMPL::support_atomic;
+
+// For dynamic windows, the target displacement is the absolute address in the target process
+inline std::unique_ptr<win> create_win_dynamic() {
+  return std::make_unique<win>(instance::get().create_win_dynamic());
+}
+
+inline void attach(const win& w, void* addr, std::size_t bytes) {
+  instance::get().attach(w, addr, bytes);
+}
+
+inline void detach(const win& w, void* addr) {
+  instance::get().detach(w, addr);
+}
+
 template <typename T>
 inline void get_nb(const win&  origin_win,
                    T*          origin_addr,
@@ -73,9 +95,126 @@ inline void put_nb(const T*    origin_addr,
                          target_win, target_rank, target_disp);
 }
 
+// Atomic operations are completed by `flush()` as well as get/put operations
+template <typename T>
+inline void atomic_faa_nb(const T*    origin_addr,
+                          T*          result_addr,
+                          const win&  target_win,
+                          int         target_rank,
+                          std::size_t target_disp) {
+  instance::get().atomic_faa_nb(origin_addr, result_addr, target_win, target_rank, target_disp);
+}
+
+template <typename T>
+inline void atomic_cas_nb(const T*    origin_addr,
+                          const T*    compare_addr,
+                          T*          result_addr,
+                          const win&  target_win,
+                          int         target_rank,
+                          std::size_t target_disp) {
+  instance::get().atomic_cas_nb(origin_addr, compare_addr, result_addr, target_win, target_rank, target_disp);
+}
+
+template <typename T>
+inline void atomic_get_nb(T*          origin_addr,
+                          const win&  target_win,
+                          int         target_rank,
+                          std::size_t target_disp) {
+  instance::get().atomic_get_nb(origin_addr, target_win, target_rank, target_disp);
+}
+
+template <typename T>
+inline void atomic_put_nb(const T*    origin_addr,
+                          T*          result_addr,
+                          const win&  target_win,
+                          int         target_rank,
+                          std::size_t target_disp) {
+  instance::get().atomic_put_nb(origin_addr, result_addr, target_win, target_rank, target_disp);
+}
+
 inline void flush(const win& target_win) {
   ITYR_PROFILER_RECORD(prof_event_rma_flush);
   instance::get().flush(target_win);
 }
 
+ITYR_TEST_CASE("[ityr::common::rma] atomic operations") {
+  runtime_options opts;
+  singleton_initializer<topology::instance> topo;
+  singleton_initializer<instance> rma;
+
+  auto my_rank = topology::my_rank();
+  auto n_ranks = topology::n_ranks();
+
+  using value_t = uint64_t;
+
+  // Windows must be backed by POSIX shared memory for ITYR_RMA_IMPL=shm
+  std::stringstream ss;
+  ss << "/ityr_rma_test_" << my_rank;
+
+  std::size_t pagesize = get_page_size();
+  physical_mem pm(ss.str(), pagesize, true);
+  virtual_mem vm(pagesize);
+  pm.map_to_vm(vm.addr(), pagesize, 0);
+
+  value_t* values = reinterpret_cast<value_t*>(vm.addr());
+  values[0] = values[1] = 0;
+
+  auto w = create_win(values, 2);
+
+  mpi_barrier(topology::mpicomm());
+
+  int n_updates = 100;
+
+  for (topology::rank_t target_rank = 0; target_rank < n_ranks; target_rank++) {
+    for (int i = 0; i < n_updates; i++) {
+      // fetch-and-add to values[0]
+      value_t one = 1;
+      value_t prev;
+      atomic_faa_nb(&one, &prev, *w, target_rank, 0);
+      flush(*w);
+
+      // increment values[1] by compare-and-swap
+      value_t cur;
+      atomic_get_nb(&cur, *w, target_rank, sizeof(value_t));
+      flush(*w);
+      while (true) {
+        value_t next = cur + 1;
+        value_t ret;
+        atomic_cas_nb(&next, &cur, &ret, *w, target_rank, sizeof(value_t));
+        flush(*w);
+        if (ret == cur) break;
+        cur = ret;
+      }
+    }
+  }
+
+  mpi_barrier(topology::mpicomm());
+
+  value_t expected = n_ranks * n_updates;
+
+  value_t v0, v1;
+  atomic_get_nb(&v0, *w, my_rank, 0);
+  atomic_get_nb(&v1, *w, my_rank, sizeof(value_t));
+  flush(*w);
+  ITYR_CHECK(v0 == expected);
+  ITYR_CHECK(v1 == expected);
+
+  mpi_barrier(topology::mpicomm());
+
+  // swap values[0] of the next process with my rank
+  value_t new_val = my_rank;
+  value_t old_val;
+  atomic_put_nb(&new_val, &old_val, *w, (my_rank + 1) % n_ranks, 0);
+  flush(*w);
+  ITYR_CHECK(old_val == expected);
+
+  mpi_barrier(topology::mpicomm());
+
+  atomic_get_nb(&v0, *w, my_rank, 0);
+  flush(*w);
+  ITYR_CHECK(v0 == value_t((my_rank + n_ranks - 1) % n_ranks));
+
+  mpi_barrier(topology::mpicomm());
+}
+
 }
@@ -11,10 +11,30 @@ class mpi {
 public:
   using win = mpi_win_manager<void>;
 
+  // RMA can be issued from buffers not registered to any window
+  static constexpr bool support_unregistered_origin = true;
+
+  // Memory regions can be attached to windows later, and are addressed by their absolute addresses
+  static constexpr bool support_dynamic_win = true;
+
+  static constexpr bool support_atomic = true;
+
   win create_win(void* baseptr, std::size_t bytes) {
     return win(topology::mpicomm(), baseptr, bytes);
   }
 
+  win create_win_dynamic() {
+    return win(topology::mpicomm());
+  }
+
+  void attach(const win& w, void* addr, std::size_t bytes) {
+    mpi_win_attach(addr, bytes, w.win());
+  }
+
+  void detach(const win& w, void* addr) {
+    mpi_win_detach(addr, w.win());
+  }
+
   void get_nb(const win&,
               std::byte*  origin_addr,
               std::size_t bytes,
@@ -49,8 +69,44 @@ public:
     mpi_put_nb(origin_addr, bytes, target_rank, target_disp, target_win.win());
   }
 
+  template <typename T>
+  void atomic_faa_nb(const T*    origin_addr,
+                     T*          result_addr,
+                     const win&  target_win,
+                     int         target_rank,
+                     std::size_t target_disp) {
+    mpi_atomic_faa_nb(origin_addr, result_addr, target_rank, target_disp, target_win.win());
+  }
+
+  template <typename T>
+  void atomic_cas_nb(const T*    origin_addr,
+                     const T*    compare_addr,
+                     T*          result_addr,
+                     const win&  target_win,
+                     int         target_rank,
+                     std::size_t target_disp) {
+    mpi_atomic_cas_nb(origin_addr, compare_addr, result_addr, target_rank, target_disp, target_win.win());
+  }
+
+  template <typename T>
+  void atomic_get_nb(T*          origin_addr,
+                     const win&  target_win,
+                     int         target_rank,
+                     std::size_t target_disp) {
+    mpi_atomic_get_nb(origin_addr, target_rank, target_disp, target_win.win());
+  }
+
+  template <typename T>
+  void atomic_put_nb(const T*    origin_addr,
+                     T*          result_addr,
+                     const win&  target_win,
+                     int         target_rank,
+                     std::size_t target_disp) {
+    mpi_atomic_put_nb(origin_addr, result_addr, target_rank, target_disp, target_win.win());
+  }
+
   void flush(const win& win) {
-    MPI_Win_flush_all(win.win());
+    mpi_win_flush_all(win.win());
   }
 };
 
@@ -0,0 +1,335 @@
+#pragma once
+
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstring>
+#include <atomic>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <type_traits>
+
+#include "ityr/common/util.hpp"
+#include "ityr/common/topology.hpp"
+#include "ityr/common/mpi_util.hpp"
+#include "ityr/common/netemu.hpp"
+
+namespace ityr::common::rma {
+
+// RMA over POSIX shared memory for single-node executions.
+// RMA operations are performed by direct loads and stores to the memory of other processes,
+// which is mapped to the local address space when a window is created. To this end, memory
+// regions of windows must be backed by POSIX shared memory (e.g., `common::physical_mem`).
+class shm {
+public:
+  shm() {
+    MPI_Comm node_comm;
+    MPI_Comm_split_type(topology::mpicomm(), MPI_COMM_TYPE_SHARED, topology::my_rank(), MPI_INFO_NULL, &node_comm);
+    int node_n_ranks = mpi_comm_size(node_comm);
+    MPI_Comm_free(&node_comm);
+
+    ITYR_REQUIRE_MESSAGE(node_n_ranks == topology::n_ranks(),
+                         "ITYR_RMA_IMPL=shm requires all processes to run on a single node");
+  }
+
+  static constexpr bool support_unregistered_origin = true;
+
+  static constexpr bool support_dynamic_win = false;
+
+  static constexpr bool support_atomic = true;
+
+  class win {
+  public:
+    win(void* baseptr, std::size_t bytes)
+      : target_segs_(init_target_segs(reinterpret_cast<std::byte*>(baseptr), bytes)) {}
+
+    ~win() {
+      for (const auto& segs : target_segs_) {
+        for (const auto& seg : segs) {
+          if (seg.map_addr) {
+            munmap(seg.map_addr, seg.map_size);
+          }
+        }
+      }
+    }
+
+    win(const win&) = delete;
+    win& operator=(const win&) = delete;
+
+    win(win&& w) : target_segs_(std::move(w.target_segs_)) { w.target_segs_.clear(); }
+    win& operator=(win&& w) {
+      this->~win();
+      target_segs_ = std::move(w.target_segs_);
+      w.target_segs_.clear();
+      return *this;
+    }
+
+    // Call `fn(addr, offset, size)` for each contiguous piece of [target_disp, target_disp + bytes)
+    template <typename Fn>
+    void for_each_target_piece(int target_rank, std::size_t target_disp, std::size_t bytes, Fn fn) const {
+      ITYR_CHECK(0 <= target_rank);
+      ITYR_CHECK(target_rank < topology::n_ranks());
+
+      std::size_t disp   = target_disp;
+      std::size_t disp_e = target_disp + bytes;
+      for (const auto& seg : target_segs_[target_rank]) {
+        if (disp >= disp_e) break;
+        if (seg.disp_b <= disp && disp < seg.disp_e) {
+          std::size_t size = std::min(seg.disp_e, disp_e) - disp;
+          fn(seg.addr + (disp - seg.disp_b), disp - target_disp, size);
+          disp += size;
+        }
+      }
+      ITYR_CHECK_MESSAGE(disp >= disp_e, "RMA to rank %d out of the window (disp=%ld, bytes=%ld)",
+                         target_rank, target_disp, bytes);
+    }
+
+    // Address of an object of type T at target_disp, which can be accessed by atomic operations
+    template <typename T>
+    T* atomic_target_addr(int target_rank, std::size_t target_disp) const {
+      T* ret = nullptr;
+      for_each_target_piece(target_rank, target_disp, sizeof(T),
+          [&](std::byte* addr, std::size_t, std::size_t size) {
+        ITYR_CHECK_MESSAGE(size == sizeof(T), "Atomic operations cannot span multiple memory mappings");
+        ret = reinterpret_cast<T*>(addr);
+      });
+      ITYR_CHECK(reinterpret_cast<uintptr_t>(ret) % alignof(T) == 0);
+      return ret;
+    }
+
+  private:
+    static constexpr int max_segments = 16;
+
+    struct segment_info {
+      std::size_t disp_b;
+      std::size_t disp_e;
+      std::size_t file_offset;
+      char        path[128];
+    };
+
+    struct segment {
+      std::size_t disp_b;
+      std::size_t disp_e;
+      std::byte*  addr;
+      void*       map_addr; // null for the local window
+      std::size_t map_size;
+    };
+
+    // Find shared memory objects backing [baseptr, baseptr + bytes) from /proc/self/maps
+    static std::vector<segment_info> find_backing_segments(std::byte* baseptr, std::size_t bytes) {
+      std::vector<segment_info> seg_infos;
+
+      std::ifstream ifs("/proc/self/maps");
+      std::string line;
+      while (std::getline(ifs, line)) {
+        uintptr_t   vma_b, vma_e;
+        std::size_t offset;
+        char        perms[8];
+        char        dev[16];
+        unsigned long inode;
+        char        path[256] = {};
+        int n = std::sscanf(line.c_str(), "%lx-%lx %7s %lx %15s %lu %255[^\n]",
+                            &vma_b, &vma_e, perms, &offset, dev, &inode, path);
+        if (n < 6) continue;
+
+        std::byte* b = std::max(reinterpret_cast<std::byte*>(vma_b), baseptr);
+        std::byte* e = std::min(reinterpret_cast<std::byte*>(vma_e), baseptr + bytes);
+        if (b >= e) continue;
+
+        ITYR_REQUIRE_MESSAGE(std::strncmp(path, "/dev/shm/", 9) == 0 &&
+                             std::strlen(path) < sizeof(segment_info::path),
+                             "RMA windows for ITYR_RMA_IMPL=shm must be backed by POSIX shared memory "
+                             "([%p, %p) is mapped to '%s')", b, e, path);
+        ITYR_REQUIRE_MESSAGE(static_cast<int>(seg_infos.size()) < max_segments,
+                             "Too many memory mappings in an RMA window for ITYR_RMA_IMPL=shm");
+
+        segment_info& si = seg_infos.emplace_back();
+        si.disp_b      = b - baseptr;
+        si.disp_e      = e - baseptr;
+        si.file_offset = offset + (b - reinterpret_cast<std::byte*>(vma_b));
+        std::strcpy(si.path, path);
+      }
+
+      return seg_infos;
+    }
+
+    static std::vector<std::vector<segment>> init_target_segs(std::byte* baseptr, std::size_t bytes) {
+      std::vector<segment_info> my_seg_infos = find_backing_segments(baseptr, bytes);
+
+      std::size_t n_ranks = topology::n_ranks();
+      std::vector<segment_info> my_seg_infos_padded(max_segments);
+      for (std::size_t i = 0; i < my_seg_infos.size(); i++) {
+        my_seg_infos_padded[i] = my_seg_infos[i];
+      }
+      for (std::size_t i = my_seg_infos.size(); i < max_segments; i++) {
+        my_seg_infos_padded[i].disp_b = my_seg_infos_padded[i].disp_e = 0;
+      }
+
+      std::vector<segment_info> all_seg_infos(n_ranks * max_segments);
+      mpi_allgather(reinterpret_cast<const std::byte*>(my_seg_infos_padded.data()),
+                    reinterpret_cast<std::byte*>(all_seg_infos.data()),
+                    sizeof(segment_info) * max_segments,
+                    topology::mpicomm());
+
+      std::vector<std::vector<segment>> target_segs(n_ranks);
+
+      for (std::size_t r = 0; r < n_ranks; r++) {
+        for (int i = 0; i < max_segments; i++) {
+          const segment_info& si = all_seg_infos[r * max_segments + i];
+          if (si.disp_b == si.disp_e) continue;
+
+          if (r == static_cast<std::size_t>(topology::my_rank())) {
+            target_segs[r].push_back({si.disp_b, si.disp_e, baseptr + si.disp_b, nullptr, 0});
+            continue;
+          }
+
+          std::size_t pagesize     = get_page_size();
+          std::size_t offset_align = round_down_pow2(si.file_offset, pagesize);
+          std::size_t map_size     = round_up_pow2(si.file_offset + (si.disp_e - si.disp_b), pagesize) - offset_align;
+
+          int fd = open(si.path, O_RDWR);
+          if (fd == -1) {
+            perror("open");
+            die("[ityr::common::rma::shm] open(%s) failed", si.path);
+          }
+
+          void* map_addr = mmap(nullptr, map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, offset_align);
+          if (map_addr == MAP_FAILED) {
+            perror("mmap");
+            die("[ityr::common::rma::shm] mmap(%s, %lu) failed", si.path, map_size);
+          }
+          close(fd);
+
+          std::byte* addr = reinterpret_cast<std::byte*>(map_addr) + (si.file_offset - offset_align);
+          target_segs[r].push_back({si.disp_b, si.disp_e, addr, map_addr, map_size});
+        }
+      }
+
+      // Peers must not unlink the shared memory objects before they are opened
+      mpi_barrier(topology::mpicomm());
+
+      return target_segs;
+    }
+
+    std::vector<std::vector<segment>> target_segs_; // rank -> segments
+  };
+
+  win create_win(void* baseptr, std::size_t bytes) {
+    return win(baseptr, bytes);
+  }
+
+  win create_win_dynamic() {
+    common::die("Dynamic windows are not supported for ITYR_RMA_IMPL=shm");
+  }
+
+  void attach(const win&, void*, std::size_t) {
+    common::die("Dynamic windows are not supported for ITYR_RMA_IMPL=shm");
+  }
+
+  void detach(const win&, void*) {
+    common::die("Dynamic windows are not supported for ITYR_RMA_IMPL=shm");
+  }
+
+  void get_nb(const win&,
+              std::byte*  origin_addr,
+              std::size_t bytes,
+              const win&  target_win,
+              int         target_rank,
+              std::size_t target_disp) {
+    get_nb(origin_addr, bytes, target_win, target_rank, target_disp);
+  }
+
+  void get_nb(std::byte*  origin_addr,
+              std::size_t bytes,
+              const win&  target_win,
+              int         target_rank,
+              std::size_t target_disp) {
+    netemu::on_issue(target_rank, bytes);
+    target_win.for_each_target_piece(target_rank, target_disp, bytes,
+        [&](const std::byte* addr, std::size_t offset, std::size_t size) {
+      std::memcpy(origin_addr + offset, addr, size);
+    });
+  }
+
+  void put_nb(const win&,
+              const std::byte* origin_addr,
+              std::size_t      bytes,
+              const win&       target_win,
+              int              target_rank,
+              std::size_t      target_disp) {
+    put_nb(origin_addr, bytes, target_win, target_rank, target_disp);
+  }
+
+  void put_nb(const std::byte* origin_addr,
+              std::size_t      bytes,
+              const win&       target_win,
+              int              target_rank,
+              std::size_t      target_disp) {
+    netemu::on_issue(target_rank, bytes);
+    target_win.for_each_target_piece(target_rank, target_disp, bytes,
+        [&](std::byte* addr, std::size_t offset, std::size_t size) {
+      std::memcpy(addr, origin_addr + offset, size);
+    });
+  }
+
+  template <typename T>
+  void atomic_faa_nb(const T*    origin_addr,
+                     T*          result_addr,
+                     const win&  target_win,
+                     int         target_rank,
+                     std::size_t target_disp) {
+    static_assert(std::is_integral_v<T>);
+    netemu::on_issue(target_rank, sizeof(T));
+    T* p = target_win.atomic_target_addr<T>(target_rank, target_disp);
+    *result_addr = __atomic_fetch_add(p, *origin_addr, __ATOMIC_SEQ_CST);
+  }
+
+  template <typename T>
+  void atomic_cas_nb(const T*    origin_addr,
+                     const T*    compare_addr,
+                     T*          result_addr,
+                     const win&  target_win,
+                     int         target_rank,
+                     std::size_t target_disp) {
+    static_assert(std::is_integral_v<T>);
+    netemu::on_issue(target_rank, sizeof(T));
+    T* p = target_win.atomic_target_addr<T>(target_rank, target_disp);
+    // `expected` is overwritten with the current value on failure
+    T expected = *compare_addr;
+    __atomic_compare_exchange_n(p, &expected, *origin_addr, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+    *result_addr = expected;
+  }
+
+  template <typename T>
+  void atomic_get_nb(T*          origin_addr,
+                     const win&  target_win,
+                     int         target_rank,
+                     std::size_t target_disp) {
+    static_assert(std::is_integral_v<T>);
+    netemu::on_issue(target_rank, sizeof(T));
+    T* p = target_win.atomic_target_addr<T>(target_rank, target_disp);
+    *origin_addr = __atomic_load_n(p, __ATOMIC_SEQ_CST);
+  }
+
+  template <typename T>
+  void atomic_put_nb(const T*    origin_addr,
+                     T*          result_addr,
+                     const win&  target_win,
+                     int         target_rank,
+                     std::size_t target_disp) {
+    static_assert(std::is_integral_v<T>);
+    netemu::on_issue(target_rank, sizeof(T));
+    T* p = target_win.atomic_target_addr<T>(target_rank, target_disp);
+    *result_addr = __atomic_exchange_n(p, *origin_addr, __ATOMIC_SEQ_CST);
+  }
+
+  void flush(const win&) {
+    // Loads and stores are already completed; only their ordering with later accesses matters
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    netemu::on_flush();
+  }
+};
+
+}
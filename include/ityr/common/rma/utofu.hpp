@@ -3,8 +3,9 @@
 #include "ityr/common/util.hpp"
 #include "ityr/common/topology.hpp"
 #include "ityr/common/mpi_util.hpp"
+#include "ityr/common/options.hpp"
 
-#if ITYR_RMA_IMPL == utofu && __has_include(<utofu.h>)
+#if ITYR_RMA_IMPL_ID(ITYR_RMA_IMPL) == ITYR_RMA_IMPL_ID_utofu && __has_include(<utofu.h>)
 
 #include <utofu.h>
 
@@ -21,6 +22,13 @@ public:
     utofu_free_vcq(vcq_hdl_);
   }
 
+  // Origin buffers must be registered to a window
+  static constexpr bool support_unregistered_origin = false;
+
+  static constexpr bool support_dynamic_win = false;
+
+  static constexpr bool support_atomic = false;
+
   class win {
   public:
     win(utofu_vcq_hdl_t vcq_hdl, void* baseptr, std::size_t bytes)
@@ -88,6 +96,18 @@ public:
     return win(vcq_hdl_, baseptr, bytes);
   }
 
+  win create_win_dynamic() {
+    common::die("utofu rma layer does not support dynamic windows");
+  }
+
+  void attach(const win&, void*, std::size_t) {
+    common::die("utofu rma layer does not support dynamic windows");
+  }
+
+  void detach(const win&, void*) {
+    common::die("utofu rma layer does not support dynamic windows");
+  }
+
   void get_nb(const win&  origin_win,
               std::byte*  origin_addr,
               std::size_t bytes,
@@ -142,6 +162,26 @@ public:
     common::die("utofu rma layer is not supported for get/put (nocache) interface");
   }
 
+  template <typename T>
+  void atomic_faa_nb(const T*, T*, const win&, int, std::size_t) {
+    common::die("Atomic operations are not supported for ITYR_RMA_IMPL=utofu");
+  }
+
+  template <typename T>
+  void atomic_cas_nb(const T*, const T*, T*, const win&, int, std::size_t) {
+    common::die("Atomic operations are not supported for ITYR_RMA_IMPL=utofu");
+  }
+
+  template <typename T>
+  void atomic_get_nb(T*, const win&, int, std::size_t) {
+    common::die("Atomic operations are not supported for ITYR_RMA_IMPL=utofu");
+  }
+
+  template <typename T>
+  void atomic_put_nb(const T*, T*, const win&, int, std::size_t) {
+    common::die("Atomic operations are not supported for ITYR_RMA_IMPL=utofu");
+  }
+
   void flush(const win&) {
     // TODO: flush for each win
     for (int i = 0; i < n_ongoing_tcq_reqs_; i++) {
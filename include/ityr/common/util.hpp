@@ -52,11 +52,9 @@
 
 namespace ityr::common {
 
-#ifdef __cpp_lib_hardware_interference_size
-using std::hardware_destructive_interference_size;
-#else
+// A fixed value is used instead of std::hardware_destructive_interference_size, which depends on
+// compiler flags (-mtune) and is thus not suitable for data layouts shared across processes
 constexpr std::size_t hardware_destructive_interference_size = 64;
-#endif
 
 inline uint64_t clock_gettime_ns() {
   struct timespec ts;
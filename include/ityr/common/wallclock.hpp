@@ -15,72 +15,178 @@ using wallclock_t = uint64_t;
 class global_clock {
 public:
   global_clock()
-    : n_sync_round_trips_(global_clock_sync_round_trips_option::value()) {
+    : n_sync_round_trips_(global_clock_sync_round_trips_option::value()),
+      sync_tree_(global_clock_sync_tree_option::value()),
+      drift_compensation_(global_clock_drift_compensation_option::value()) {
     sync();
   }
 
+  // Collective. When drift compensation is enabled, the clock drift rate of each node is estimated
+  // from the offsets measured in the previous and the current synchronization.
   void sync() {
     wallclock_t t0 = clock_gettime_ns();
     mpi_barrier(topology::mpicomm());
-    do_sync();
+    uint64_t error = do_sync();
     mpi_barrier(topology::mpicomm());
     wallclock_t t1 = clock_gettime_ns();
-    verbose("Global clock synchronized (offset = %ld ns); took %ld ns", offset_, t1 - t0);
+
+    uint64_t max_error = mpi_reduce_value(error, 0, topology::mpicomm(), MPI_MAX);
+    if (topology::my_rank() == 0) {
+      verbose("Global clock synchronized (%s; estimated error <= %ld ns); took %ld ns",
+              sync_tree_ ? "tree" : "flat", max_error, t1 - t0);
+    }
+    verbose("Global clock offset = %ld ns, drift = %.3f ppm", offset_, drift_ * 1e6);
+  }
+
+  // Resynchronize the clocks to update the drift rate (collective)
+  void resync() {
+    if (drift_compensation_) {
+      sync();
+    }
   }
 
   wallclock_t gettime_ns() const {
-    return clock_gettime_ns() - offset_;
+    wallclock_t t = clock_gettime_ns();
+    return t - offset_ - static_cast<int64_t>(drift_ * static_cast<int64_t>(t - t_sync_));
   }
 
 private:
-  void do_sync() {
-    // Only the leader of each node involves in clock synchronization
-    if (topology::intra_my_rank() == 0) {
-      int64_t* offsets = new int64_t[topology::inter_n_ranks()]();
+  // The offset from the reference clock of the node of rank 0 and its estimated error
+  struct clock_offset {
+    int64_t  offset;
+    uint64_t error;
+  };
+
+  // Measure the offset from the clock of `target_rank` by round trips initiated by this process
+  clock_offset ping(int target_rank) const {
+    clock_offset ret {0, std::numeric_limits<uint64_t>::max()};
+    for (int j = 0; j < n_sync_round_trips_; j++) {
+      uint64_t t0 = clock_gettime_ns();
+      mpi_send_value(t0, target_rank, j, topology::inter_mpicomm());
+      uint64_t t1 = mpi_recv_value<uint64_t>(target_rank, j, topology::inter_mpicomm());
+      uint64_t t2 = clock_gettime_ns();
+
+      // adopt the fastest communitation
+      if ((t2 - t0) / 2 < ret.error) {
+        ret.error = (t2 - t0) / 2;
+        ret.offset = static_cast<int64_t>((t0 + t2) / 2) - t1;
+      }
+    }
+    return ret;
+  }
 
-      // uses the reference clock of the node of rank 0
-      if (topology::inter_my_rank() == 0) {
-        // takes O(n) time, where n = # of nodes
-        for (int i = 1; i < topology::inter_n_ranks(); i++) {
-          uint64_t min_gap = std::numeric_limits<uint64_t>::max();
-          for (int j = 0; j < n_sync_round_trips_; j++) {
-            uint64_t t0 = clock_gettime_ns();
-            mpi_send_value(t0, i, j, topology::inter_mpicomm());
-            uint64_t t1 = mpi_recv_value<uint64_t>(i, j, topology::inter_mpicomm());
-            uint64_t t2 = clock_gettime_ns();
-
-            // adopt the fastest communitation
-            if (t2 - t0 < min_gap) {
-              min_gap = t2 - t0;
-              offsets[i] = t1 - static_cast<int64_t>((t0 + t2) / 2);
-            }
-          }
-        }
+  void pong(int target_rank) const {
+    for (int j = 0; j < n_sync_round_trips_; j++) {
+      mpi_recv_value<uint64_t>(target_rank, j, topology::inter_mpicomm());
+      uint64_t t1 = clock_gettime_ns();
+      mpi_send_value(t1, target_rank, j, topology::inter_mpicomm());
+    }
+  }
 
-        // Adjust the offset to begin with t=0
-        int64_t begin_time = clock_gettime_ns();
-        for (int i = 0; i < topology::inter_n_ranks(); i++) {
-          offsets[i] += begin_time;
+  clock_offset measure_offset_flat() const {
+    // takes O(n) time, where n = # of nodes
+    if (topology::inter_my_rank() == 0) {
+      for (int i = 1; i < topology::inter_n_ranks(); i++) {
+        pong(i);
+      }
+      return {0, 0};
+    } else {
+      return ping(0);
+    }
+  }
+
+  clock_offset measure_offset_tree() const {
+    // Each node measures the offset from its parent in a binomial tree rooted at node 0 (the parent
+    // of node i is i with its lowest set bit cleared), and then the offsets are composed from the
+    // root to the leaves. Takes O(log n) time, where n = # of nodes, as disjoint pairs of nodes
+    // measure their offsets in parallel.
+    int me = topology::inter_my_rank();
+    int n  = topology::inter_n_ranks();
+
+    clock_offset ret {0, 0};
+
+    int d = 1;
+    for (; d < n; d *= 2) {
+      if (me % (d * 2) == 0) {
+        if (me + d < n) {
+          pong(me + d);
         }
       } else {
-        for (int j = 0; j < n_sync_round_trips_; j++) {
-          mpi_recv_value<uint64_t>(0, j, topology::inter_mpicomm());
-          uint64_t t1 = clock_gettime_ns();
-          mpi_send_value(t1, 0, j, topology::inter_mpicomm());
+        ITYR_CHECK(me % (d * 2) == d);
+        ret = ping(me - d);
+        break;
+      }
+    }
+
+    // Compose the offsets in the reverse order
+    for (; d >= 1; d /= 2) {
+      if (me % (d * 2) == 0) {
+        if (me + d < n) {
+          mpi_send_value(ret, me + d, 0, topology::inter_mpicomm());
         }
+      } else if (me % (d * 2) == d) {
+        clock_offset parent = mpi_recv_value<clock_offset>(me - d, 0, topology::inter_mpicomm());
+        ret.offset += parent.offset;
+        ret.error  += parent.error;
       }
+    }
+
+    return ret;
+  }
 
-      offset_ = mpi_scatter_value(offsets, 0, topology::inter_mpicomm());
+  uint64_t do_sync() {
+    struct sync_result {
+      int64_t     offset;
+      double      drift;
+      wallclock_t t_sync;
+      uint64_t    error;
+    };
+
+    sync_result result;
+
+    // Only the leader of each node involves in clock synchronization
+    if (topology::intra_my_rank() == 0) {
+      // uses the reference clock of the node of rank 0
+      clock_offset co = sync_tree_ ? measure_offset_tree() : measure_offset_flat();
 
-      delete[] offsets;
+      wallclock_t t_sync = clock_gettime_ns();
+
+      if (!synced_) {
+        // Adjust the offset to begin with t=0
+        begin_time_ = mpi_bcast_value(clock_gettime_ns(), 0, topology::inter_mpicomm());
+      }
+
+      int64_t offset = co.offset + begin_time_;
+
+      double drift = 0;
+      if (synced_ && drift_compensation_ && t_sync > t_sync_) {
+        // Offsets are measured by the reference clock, which is also drifting
+        drift = static_cast<double>(offset - offset_) / static_cast<double>(t_sync - t_sync_);
+      }
+
+      result = {offset, drift, t_sync, co.error};
     }
 
     // Share the offset within the node
-    offset_ = mpi_bcast_value(offset_, 0, topology::intra_mpicomm());
+    result = mpi_bcast_value(result, 0, topology::intra_mpicomm());
+
+    offset_     = result.offset;
+    drift_      = result.drift;
+    t_sync_     = result.t_sync;
+    begin_time_ = mpi_bcast_value(begin_time_, 0, topology::intra_mpicomm());
+    synced_     = true;
+
+    return result.error;
   }
 
-  int     n_sync_round_trips_;
-  int64_t offset_;
+  int         n_sync_round_trips_;
+  bool        sync_tree_;
+  bool        drift_compensation_;
+  bool        synced_     = false;
+  int64_t     offset_     = 0;
+  double      drift_      = 0;
+  wallclock_t t_sync_     = 0;
+  int64_t     begin_time_ = 0;
 };
 
 using instance = singleton<global_clock>;
@@ -53,6 +53,7 @@ public:
     n_   = cs.n_;
     cs.ptr_ = nullptr;
     cs.n_   = 0;
+    return *this;
   }
 
   constexpr pointer data() const noexcept { return ptr_; }
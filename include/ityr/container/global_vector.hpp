@@ -33,6 +33,23 @@ struct global_vector_options {
    * @brief The number of elements for leaf tasks to stop parallel recursion in construction and destruction.
    */
   std::size_t cutoff_count = 1024;
+
+  /**
+   * @brief Block size of a collective global vector (0 for the default).
+   *
+   * Must be a power of two from 4 KiB to 16 MiB. Smaller blocks reduce the amount of data fetched
+   * by fine-grained random accesses, while larger blocks distribute the vector in larger
+   * contiguous segments for streaming accesses.
+   */
+  std::size_t block_size = 0;
+
+  /**
+   * @brief Size of the cache partition reserved for a collective global vector (0 for none).
+   *
+   * Cached elements of the vector are not evicted by accesses to other global memory
+   * (and vice versa), e.g., to prevent streaming data from evicting randomly accessed data.
+   */
+  std::size_t cache_partition_size = 0;
 };
 
 /**
@@ -259,8 +276,10 @@ private:
 
   pointer allocate_mem(size_type count) const {
     if (opts_.collective) {
+      // Options are passed by value, as `this` cannot be accessed by other processes
+      ori::coll_mem_options cm_opts {opts_.block_size, opts_.cache_partition_size};
       return coll_exec_if_coll([=] {
-        return ori::malloc_coll<T>(count);
+        return ori::malloc_coll<T>(count, cm_opts);
       });
     } else {
       return ori::malloc<T>(count);
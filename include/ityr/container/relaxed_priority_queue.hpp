@@ -0,0 +1,441 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <map>
+#include <unordered_map>
+#include <memory>
+#include <functional>
+#include <limits>
+
+#include "ityr/common/util.hpp"
+#include "ityr/common/mpi_util.hpp"
+#include "ityr/common/topology.hpp"
+#include "ityr/ito/ito.hpp"
+#include "ityr/ori/ori.hpp"
+#include "ityr/pattern/root_exec.hpp"
+#include "ityr/container/global_span.hpp"
+
+namespace ityr {
+
+/**
+ * @brief Relaxed distributed priority queue for bucket-synchronous graph algorithms.
+ *
+ * @tparam Key      Key type of items (e.g., vertex IDs). Must be trivially copyable and hashable.
+ * @tparam Priority Arithmetic type of priorities (e.g., tentative distances).
+ * @tparam Hash     Hash function to determine the owner process of each key.
+ *
+ * This queue keeps the best (smallest) priority for each key and returns keys in the order of
+ * *buckets* of priorities, where the bucket of a priority `p` is `p / delta` (rounded down).
+ * Items in the same bucket are not ordered, which relaxes the priority order and exposes parallelism,
+ * as in the Delta-stepping algorithm for single-source shortest paths (SSSP).
+ *
+ * The queue is distributed over processes:
+ * - `push()` can be called by any thread, and it only appends the item to the local buffer of the
+ *   process currently running the thread, without any communication.
+ * - `pop_bucket()` is a global synchronization point called by the root thread (or in the SPMD region).
+ *   It sends the buffered items to their owner processes (determined by hashing keys), where each
+ *   owner keeps per-key best priorities and a local bucket heap. Then the globally minimum nonempty
+ *   bucket is determined, and its items are gathered into a global memory region as the next frontier.
+ *
+ * A key is returned by `pop_bucket()` again only if its priority has been improved after it was
+ * returned. Thus, when a bucket is processed, new items pushed into the same bucket (e.g., via light
+ * edges in Delta-stepping) are returned by the next `pop_bucket()` call.
+ *
+ * The queue object must be created and destroyed collectively in the SPMD region. Use `get_handle()`
+ * to obtain a lightweight handle that can be copied to parallel tasks.
+ *
+ * Example:
+ * ```
+ * ityr::relaxed_priority_queue<long, double> pq(0.5); // delta = 0.5
+ * ityr::root_exec([h = pq.get_handle()] {
+ *   h.push(0, 0.0);
+ *   while (true) {
+ *     auto frontier = h.pop_bucket();
+ *     if (frontier.empty()) break;
+ *     ityr::for_each(ityr::execution::par,
+ *                    ityr::make_global_iterator(frontier.begin(), ityr::checkout_mode::read),
+ *                    ityr::make_global_iterator(frontier.end()  , ityr::checkout_mode::read),
+ *                    [=](auto item) {
+ *                      // relax neighbors of `item.key` with the priority `item.priority`
+ *                      // h.push(neighbor, item.priority + weight);
+ *                    });
+ *   }
+ * });
+ * ```
+ *
+ * @see U. Meyer and P. Sanders, "Delta-stepping: a parallelizable shortest path algorithm", J. Algorithms, 2003.
+ */
+template <typename Key, typename Priority, typename Hash = std::hash<Key>>
+class relaxed_priority_queue {
+  static_assert(std::is_trivially_copyable_v<Key>);
+  static_assert(std::is_arithmetic_v<Priority>);
+
+  using this_t = relaxed_priority_queue<Key, Priority, Hash>;
+
+public:
+  using key_type      = Key;
+  using priority_type = Priority;
+  using bucket_type   = std::size_t;
+
+  /**
+   * @brief Item in the queue.
+   */
+  struct item {
+    key_type      key;
+    priority_type priority;
+  };
+
+  class handle;
+
+  /**
+   * @brief Create a relaxed priority queue (collective).
+   * @param delta Bucket width of priorities. Must be positive.
+   */
+  explicit relaxed_priority_queue(priority_type delta, Hash hash = {})
+    : id_(create_state(delta, hash)) {
+    ITYR_CHECK(ito::is_spmd());
+    ITYR_REQUIRE_MESSAGE(delta > 0, "The bucket width (delta) of relaxed_priority_queue must be positive");
+  }
+
+  ~relaxed_priority_queue() {
+    ITYR_CHECK(ito::is_spmd());
+    auto& s = get_state(id_);
+    if (s.frontier) {
+      ori::free_coll(s.frontier);
+    }
+    states()[id_].reset();
+  }
+
+  relaxed_priority_queue(const this_t&) = delete;
+  this_t& operator=(const this_t&) = delete;
+
+  /**
+   * @brief Return a handle of this queue that can be copied to parallel tasks.
+   */
+  handle get_handle() const { return handle(id_); }
+
+  /**
+   * @brief Push an item (see `handle::push()`).
+   */
+  void push(const key_type& key, priority_type priority) const { get_handle().push(key, priority); }
+
+  /**
+   * @brief Pop the minimum bucket (see `handle::pop_bucket()`).
+   */
+  global_span<item> pop_bucket() const { return get_handle().pop_bucket(); }
+
+  /**
+   * @brief Apply a function to each key owned by the calling process and its best priority.
+   *
+   * This function must be called in the SPMD region. Each key that has ever been pushed is owned
+   * by exactly one process, so calling this function on all processes visits all keys once.
+   */
+  template <typename Fn>
+  void for_each_local(Fn fn) const {
+    ITYR_CHECK(ito::is_spmd());
+    for (auto&& [key, e] : get_state(id_).entries) {
+      fn(key, e.priority);
+    }
+  }
+
+  /**
+   * @brief Handle of `ityr::relaxed_priority_queue` that can be copied to parallel tasks.
+   */
+  class handle {
+  public:
+    handle() {}
+
+    /**
+     * @brief Push an item with a priority.
+     *
+     * The item is buffered in the process running the calling thread and becomes visible at the
+     * next `pop_bucket()` call. If the same key is pushed multiple times, only the smallest
+     * priority is kept.
+     */
+    void push(const key_type& key, priority_type priority) const {
+      get_state(id_).outbox.push_back(item{key, priority});
+    }
+
+    /**
+     * @brief Pop all items in the minimum nonempty bucket.
+     *
+     * @return A global span of popped items, or an empty span if the queue is empty. The span is
+     *         valid until the next `pop_bucket()` call or destruction of the queue.
+     *
+     * This function must be called by the root thread (within `ityr::root_exec()`) or collectively
+     * in the SPMD region, as it involves global synchronization across all processes.
+     */
+    global_span<item> pop_bucket() const {
+      if (ito::is_spmd()) {
+        return pop_bucket_coll(id_);
+      } else {
+        ITYR_CHECK(ito::is_root());
+        return coll_exec([id = id_] { return pop_bucket_coll(id); });
+      }
+    }
+
+  private:
+    friend class relaxed_priority_queue;
+
+    explicit handle(int id) : id_(id) {}
+
+    int id_ = -1;
+  };
+
+private:
+  struct entry {
+    priority_type priority;
+    bool          popped;
+  };
+
+  struct local_state {
+    priority_type                                  delta;
+    Hash                                           hash;
+    std::vector<item>                              outbox;
+    std::unordered_map<key_type, entry, Hash>      entries;
+    std::map<bucket_type, std::vector<key_type>>   buckets;
+    ori::global_ptr<item>                          frontier;
+  };
+
+  // The local states are looked up by IDs so that handles can be safely copied across processes.
+  // As queues are created collectively, the same ID is assigned to the same queue on all processes.
+  static std::vector<std::unique_ptr<local_state>>& states() {
+    static std::vector<std::unique_ptr<local_state>> states_;
+    return states_;
+  }
+
+  static int create_state(priority_type delta, Hash hash) {
+    auto& ss = states();
+    ss.push_back(std::make_unique<local_state>(local_state{delta, hash, {}, {}, {}, {}}));
+    return ss.size() - 1;
+  }
+
+  static local_state& get_state(int id) {
+    ITYR_CHECK(0 <= id);
+    ITYR_CHECK(static_cast<std::size_t>(id) < states().size());
+    ITYR_CHECK(states()[id]);
+    return *states()[id];
+  }
+
+  static bucket_type bucket_of(const local_state& s, priority_type priority) {
+    return static_cast<bucket_type>(priority / s.delta);
+  }
+
+  static bool is_valid(const local_state& s, const key_type& key, bucket_type b) {
+    auto it = s.entries.find(key);
+    return it != s.entries.end() && !it->second.popped && bucket_of(s, it->second.priority) == b;
+  }
+
+  static void exchange_items(local_state& s) {
+    auto mpicomm = common::topology::mpicomm();
+    int n_ranks = common::topology::n_ranks();
+
+    // Sort buffered items by their owners
+    std::vector<int> send_counts(n_ranks, 0);
+    for (auto&& it : s.outbox) {
+      send_counts[s.hash(it.key) % n_ranks] += sizeof(item);
+    }
+
+    std::vector<int> send_displs(n_ranks, 0);
+    for (int i = 1; i < n_ranks; i++) {
+      send_displs[i] = send_displs[i - 1] + send_counts[i - 1];
+    }
+
+    std::vector<item> send_buf(s.outbox.size());
+    {
+      std::vector<int> pos(send_displs);
+      for (auto&& it : s.outbox) {
+        int& p = pos[s.hash(it.key) % n_ranks];
+        send_buf[p / sizeof(item)] = it;
+        p += sizeof(item);
+      }
+    }
+    s.outbox.clear();
+
+    std::vector<int> recv_counts(n_ranks);
+    common::mpi_alltoall(send_counts.data(), recv_counts.data(), 1, mpicomm);
+
+    std::vector<int> recv_displs(n_ranks, 0);
+    for (int i = 1; i < n_ranks; i++) {
+      recv_displs[i] = recv_displs[i - 1] + recv_counts[i - 1];
+    }
+
+    std::size_t n_recv = (recv_displs[n_ranks - 1] + recv_counts[n_ranks - 1]) / sizeof(item);
+    std::vector<item> recv_buf(n_recv);
+
+    common::mpi_alltoallv(reinterpret_cast<const std::byte*>(send_buf.data()), send_counts.data(), send_displs.data(),
+                          reinterpret_cast<std::byte*>(recv_buf.data()), recv_counts.data(), recv_displs.data(),
+                          mpicomm);
+
+    // Keep only improved priorities
+    for (auto&& it : recv_buf) {
+      auto [e, inserted] = s.entries.try_emplace(it.key, entry{it.priority, false});
+      if (inserted || it.priority < e->second.priority) {
+        e->second = entry{it.priority, false};
+        s.buckets[bucket_of(s, it.priority)].push_back(it.key);
+      }
+    }
+  }
+
+  static bucket_type local_min_bucket(local_state& s) {
+    // Stale keys (whose priorities were improved or which were already popped) are lazily removed
+    while (!s.buckets.empty()) {
+      auto& [b, keys] = *s.buckets.begin();
+      keys.erase(std::remove_if(keys.begin(), keys.end(),
+                                [&, b = b](const key_type& k) { return !is_valid(s, k, b); }),
+                 keys.end());
+      if (!keys.empty()) {
+        return b;
+      }
+      s.buckets.erase(s.buckets.begin());
+    }
+    return std::numeric_limits<bucket_type>::max();
+  }
+
+  static global_span<item> pop_bucket_coll(int id) {
+    auto& s = get_state(id);
+    auto mpicomm = common::topology::mpicomm();
+
+    if (s.frontier) {
+      ori::free_coll(s.frontier);
+      s.frontier = {};
+    }
+
+    exchange_items(s);
+
+    bucket_type my_min = local_min_bucket(s);
+    bucket_type global_min = common::mpi_allreduce_value(my_min, mpicomm, MPI_MIN);
+
+    if (global_min == std::numeric_limits<bucket_type>::max()) {
+      return {};
+    }
+
+    std::vector<item> items;
+    if (my_min == global_min) {
+      auto keys = std::move(s.buckets.begin()->second);
+      s.buckets.erase(s.buckets.begin());
+
+      for (auto&& k : keys) {
+        auto& e = s.entries.at(k);
+        // duplicate keys in the same bucket are popped only once
+        if (!e.popped) {
+          e.popped = true;
+          items.push_back(item{k, e.priority});
+        }
+      }
+    }
+
+    std::size_t n_total = common::mpi_allreduce_value(items.size(), mpicomm);
+    std::size_t offset  = common::mpi_exscan_value(items.size(), mpicomm);
+
+    s.frontier = ori::malloc_coll<item>(n_total);
+
+    // Write in chunks so as not to exceed the cache capacity
+    constexpr std::size_t chunk_count = std::max(std::size_t(1), std::size_t(65536) / sizeof(item));
+    for (std::size_t i = 0; i < items.size(); i += chunk_count) {
+      std::size_t n = std::min(chunk_count, items.size() - i);
+      ori::put(items.data() + i, s.frontier + offset + i, n);
+    }
+
+    ori::release();
+    common::mpi_barrier(mpicomm);
+    ori::acquire();
+
+    return global_span<item>(s.frontier, n_total);
+  }
+
+  int id_;
+};
+
+ITYR_TEST_CASE("[ityr::relaxed_priority_queue] pop buckets") {
+  ito::init();
+  ori::init();
+
+  using pq_t = relaxed_priority_queue<long, long>;
+
+  ITYR_SUBCASE("SPMD") {
+    pq_t pq(10);
+
+    if (common::topology::my_rank() == 0) {
+      pq.push(1, 25);
+      pq.push(2, 5);
+      pq.push(3, 7);
+      pq.push(1, 21); // improved in the same bucket
+      pq.push(4, 100);
+      pq.push(4, 12); // improved to another bucket
+    }
+
+    auto f1 = pq.pop_bucket();
+    ITYR_CHECK(f1.size() == 2); // keys 2 and 3
+    auto f2 = pq.pop_bucket();
+    ITYR_CHECK(f2.size() == 1); // key 4
+    ITYR_CHECK(f2[0].get().key == 4);
+    ITYR_CHECK(f2[0].get().priority == 12);
+
+    // a popped key is returned again only if improved
+    if (common::topology::my_rank() == 0) {
+      pq.push(4, 13);
+      pq.push(2, 1);
+    }
+
+    auto f3 = pq.pop_bucket();
+    ITYR_CHECK(f3.size() == 1); // key 2
+    ITYR_CHECK(f3[0].get().key == 2);
+    ITYR_CHECK(f3[0].get().priority == 1);
+
+    auto f4 = pq.pop_bucket();
+    ITYR_CHECK(f4.size() == 1); // key 1
+    ITYR_CHECK(f4[0].get().priority == 21);
+
+    ITYR_CHECK(pq.pop_bucket().empty());
+  }
+
+  ITYR_SUBCASE("root thread") {
+    pq_t pq(4);
+
+    long n = 1000;
+
+    // Relax a chain graph i -> i + 1 with weight 1 (and a shortcut 0 -> i with weight 2 * i)
+    long n_pops = root_exec([=, h = pq.get_handle()] {
+      h.push(0, 0);
+      long count = 0;
+      while (true) {
+        auto frontier = h.pop_bucket();
+        if (frontier.empty()) break;
+        count++;
+        for_each(execution::parallel_policy{.cutoff_count = 1, .checkout_count = 1},
+                 make_global_iterator(frontier.begin(), checkout_mode::read),
+                 make_global_iterator(frontier.end()  , checkout_mode::read),
+                 [=](const pq_t::item& it) {
+                   if (it.key + 1 < n) {
+                     h.push(it.key + 1, it.priority + 1);
+                   }
+                   if (it.key == 0) {
+                     for (long i = 1; i < n; i++) {
+                       h.push(i, 2 * i);
+                     }
+                   }
+                 });
+      }
+      return count;
+    });
+
+    ITYR_CHECK(n_pops > 0);
+
+    long n_keys = 0;
+    bool correct = true;
+    pq.for_each_local([&](long key, long priority) {
+      n_keys++;
+      correct &= (priority == key);
+    });
+
+    ITYR_CHECK(correct);
+    ITYR_CHECK(common::mpi_allreduce_value(n_keys, common::topology::mpicomm()) == n);
+  }
+
+  ori::fini();
+  ito::fini();
+}
+
+}
@@ -6,6 +6,7 @@
 #include "ityr/common/options.hpp"
 #include "ityr/common/topology.hpp"
 #include "ityr/common/wallclock.hpp"
+#include "ityr/common/netemu.hpp"
 #include "ityr/common/profiler.hpp"
 #include "ityr/common/prof_events.hpp"
 #include "ityr/ito/util.hpp"
@@ -27,6 +28,7 @@ private:
   common::runtime_options                                    common_opts_;
   common::singleton_initializer<common::topology::instance>  topo_;
   common::singleton_initializer<common::wallclock::instance> clock_;
+  common::singleton_initializer<common::netemu::instance>    netemu_;
   common::singleton_initializer<common::profiler::instance>  prof_;
   common::prof_events                                        common_prof_events_;
 
@@ -83,6 +85,13 @@ inline void poll(PreSuspendCallback&&  pre_suspend_cb,
                  std::forward<PostSuspendCallback>(post_suspend_cb));
 }
 
+template <typename Fn>
+inline auto remote_invoke(common::topology::rank_t target_rank, const Fn& fn) {
+  ITYR_CHECK(!is_spmd());
+  auto& w = worker::instance::get();
+  return w.sched().remote_invoke(target_rank, fn);
+}
+
 inline scheduler::task_group_data task_group_begin() {
   auto& w = worker::instance::get();
   return w.sched().task_group_begin();
@@ -133,6 +142,30 @@ ITYR_TEST_CASE("[ityr::ito] fib") {
   fini();
 }
 
+ITYR_TEST_CASE("[ityr::ito] remote invocation") {
+  init();
+
+  // Each rank is requested to return its rank number times two
+  std::function<int(common::topology::rank_t, common::topology::rank_t)> invoke_all =
+      [&](common::topology::rank_t b, common::topology::rank_t e) -> int {
+    if (e - b == 1) {
+      return remote_invoke(b, [=] { return common::topology::my_rank() * 2; });
+    } else {
+      auto m = b + (e - b) / 2;
+      thread<int> th([=] { return invoke_all(b, m); });
+      int y = invoke_all(m, e);
+      int x = th.join();
+      return x + y;
+    }
+  };
+
+  auto n_ranks = common::topology::n_ranks();
+  int r = root_exec(invoke_all, 0, n_ranks);
+  ITYR_CHECK(r == n_ranks * (n_ranks - 1));
+
+  fini();
+}
+
 ITYR_TEST_CASE("[ityr::ito] load balancing") {
   init();
 
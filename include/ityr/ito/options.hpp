@@ -47,6 +47,32 @@ struct sched_loop_make_mpi_progress_option : public common::option<sched_loop_ma
   static bool default_value() { return true; }
 };
 
+struct sched_loop_backoff_min_option : public common::option<sched_loop_backoff_min_option, std::size_t> {
+  using option::option;
+  static std::string name() { return "ITYR_ITO_SCHED_LOOP_BACKOFF_MIN"; }
+  static std::size_t default_value() { return 0; }
+};
+
+struct sched_loop_backoff_max_option : public common::option<sched_loop_backoff_max_option, std::size_t> {
+  using option::option;
+  static std::string name() { return "ITYR_ITO_SCHED_LOOP_BACKOFF_MAX"; }
+  static std::size_t default_value() { return 100000; }
+};
+
+struct wsqueue_work_hint_option : public common::option<wsqueue_work_hint_option, bool> {
+  using option::option;
+  static std::string name() { return "ITYR_ITO_WSQUEUE_WORK_HINT"; }
+  static bool default_value() { return false; }
+};
+
+// Work-stealing queues are grown when full (instead of throwing an exception). Grown queues are
+// allocated in dynamic MPI windows, and the capacity options set their initial capacities.
+struct wsqueue_grow_option : public common::option<wsqueue_grow_option, bool> {
+  using option::option;
+  static std::string name() { return "ITYR_ITO_WSQUEUE_GROW"; }
+  static bool default_value() { return false; }
+};
+
 struct adws_enable_steal_option : public common::option<adws_enable_steal_option, bool> {
   using option::option;
   static std::string name() { return "ITYR_ITO_ADWS_ENABLE_STEAL"; }
@@ -83,6 +109,10 @@ struct runtime_options {
   common::option_initializer<thread_state_allocator_size_option>     ITYR_ANON_VAR;
   common::option_initializer<suspended_thread_allocator_size_option> ITYR_ANON_VAR;
   common::option_initializer<sched_loop_make_mpi_progress_option>    ITYR_ANON_VAR;
+  common::option_initializer<sched_loop_backoff_min_option>          ITYR_ANON_VAR;
+  common::option_initializer<sched_loop_backoff_max_option>          ITYR_ANON_VAR;
+  common::option_initializer<wsqueue_work_hint_option>               ITYR_ANON_VAR;
+  common::option_initializer<wsqueue_grow_option>                    ITYR_ANON_VAR;
   common::option_initializer<adws_enable_steal_option>               ITYR_ANON_VAR;
   common::option_initializer<adws_wsqueue_capacity_option>           ITYR_ANON_VAR;
   common::option_initializer<adws_max_depth_option>                  ITYR_ANON_VAR;
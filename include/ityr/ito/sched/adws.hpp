@@ -299,8 +299,8 @@ public:
   scheduler_adws()
     : max_depth_(adws_max_depth_option::value()),
       stack_(stack_size_option::value()),
-      primary_wsq_(adws_wsqueue_capacity_option::value(), max_depth_),
-      migration_wsq_(adws_wsqueue_capacity_option::value(), max_depth_),
+      primary_wsq_(adws_wsqueue_capacity_option::value(), max_depth_, false, wsqueue_grow_option::value()),
+      migration_wsq_(adws_wsqueue_capacity_option::value(), max_depth_, false, wsqueue_grow_option::value()),
       thread_state_allocator_(thread_state_allocator_size_option::value()),
       suspended_thread_allocator_(suspended_thread_allocator_size_option::value()),
       dtree_(max_depth_) {}
@@ -714,8 +714,12 @@ public:
         continue;
       }
 
-      if (adws_enable_steal_option::value()) {
-        steal();
+      if (adws_enable_steal_option::value() && steal_backoff_.ready()) {
+        if (steal()) {
+          steal_backoff_.on_success();
+        } else {
+          steal_backoff_.on_failure();
+        }
       }
 
       if constexpr (!std::is_null_pointer_v<std::remove_reference_t<SchedLoopCallback>>) {
@@ -731,6 +735,8 @@ public:
   template <typename PreSuspendCallback, typename PostSuspendCallback>
   void poll(PreSuspendCallback&&  pre_suspend_cb,
             PostSuspendCallback&& post_suspend_cb) {
+    remote_invoke_mailbox_.process();
+
     check_cross_worker_task_arrival<prof_phase_thread, prof_phase_thread>(
         std::forward<PreSuspendCallback>(pre_suspend_cb),
         std::forward<PostSuspendCallback>(post_suspend_cb));
@@ -769,6 +775,11 @@ public:
     }
   }
 
+  template <typename Fn>
+  auto remote_invoke(common::topology::rank_t target_rank, const Fn& fn) {
+    return remote_invoke_mailbox_.invoke(target_rank, fn, [&] { execute_coll_task_if_arrived(); });
+  }
+
   bool is_executing_root() const {
     return cf_top_ && cf_top_ == stack_top();
   }
@@ -953,11 +964,11 @@ private:
     resume_sched();
   }
 
-  void steal() {
+  bool steal() {
     auto ne = dtree_.get_topmost_dominant(dtree_local_bottom_ref_);
     if (!ne.has_value()) {
       common::verbose<2>("Dominant dist_tree node not found");
-      return;
+      return false;
     }
     dist_range steal_range = ne->drange;
     flipper    tg_version  = ne->tg_version;
@@ -976,7 +987,7 @@ private:
     }
 
     if (begin_rank == end_rank) {
-      return;
+      return false;
     }
 
     ITYR_CHECK((begin_rank <= my_rank || my_rank <= end_rank));
@@ -995,7 +1006,7 @@ private:
         bool success = steal_from_migration_queues(target_rank, depth, migration_wsq_.n_queues(),
             [=](migration_wsq_entry& mwe) { return mwe.tg_version.match(tg_version, depth); });
         if (success) {
-          return;
+          return true;
         }
       }
 
@@ -1003,7 +1014,7 @@ private:
         bool success = steal_from_primary_queues(target_rank, depth, primary_wsq_.n_queues(),
             [=](primary_wsq_entry& pwe) { return pwe.tg_version.match(tg_version, depth); });
         if (success) {
-          return;
+          return true;
         }
       }
 
@@ -1011,9 +1022,11 @@ private:
       auto cwt = cross_worker_mailbox_.pop();
       if (cwt.has_value()) {
         execute_cross_worker_task(*cwt);
-        return;
+        return true;
       }
     }
+
+    return false;
   }
 
   template <typename StealCondFn>
@@ -1517,6 +1530,8 @@ private:
 
     execute_coll_task_if_arrived();
 
+    remote_invoke_mailbox_.process();
+
     if (sched_loop_exit_req_ == MPI_REQUEST_NULL &&
         std::forward<CondFn>(cond_fn)()) {
       // If a given condition is met, enters a barrier
@@ -1532,6 +1547,7 @@ private:
   int                                max_depth_;
   callstack                          stack_;
   oneslot_mailbox<coll_task>         coll_task_mailbox_;
+  remote_invoke_mailbox              remote_invoke_mailbox_;
   oneslot_mailbox<cross_worker_task> cross_worker_mailbox_;
   wsqueue<primary_wsq_entry, false>  primary_wsq_;
   wsqueue<migration_wsq_entry, true> migration_wsq_;
@@ -1542,6 +1558,7 @@ private:
   thread_local_storage*              tls_                 = nullptr;
   MPI_Request                        sched_loop_exit_req_ = MPI_REQUEST_NULL;
   bool                               use_primary_wsq_     = true;
+  steal_backoff                      steal_backoff_;
   dist_tree                          dtree_;
   dist_tree::node_ref                dtree_local_bottom_ref_;
   bool                               dag_prof_enabled_ = false;
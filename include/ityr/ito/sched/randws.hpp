@@ -55,7 +55,7 @@ public:
 
   scheduler_randws()
     : stack_(stack_size_option::value()),
-      wsq_(wsqueue_capacity_option::value()),
+      wsq_(wsqueue_capacity_option::value(), 1, wsqueue_work_hint_option::value(), wsqueue_grow_option::value()),
       thread_state_allocator_(thread_state_allocator_size_option::value()),
       suspended_thread_allocator_(suspended_thread_allocator_size_option::value()) {}
 
@@ -242,7 +242,13 @@ public:
     common::verbose("Enter scheduling loop");
 
     while (!should_exit_sched_loop(std::forward<CondFn>(cond_fn))) {
-      steal();
+      if (steal_backoff_.ready()) {
+        if (steal()) {
+          steal_backoff_.on_success();
+        } else {
+          steal_backoff_.on_failure();
+        }
+      }
 
       if constexpr (!std::is_null_pointer_v<std::remove_reference_t<SchedLoopCallback>>) {
         cb();
@@ -253,7 +259,9 @@ public:
   }
 
   template <typename PreSuspendCallback, typename PostSuspendCallback>
-  void poll(PreSuspendCallback&&, PostSuspendCallback&&) {}
+  void poll(PreSuspendCallback&&, PostSuspendCallback&&) {
+    remote_invoke_mailbox_.process();
+  }
 
   template <typename Fn, typename... Args>
   auto coll_exec(Fn&& fn, Args&&... args) {
@@ -288,6 +296,11 @@ public:
     }
   }
 
+  template <typename Fn>
+  auto remote_invoke(common::topology::rank_t target_rank, const Fn& fn) {
+    return remote_invoke_mailbox_.invoke(target_rank, fn, [&] { execute_coll_task_if_arrived(); });
+  }
+
   bool is_executing_root() const {
     return cf_top_ && cf_top_ == stack_top();
   }
@@ -383,26 +396,26 @@ private:
     resume_sched();
   }
 
-  void steal() {
+  bool steal() {
     auto target_rank = get_random_rank(0, common::topology::n_ranks() - 1);
 
     auto ibd = common::profiler::interval_begin<prof_event_sched_steal>(target_rank);
 
     if (wsq_.empty(target_rank)) {
       common::profiler::interval_end<prof_event_sched_steal>(ibd, false);
-      return;
+      return false;
     }
 
     if (!wsq_.lock().trylock(target_rank)) {
       common::profiler::interval_end<prof_event_sched_steal>(ibd, false);
-      return;
+      return false;
     }
 
     auto we = wsq_.steal_nolock(target_rank);
     if (!we.has_value()) {
       wsq_.lock().unlock(target_rank);
       common::profiler::interval_end<prof_event_sched_steal>(ibd, false);
-      return;
+      return false;
     }
 
     common::verbose("Steal context frame [%p, %p) from rank %d",
@@ -422,6 +435,8 @@ private:
       context::clear_parent_frame(next_cf);
       resume(next_cf);
     });
+
+    return true;
   }
 
   template <typename Fn>
@@ -551,6 +566,8 @@ private:
 
     execute_coll_task_if_arrived();
 
+    remote_invoke_mailbox_.process();
+
     if (sched_loop_exit_req_ == MPI_REQUEST_NULL &&
         std::forward<CondFn>(cond_fn)()) {
       // If a given condition is met, enters a barrier
@@ -570,12 +587,14 @@ private:
 
   callstack                  stack_;
   oneslot_mailbox<coll_task> coll_task_mailbox_;
+  remote_invoke_mailbox      remote_invoke_mailbox_;
   wsqueue<wsqueue_entry>     wsq_;
   common::remotable_resource thread_state_allocator_;
   common::remotable_resource suspended_thread_allocator_;
   context_frame*             cf_top_              = nullptr;
   context_frame*             sched_cf_            = nullptr;
   MPI_Request                sched_loop_exit_req_ = MPI_REQUEST_NULL;
+  steal_backoff              steal_backoff_;
   thread_local_storage*      tls_                 = nullptr;
   bool                       dag_prof_enabled_    = false;
   dag_profiler               dag_prof_result_;
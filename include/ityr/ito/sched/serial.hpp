@@ -37,6 +37,11 @@ public:
   template <typename PreSuspendCallback, typename PostSuspendCallback>
   void poll(PreSuspendCallback&&, PostSuspendCallback&&) {}
 
+  template <typename Fn>
+  auto remote_invoke(common::topology::rank_t, const Fn& fn) {
+    return fn();
+  }
+
   template <typename T>
   static bool is_serialized(thread_handler<T>) {
     return true;
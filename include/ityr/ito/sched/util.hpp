@@ -1,7 +1,10 @@
 #pragma once
 
 #include <random>
+#include <algorithm>
 #include <atomic>
+#include <cstddef>
+#include <cstring>
 
 #include "ityr/common/util.hpp"
 #include "ityr/common/topology.hpp"
@@ -134,6 +137,41 @@ inline common::topology::rank_t get_random_rank(common::topology::rank_t a,
   return rank;
 }
 
+// Exponential backoff with jitter for idle workers, so that failed steal attempts do not flood the
+// network with remote atomics while other workers are busy (disabled if the minimum delay is 0).
+class steal_backoff {
+public:
+  steal_backoff()
+    : min_delay_(sched_loop_backoff_min_option::value()),
+      max_delay_(std::max(min_delay_, sched_loop_backoff_max_option::value())),
+      // The rank is mixed into the seed so that workers do not back off in lockstep even if
+      // std::random_device is deterministic on the platform
+      engine_(std::random_device{}() + common::topology::my_rank()) {}
+
+  bool ready() const {
+    return min_delay_ == 0 || common::clock_gettime_ns() >= next_time_;
+  }
+
+  void on_success() {
+    delay_ = 0;
+  }
+
+  void on_failure() {
+    if (min_delay_ == 0) return;
+
+    delay_ = std::clamp(delay_ * 2, min_delay_, max_delay_);
+    std::uniform_int_distribution<uint64_t> dist(delay_ / 2, delay_);
+    next_time_ = common::clock_gettime_ns() + dist(engine_);
+  }
+
+private:
+  uint64_t     min_delay_;
+  uint64_t     max_delay_;
+  uint64_t     delay_     = 0;
+  uint64_t     next_time_ = 0;
+  std::mt19937 engine_;
+};
+
 template <typename T, typename Fn, typename... Args>
 static T invoke_fn(Fn&& fn, Args&&... args) {
   T retval;
@@ -184,4 +222,144 @@ private:
   common::mpi_win_manager<mailbox> win_;
 };
 
+// Mailbox for remote invocations (function shipping).
+// Each process has a message slot for every other process, and a requester blocks until the
+// target process executes the function (when it polls the mailbox) and sends back the result.
+// As the requester has at most one outstanding request, slots and replies are never overwritten.
+class remote_invoke_mailbox {
+public:
+  static constexpr std::size_t max_size = 256;
+
+  remote_invoke_mailbox()
+    : msg_win_(common::topology::mpicomm(), common::topology::n_ranks()),
+      mailbox_win_(common::topology::mpicomm(), 1) {}
+
+  template <typename Fn, typename WaitCallback>
+  auto invoke(common::topology::rank_t target_rank, const Fn& fn, WaitCallback&& wait_cb) {
+    using retval_t = std::invoke_result_t<const Fn&>;
+    static_assert(std::is_trivially_copyable_v<Fn>,
+                  "Functions for remote invocation must be trivially copyable");
+    static_assert(sizeof(Fn) <= max_size,
+                  "Functions for remote invocation are too large");
+    if constexpr (!std::is_void_v<retval_t>) {
+      static_assert(std::is_trivially_copyable_v<retval_t>,
+                    "Return values of remote invocation must be trivially copyable");
+      static_assert(sizeof(retval_t) <= max_size,
+                    "Return values of remote invocation are too large");
+    }
+
+    if (target_rank == common::topology::my_rank()) {
+      return fn();
+    }
+
+    ITYR_CHECK_MESSAGE(!waiting_, "Remote invocation cannot be nested");
+
+    auto my_rank = common::topology::my_rank();
+    mailbox& mb = mailbox_win_.local_buf()[0];
+    mb.reply.done.store(0, std::memory_order_relaxed);
+
+    message msg;
+    msg.handler = &handler<Fn>;
+    std::memcpy(msg.payload, &fn, sizeof(Fn));
+
+    std::size_t msg_disp = sizeof(message) * my_rank;
+    common::mpi_put(reinterpret_cast<const std::byte*>(&msg), offsetof(message, payload) + sizeof(Fn),
+                    target_rank, msg_disp, msg_win_.win());
+
+    int      arrived   = 1;
+    uint64_t increment = 1;
+    int      arrived_prev;
+    uint64_t n_arrived_prev;
+    common::mpi_atomic_put_nb(&arrived, &arrived_prev, target_rank,
+                              msg_disp + offsetof(message, arrived), msg_win_.win());
+    common::mpi_atomic_faa_nb(&increment, &n_arrived_prev, target_rank,
+                              offsetof(mailbox, n_arrived), mailbox_win_.win());
+    common::mpi_win_flush(target_rank, msg_win_.win());
+    common::mpi_win_flush(target_rank, mailbox_win_.win());
+
+    // Keep serving requests (and collective tasks via `wait_cb`) while waiting to avoid deadlocks
+    waiting_ = true;
+    while (!mb.reply.done.load(std::memory_order_acquire)) {
+      if (sched_loop_make_mpi_progress_option::value()) {
+        common::mpi_make_progress();
+      }
+      process();
+      wait_cb();
+    }
+    waiting_ = false;
+
+    if constexpr (!std::is_void_v<retval_t>) {
+      return *reinterpret_cast<retval_t*>(mb.reply.value);
+    }
+  }
+
+  // Execute all arrived requests and return true if any
+  bool process() {
+    mailbox& mb = mailbox_win_.local_buf()[0];
+    if (mb.n_arrived.load(std::memory_order_acquire) == n_processed_) {
+      return false;
+    }
+
+    bool processed = false;
+    for (common::topology::rank_t i = 0; i < common::topology::n_ranks(); i++) {
+      message& msg = msg_win_.local_buf()[i];
+      if (msg.arrived.load(std::memory_order_acquire)) {
+        msg.arrived.store(0, std::memory_order_relaxed);
+
+        alignas(std::max_align_t) std::byte retval[max_size];
+        std::size_t retval_size = msg.handler(msg.payload, retval);
+
+        if (retval_size > 0) {
+          common::mpi_put(retval, retval_size, i,
+                          offsetof(mailbox, reply) + offsetof(reply_slot, value), mailbox_win_.win());
+        }
+        common::mpi_atomic_put_value(1, i, offsetof(mailbox, reply) + offsetof(reply_slot, done),
+                                     mailbox_win_.win());
+
+        n_processed_++;
+        processed = true;
+      }
+    }
+    return processed;
+  }
+
+private:
+  using handler_t = std::size_t (*)(const void*, void*);
+
+  template <typename Fn>
+  static std::size_t handler(const void* payload, void* retval) {
+    using retval_t = std::invoke_result_t<const Fn&>;
+    const Fn& fn = *reinterpret_cast<const Fn*>(payload);
+    if constexpr (std::is_void_v<retval_t>) {
+      fn();
+      return 0;
+    } else {
+      retval_t ret = fn();
+      std::memcpy(retval, &ret, sizeof(retval_t));
+      return sizeof(retval_t);
+    }
+  }
+
+  struct message {
+    handler_t                           handler;
+    alignas(std::max_align_t) std::byte payload[max_size];
+    std::atomic<int>                    arrived = 0; // TODO: better to use std::atomic_ref in C++20
+  };
+
+  struct reply_slot {
+    alignas(std::max_align_t) std::byte value[max_size];
+    std::atomic<int>                    done = 0;
+  };
+
+  struct mailbox {
+    std::atomic<uint64_t> n_arrived = 0;
+    reply_slot            reply;
+  };
+
+  common::mpi_win_manager<message> msg_win_;
+  common::mpi_win_manager<mailbox> mailbox_win_;
+  uint64_t                         n_processed_ = 0;
+  bool                             waiting_     = false;
+};
+
 }
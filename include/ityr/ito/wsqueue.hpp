@@ -3,10 +3,13 @@
 #include <atomic>
 #include <optional>
 #include <memory>
+#include <vector>
+#include <cstdlib>
 #include <type_traits>
 #include <algorithm>
 
 #include "ityr/common/util.hpp"
+#include "ityr/common/logger.hpp"
 #include "ityr/common/mpi_util.hpp"
 #include "ityr/common/mpi_rma.hpp"
 #include "ityr/common/topology.hpp"
@@ -24,14 +27,39 @@ public:
 template <typename Entry, bool EnablePass = true>
 class wsqueue {
 public:
-  wsqueue(int n_entries, int n_queues = 1)
+  wsqueue(int n_entries, int n_queues = 1, bool enable_work_hint = false, bool enable_grow = false)
     : n_entries_(n_entries),
       n_queues_(n_queues),
-      initial_pos_(EnablePass ? n_entries / 2 : 0),
+      initial_pos_(initial_pos(n_entries)),
       queue_state_win_(common::topology::mpicomm(), n_queues_ * 2, initial_pos_),
       entries_win_(common::topology::mpicomm(), n_entries_ * n_queues_),
       queue_lock_(n_queues_),
-      local_empty_(n_queues_, false) {}
+      local_empty_(n_queues_, false),
+      work_hint_enabled_(enable_work_hint),
+      work_hint_win_(work_hint_enabled_ ? common::mpi_win_manager<std::atomic<int>>(common::topology::mpicomm(), n_queues_, 0)
+                                        : common::mpi_win_manager<std::atomic<int>>()),
+      grow_enabled_(enable_grow),
+      grown_entries_win_(grow_enabled_ ? common::mpi_win_manager<void>(common::topology::mpicomm())
+                                       : common::mpi_win_manager<void>()),
+      segment_win_(grow_enabled_ ? common::mpi_win_manager<segment>(common::topology::mpicomm(), n_queues_)
+                                 : common::mpi_win_manager<segment>()),
+      grown_entries_(grow_enabled_ ? n_queues_ : 0) {
+    if (grow_enabled_) {
+      for (int idx = 0; idx < n_queues_; idx++) {
+        local_segment(idx) = {nullptr, n_entries_};
+      }
+      // Segments must be visible to other processes before they pass entries to this queue
+      common::mpi_barrier(common::topology::mpicomm());
+    }
+  }
+
+  ~wsqueue() {
+    for (auto& entries : grown_entries_) {
+      if (entries) {
+        common::mpi_win_detach(entries.get(), grown_entries_win_.win());
+      }
+    }
+  }
 
   void push(const Entry& entry, int idx = 0) {
     ITYR_PROFILER_RECORD(prof_event_wsqueue_push);
@@ -39,21 +67,24 @@ public:
     ITYR_CHECK(idx < n_queues_);
 
     queue_state& qs = local_queue_state(idx);
-    auto entries = local_entries(idx);
 
     int t = qs.top.load(std::memory_order_relaxed);
 
-    if (t == n_entries_) {
+    if (t == local_n_entries(idx)) {
       queue_lock_.priolock(common::topology::my_rank(), idx);
 
       int b = qs.base.load(std::memory_order_relaxed);
-      int offset = -(b + 1) / 2;
-      move_entries(offset, idx);
-      t += offset;
+      if (grow_enabled_ && t - b > local_n_entries(idx) / 2) {
+        grow(idx);
+      } else {
+        move_entries(-(b + 1) / 2, idx);
+      }
+      t = qs.top.load(std::memory_order_relaxed);
 
       queue_lock_.unlock(common::topology::my_rank(), idx);
     }
 
+    auto entries = local_entries(idx);
     entries[t] = entry;
 
     qs.top.store(t + 1, std::memory_order_release);
@@ -61,6 +92,8 @@ public:
     if constexpr (!EnablePass) {
       local_empty_[idx] = false;
     }
+
+    set_work_hint(idx);
   }
 
   template <bool EnsureEmpty = true>
@@ -75,16 +108,23 @@ public:
       // otherwise, remote pass operations may fail.
       // Check before the queue empty check.
       int b = qs.base.load(std::memory_order_relaxed);
-      if (b < n_entries_ / 10) {
+      int n = local_n_entries(idx);
+      if (b < n / 10) {
         int t = qs.top.load(std::memory_order_relaxed);
-        if (n_entries_ - t > n_entries_ / 10) {
+        if (n - t > n / 10) {
           queue_lock_.priolock(common::topology::my_rank(), idx);
 
           int t = qs.top.load(std::memory_order_relaxed);
-          int offset = (n_entries_ - t + 1) / 2;
+          int offset = (n - t + 1) / 2;
           move_entries(offset, idx);
 
           queue_lock_.unlock(common::topology::my_rank(), idx);
+
+        } else if (grow_enabled_) {
+          // If there is no room to move entries, the queue is grown instead
+          queue_lock_.priolock(common::topology::my_rank(), idx);
+          grow(idx);
+          queue_lock_.unlock(common::topology::my_rank(), idx);
         }
       }
     }
@@ -101,6 +141,7 @@ public:
     // TODO: any better way to handle this ordering?
     if constexpr (!EnsureEmpty) {
       if (qs.empty()) {
+        clear_work_hint(idx);
         return std::nullopt;
       }
     }
@@ -130,23 +171,27 @@ public:
       } else if (b == t) {
         ret = entries[t];
 
-        qs.top.store(initial_pos_, std::memory_order_relaxed);
-        qs.base.store(initial_pos_, std::memory_order_relaxed);
+        qs.top.store(initial_pos(local_n_entries(idx)), std::memory_order_relaxed);
+        qs.base.store(initial_pos(local_n_entries(idx)), std::memory_order_relaxed);
 
         // Once we confirm that this queue is empty by taking the lock, later pop operations will
         // always fail if the "pass" operation is not allowed for the queue
         if constexpr (!EnablePass) {
           local_empty_[idx] = true;
         }
+
+        clear_work_hint(idx);
       } else {
         ret = std::nullopt;
 
-        qs.top.store(initial_pos_, std::memory_order_relaxed);
-        qs.base.store(initial_pos_, std::memory_order_relaxed);
+        qs.top.store(initial_pos(local_n_entries(idx)), std::memory_order_relaxed);
+        qs.base.store(initial_pos(local_n_entries(idx)), std::memory_order_relaxed);
 
         if constexpr (!EnablePass) {
           local_empty_[idx] = true;
         }
+
+        clear_work_hint(idx);
       }
 
       queue_lock_.unlock(common::topology::my_rank(), idx);
@@ -164,11 +209,17 @@ public:
 
     std::optional<Entry> ret;
 
+    segment seg = get_segment_nb(target_rank, idx);
+
+    // The base must be reserved before the top is read. The base is atomically updated on its own
+    // (not as a part of the whole queue state), as the owner updates the top with local stores.
     int b = common::mpi_atomic_faa_value<int>(1, target_rank, queue_state_base_disp(idx), queue_state_win_.win());
-    int t = common::mpi_get_value<int>(target_rank, queue_state_top_disp(idx), queue_state_win_.win());
+    int t = common::mpi_atomic_get_value<int>(target_rank, queue_state_top_disp(idx), queue_state_win_.win());
+
+    complete_get_segment(target_rank);
 
     if (b < t) {
-      ret = common::mpi_get_value<Entry>(target_rank, entries_disp(b, idx), entries_win_.win());
+      ret = get_entry(target_rank, seg, b, idx);
     } else {
       common::mpi_atomic_faa_value<int>(-1, target_rank, queue_state_base_disp(idx), queue_state_win_.win());
       ret = std::nullopt;
@@ -204,17 +255,25 @@ public:
 
     queue_lock_.lock(target_rank, idx);
 
+    segment seg = get_segment_nb(target_rank, idx);
+
     int b = common::mpi_get_value<int>(target_rank, queue_state_base_disp(idx), queue_state_win_.win());
 
+    complete_get_segment(target_rank);
+
     if (b == 0) {
       queue_lock_.unlock(target_rank, idx);
       return false;
     }
 
-    common::mpi_put_value<Entry>(entry, target_rank, entries_disp(b - 1, idx), entries_win_.win());
+    put_entry(entry, target_rank, seg, b - 1, idx);
 
     common::mpi_put_value<int>(b - 1, target_rank, queue_state_base_disp(idx), queue_state_win_.win());
 
+    if (work_hint_enabled_) {
+      common::mpi_atomic_put_value<int>(1, target_rank, work_hint_disp(idx), work_hint_win_.win());
+    }
+
     queue_lock_.unlock(target_rank, idx);
 
     return true;
@@ -267,6 +326,12 @@ public:
 
     ITYR_CHECK(idx < n_queues_);
 
+    if (work_hint_enabled_ &&
+        !common::mpi_get_value<int>(target_rank, work_hint_disp(idx), work_hint_win_.win())) {
+      // The owner has not pushed any entry since it found the queue empty
+      return true;
+    }
+
     auto remote_qs = common::mpi_get_value<queue_state>(target_rank, queue_state_disp(idx), queue_state_win_.win());
     return remote_qs.empty();
   }
@@ -328,6 +393,7 @@ private:
   };
 
   static_assert(std::is_standard_layout_v<queue_state>);
+
   // FIXME: queue_state is no longer trivially copyable.
   //        Thus, strictly speaking, using MPI RMA for queue_state is illegal.
   // static_assert(std::is_trivially_copyable_v<queue_state>);
@@ -353,6 +419,10 @@ private:
     return idx * sizeof(queue_state_wrapper) + offsetof(queue_state_wrapper, value) + offsetof(queue_state, base);
   }
 
+  static constexpr int initial_pos(int n_entries) {
+    return EnablePass ? n_entries / 2 : 0;
+  }
+
   std::size_t entries_disp(int entry_num, int idx) const {
     return (entry_num + idx * n_entries_) * sizeof(Entry);
   }
@@ -366,8 +436,118 @@ private:
     return queue_state_win_.local_buf()[n_queues_ + idx].value;
   }
 
+  // Growable queues (`enable_grow`): when a queue runs out of space, its entries are moved to a
+  // new segment twice as large, which is attached to the dynamic window `grown_entries_win_`.
+  // Each queue initially uses its part of `entries_win_` (the initial segment).
+  // Remote processes read the segment of a queue after acquiring its lock, as segments are
+  // replaced only by the owner with the lock held.
+  struct segment {
+    Entry* entries   = nullptr; // null for the initial segment
+    int    n_entries = 0;
+  };
+
+  struct entries_deleter {
+    void operator()(Entry* p) const { std::free(p); }
+  };
+
+  using entries_ptr = std::unique_ptr<Entry[], entries_deleter>;
+
+  // Segments are allocated in pages (as in `common::mpi_win_resource`), so that different
+  // segments attached to the window do not share pages
+  entries_ptr alloc_entries(int n_entries) const {
+    std::size_t pagesize = common::get_page_size();
+    std::size_t bytes = common::round_up_pow2(sizeof(Entry) * n_entries, pagesize);
+    Entry* p = reinterpret_cast<Entry*>(std::aligned_alloc(pagesize, bytes));
+    ITYR_REQUIRE(p);
+    std::uninitialized_value_construct_n(p, n_entries);
+    common::mpi_win_attach(p, bytes, grown_entries_win_.win());
+    return entries_ptr(p);
+  }
+
+  std::size_t segment_disp(int idx) const {
+    return idx * sizeof(segment);
+  }
+
+  segment& local_segment(int idx) const {
+    ITYR_CHECK(grow_enabled_);
+    return segment_win_.local_buf()[idx];
+  }
+
+  int local_n_entries(int idx) const {
+    return grow_enabled_ ? local_segment(idx).n_entries : n_entries_;
+  }
+
   auto local_entries(int idx) const {
-    return entries_win_.local_buf().subspan(idx * n_entries_, n_entries_);
+    if (grow_enabled_ && grown_entries_[idx]) {
+      return common::span<Entry>(grown_entries_[idx].get(), local_segment(idx).n_entries);
+    } else {
+      return entries_win_.local_buf().subspan(idx * n_entries_, n_entries_);
+    }
+  }
+
+  // The segment is valid after `complete_get_segment()`
+  segment get_segment_nb(common::topology::rank_t target_rank, int idx) const {
+    segment seg;
+    if (grow_enabled_) {
+      common::mpi_get_nb(&seg, 1, target_rank, segment_disp(idx), segment_win_.win());
+    }
+    return seg;
+  }
+
+  void complete_get_segment(common::topology::rank_t target_rank) const {
+    if (grow_enabled_) {
+      common::mpi_win_flush(target_rank, segment_win_.win());
+    }
+  }
+
+  Entry get_entry(common::topology::rank_t target_rank, const segment& seg, int entry_num, int idx) const {
+    if (seg.entries) {
+      // Displacements in dynamic windows are the absolute addresses in the target process
+      return common::mpi_get_value<Entry>(target_rank, reinterpret_cast<uintptr_t>(seg.entries + entry_num),
+                                          grown_entries_win_.win());
+    } else {
+      return common::mpi_get_value<Entry>(target_rank, entries_disp(entry_num, idx), entries_win_.win());
+    }
+  }
+
+  void put_entry(const Entry& entry, common::topology::rank_t target_rank, const segment& seg, int entry_num, int idx) const {
+    if (seg.entries) {
+      common::mpi_put_value<Entry>(entry, target_rank, reinterpret_cast<uintptr_t>(seg.entries + entry_num),
+                                   grown_entries_win_.win());
+    } else {
+      common::mpi_put_value<Entry>(entry, target_rank, entries_disp(entry_num, idx), entries_win_.win());
+    }
+  }
+
+  std::size_t work_hint_disp(int idx) const {
+    return idx * sizeof(std::atomic<int>);
+  }
+
+  // The "work available" hint is set by the owner (or a passing process) after pushing an entry,
+  // and is cleared only by the owner when it finds the queue empty. Thieves can skip queues whose
+  // hint is not set without reading the queue state, which is frequently updated by the owner.
+  void set_work_hint(int idx) {
+    if (work_hint_enabled_) {
+      std::atomic<int>& h = work_hint_win_.local_buf()[idx];
+      if (!h.load(std::memory_order_relaxed)) {
+        h.store(1, std::memory_order_release);
+      }
+    }
+  }
+
+  void clear_work_hint(int idx) {
+    if (work_hint_enabled_) {
+      std::atomic<int>& h = work_hint_win_.local_buf()[idx];
+      if (h.load(std::memory_order_relaxed)) {
+        h.store(0, std::memory_order_relaxed);
+
+        // An entry might have been passed concurrently
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!local_queue_state(idx).empty()) {
+          h.store(1, std::memory_order_relaxed);
+        }
+      }
+    }
   }
 
   void move_entries(int offset, int idx) {
@@ -384,7 +564,7 @@ private:
     int new_b = b + offset;
     int new_t = t + offset;
 
-    if (offset == 0 || new_b < 0 || n_entries_ < new_t) {
+    if (offset == 0 || new_b < 0 || static_cast<int>(entries.size()) < new_t) {
       throw wsqueue_full_exception{};
     }
 
@@ -394,6 +574,40 @@ private:
     qs.base.store(new_b, std::memory_order_relaxed);
   }
 
+  void grow(int idx) {
+    ITYR_CHECK(queue_lock_.is_locked(common::topology::my_rank(), idx));
+
+    ITYR_CHECK(grow_enabled_);
+
+    queue_state& qs = local_queue_state(idx);
+    segment& seg = local_segment(idx);
+    auto entries = local_entries(idx);
+
+    int t = qs.top.load(std::memory_order_relaxed);
+    int b = qs.base.load(std::memory_order_relaxed);
+
+    ITYR_CHECK(b <= t);
+
+    int new_n_entries = seg.n_entries * 2;
+    int new_b = EnablePass ? (new_n_entries - (t - b)) / 2 : 0;
+
+    entries_ptr new_entries = alloc_entries(new_n_entries);
+
+    std::move(&entries[b], &entries[t], new_entries.get() + new_b);
+
+    if (grown_entries_[idx]) {
+      common::mpi_win_detach(grown_entries_[idx].get(), grown_entries_win_.win());
+    }
+    grown_entries_[idx] = std::move(new_entries);
+
+    seg = {grown_entries_[idx].get(), new_n_entries};
+
+    qs.top.store(new_b + (t - b), std::memory_order_relaxed);
+    qs.base.store(new_b, std::memory_order_relaxed);
+
+    common::verbose<2>("Work-stealing queue %d grew to %d entries", idx, new_n_entries);
+  }
+
   int                                          n_entries_;
   int                                          n_queues_;
   int                                          initial_pos_;
@@ -401,6 +615,12 @@ private:
   common::mpi_win_manager<Entry>               entries_win_;
   common::global_lock                          queue_lock_;
   std::vector<bool>                            local_empty_;
+  bool                                         work_hint_enabled_;
+  common::mpi_win_manager<std::atomic<int>>    work_hint_win_;
+  bool                                         grow_enabled_;
+  common::mpi_win_manager<void>                grown_entries_win_;
+  common::mpi_win_manager<segment>             segment_win_;
+  std::vector<entries_ptr>                     grown_entries_; // queue idx -> entries (null if not grown)
 };
 
 ITYR_TEST_CASE("[ityr::ito::wsqueue] single queue") {
@@ -435,6 +655,45 @@ ITYR_TEST_CASE("[ityr::ito::wsqueue] single queue") {
     ITYR_CHECK_THROWS_AS(wsq.push(n_entries), wsqueue_full_exception);
   }
 
+  ITYR_SUBCASE("grow when full") {
+    wsqueue<entry_t> wsq_grow(n_entries, 1, false, true);
+
+    int n = n_entries * 4;
+    for (int i = 0; i < n; i++) {
+      wsq_grow.push(i);
+    }
+    ITYR_CHECK(wsq_grow.size() == n);
+
+    // steal from the grown queue
+    auto result = wsq_grow.steal(my_rank);
+    ITYR_CHECK(result.has_value());
+    ITYR_CHECK(*result == 0);
+
+    for (int i = 0; i < n - 1; i++) {
+      auto result = wsq_grow.pop();
+      ITYR_CHECK(result.has_value());
+      ITYR_CHECK(*result == n - i - 1);
+    }
+    ITYR_CHECK(wsq_grow.empty(my_rank));
+  }
+
+  ITYR_SUBCASE("steal from the local queue") {
+    for (int i = 0; i < 10; i++) {
+      wsq.push(i);
+    }
+    auto result = wsq.steal(my_rank);
+    ITYR_CHECK(result.has_value());
+    ITYR_CHECK(*result == 0); // FIFO order
+    ITYR_CHECK(wsq.size() == 9);
+    for (int i = 0; i < 9; i++) {
+      result = wsq.pop();
+      ITYR_CHECK(result.has_value());
+      ITYR_CHECK(*result == 9 - i);
+    }
+    ITYR_CHECK(!wsq.steal(my_rank).has_value());
+    ITYR_CHECK(wsq.empty(my_rank));
+  }
+
   ITYR_SUBCASE("steal") {
     if (n_ranks == 1) return;
 
@@ -561,6 +820,70 @@ ITYR_TEST_CASE("[ityr::ito::wsqueue] single queue") {
     }
   }
 
+  ITYR_SUBCASE("steal stress on a nearly empty queue") {
+    // The owner keeps only a few entries in the queue so that its pops and remote steals
+    // frequently race for the last entry; each entry must be taken exactly once.
+    if (n_ranks == 1) return;
+
+    int n_pushes = 100000;
+
+    for (common::topology::rank_t target_rank = 0; target_rank < n_ranks; target_rank++) {
+      ITYR_CHECK(wsq.empty(target_rank));
+
+      common::mpi_barrier(common::topology::mpicomm());
+
+      long local_sum = 0;
+      long local_count = 0;
+
+      if (target_rank == my_rank) {
+        for (int i = 0; i < n_pushes; i++) {
+          wsq.push(i);
+          if (i % 2 == 1) {
+            for (int j = 0; j < 2; j++) {
+              auto result = wsq.pop();
+              if (result.has_value()) {
+                local_sum += *result;
+                local_count++;
+              }
+            }
+          }
+        }
+        while (!wsq.empty(my_rank)) {
+          auto result = wsq.pop();
+          if (result.has_value()) {
+            local_sum += *result;
+            local_count++;
+          }
+        }
+
+        auto req = common::mpi_ibarrier(common::topology::mpicomm());
+        common::mpi_wait(req);
+
+      } else {
+        auto req = common::mpi_ibarrier(common::topology::mpicomm());
+        while (!common::mpi_test(req)) {
+          auto result = wsq.steal(target_rank);
+          if (result.has_value()) {
+            local_sum += *result;
+            local_count++;
+          }
+        }
+      }
+
+      long sum_all = common::mpi_reduce_value(local_sum, target_rank, common::topology::mpicomm());
+      long count_all = common::mpi_reduce_value(local_count, target_rank, common::topology::mpicomm());
+
+      ITYR_CHECK(wsq.empty(target_rank));
+
+      if (target_rank == my_rank) {
+        ITYR_CHECK(count_all == n_pushes);
+        ITYR_CHECK(sum_all == long(n_pushes) * (n_pushes - 1) / 2);
+      }
+
+      common::mpi_barrier(common::topology::mpicomm());
+    }
+  }
+
   ITYR_SUBCASE("resize queue") {
     if (n_ranks == 1) return;
 
@@ -714,4 +1037,33 @@ ITYR_TEST_CASE("[ityr::ito::wsqueue] multiple queues") {
   }
 }
 
+ITYR_TEST_CASE("[ityr::ito::wsqueue] work hint") {
+  int n_entries = 1000;
+  using entry_t = int;
+
+  common::runtime_options common_opts;
+  common::singleton_initializer<common::topology::instance> topo;
+  wsqueue<entry_t> wsq(n_entries, 1, true);
+
+  auto my_rank = common::topology::my_rank();
+
+  ITYR_CHECK(wsq.empty(my_rank));
+
+  int n_trial = 3;
+  for (int t = 0; t < n_trial; t++) {
+    for (int i = 0; i < 10; i++) {
+      wsq.push(i);
+      ITYR_CHECK(!wsq.empty(my_rank));
+    }
+    for (int i = 0; i < 10; i++) {
+      ITYR_CHECK(wsq.pop().has_value());
+    }
+    // The hint is cleared when the owner finds the queue empty
+    ITYR_CHECK(!wsq.pop().has_value());
+    ITYR_CHECK(wsq.empty(my_rank));
+  }
+
+  common::mpi_barrier(common::topology::mpicomm());
+}
+
 }
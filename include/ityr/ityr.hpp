@@ -4,6 +4,7 @@
 #include "ityr/common/options.hpp"
 #include "ityr/common/topology.hpp"
 #include "ityr/common/wallclock.hpp"
+#include "ityr/common/netemu.hpp"
 #include "ityr/common/profiler.hpp"
 #include "ityr/ito/ito.hpp"
 #include "ityr/ori/ori.hpp"
@@ -11,9 +12,12 @@
 #include "ityr/pattern/root_exec.hpp"
 #include "ityr/pattern/parallel_loop.hpp"
 #include "ityr/pattern/parallel_invoke.hpp"
+#include "ityr/pattern/task_group.hpp"
+#include "ityr/pattern/remote_invoke.hpp"
 #include "ityr/container/global_span.hpp"
 #include "ityr/container/global_vector.hpp"
 #include "ityr/container/checkout_span.hpp"
+#include "ityr/container/relaxed_priority_queue.hpp"
 
 namespace ityr {
 
@@ -32,6 +36,7 @@ private:
   common::runtime_options                                    opts_;
   common::singleton_initializer<common::topology::instance>  topo_;
   common::singleton_initializer<common::wallclock::instance> clock_;
+  common::singleton_initializer<common::netemu::instance>    netemu_;
   common::singleton_initializer<common::profiler::instance>  prof_;
   common::singleton_initializer<ito::instance>               ito_;
   common::singleton_initializer<ori::instance>               ori_;
@@ -120,6 +125,7 @@ inline void barrier() {
   ITYR_CHECK(is_spmd());
   ori::release();
   common::mpi_barrier(common::topology::mpicomm());
+  ori::migrate_homes();
   ori::acquire();
 }
 
@@ -0,0 +1,231 @@
+#pragma once
+
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <memory>
+#include <vector>
+
+#include "ityr/common/util.hpp"
+#include "ityr/common/options.hpp"
+#include "ityr/common/topology.hpp"
+#include "ityr/ori/util.hpp"
+#include "ityr/ori/options.hpp"
+
+namespace ityr::ori {
+
+/*
+ * Binary trace of global memory accesses, replayed by the offline cache simulator (tools/cache_sim.cpp).
+ *
+ * Each process writes a file that begins with `access_trace_header`, followed by fixed-size
+ * `access_trace_record`s in the order of events. Accesses (checkout/checkin/get/put) are recorded
+ * only while the cache profiler is running (between `ityr::profiler_begin()` and `ityr::profiler_end()`),
+ * while allocation events and fences are always recorded so that the trace can be replayed consistently.
+ */
+
+enum class access_trace_event : uint8_t {
+  checkout,
+  checkin,
+  get,
+  put,
+  release,
+  acquire,
+  alloc_coll,
+  free_coll,
+};
+
+enum class access_trace_mode : uint8_t {
+  none,
+  read,
+  write,
+  read_write,
+};
+
+inline access_trace_mode to_access_trace_mode(mode::read_t) { return access_trace_mode::read; }
+inline access_trace_mode to_access_trace_mode(mode::write_t) { return access_trace_mode::write; }
+inline access_trace_mode to_access_trace_mode(mode::read_write_t) { return access_trace_mode::read_write; }
+
+struct access_trace_header {
+  char     magic[8];
+  uint32_t version;
+  int32_t  rank;
+  int32_t  n_ranks;
+  uint32_t block_size;
+
+  static constexpr const char* magic_str = "ITYRTRC";
+  static constexpr uint32_t current_version = 1;
+};
+
+struct access_trace_record {
+  uint64_t           addr;
+  uint64_t           size;
+  uint32_t           epoch; // incremented at each acquire fence
+  int32_t            owner; // owner of noncollective memory (-1 for collective memory)
+  access_trace_event event;
+  access_trace_mode  mode;
+  uint8_t            padding[6];
+};
+
+static_assert(sizeof(access_trace_record) == 32);
+
+class access_tracer_disabled {
+public:
+  access_tracer_disabled(block_size_t) {}
+  void record(access_trace_event, const void*, std::size_t,
+              access_trace_mode = access_trace_mode::none, int = -1) {}
+  void start() {}
+  void stop() {}
+};
+
+class access_tracer_enabled {
+public:
+  access_tracer_enabled(block_size_t block_size, const std::string& filename = trace_out_filename())
+    : file_(std::fopen(filename.c_str(), "w"), &std::fclose) {
+    if (!file_) {
+      common::die("Cannot open the access trace file %s", filename.c_str());
+    }
+
+    access_trace_header h = {};
+    std::strncpy(h.magic, access_trace_header::magic_str, sizeof(h.magic));
+    h.version    = access_trace_header::current_version;
+    h.rank       = common::topology::my_rank();
+    h.n_ranks    = common::topology::n_ranks();
+    h.block_size = block_size;
+    std::fwrite(&h, sizeof(h), 1, file_.get());
+
+    buf_.reserve(buf_capacity);
+  }
+
+  ~access_tracer_enabled() {
+    flush();
+  }
+
+  void record(access_trace_event event,
+              const void*        addr,
+              std::size_t        size,
+              access_trace_mode  mode  = access_trace_mode::none,
+              int                owner = -1) {
+    bool is_access = event == access_trace_event::checkout ||
+                     event == access_trace_event::checkin ||
+                     event == access_trace_event::get ||
+                     event == access_trace_event::put;
+    if (is_access && !enabled_) return;
+
+    if (event == access_trace_event::acquire) {
+      epoch_++;
+    }
+
+    buf_.push_back({reinterpret_cast<uintptr_t>(addr), size, epoch_, owner, event, mode, {}});
+
+    if (buf_.size() >= buf_capacity) {
+      flush();
+    }
+  }
+
+  void start() { enabled_ = true; }
+  void stop() { enabled_ = false; }
+
+private:
+  static constexpr std::size_t buf_capacity = std::size_t(1) << 16;
+
+  static std::string trace_out_filename() {
+    std::stringstream ss;
+    ss << "ityr_access_trace_" << common::topology::my_rank() << ".ignore";
+    return ss.str();
+  }
+
+  void flush() {
+    std::fwrite(buf_.data(), sizeof(access_trace_record), buf_.size(), file_.get());
+    buf_.clear();
+  }
+
+  std::unique_ptr<FILE, int (*)(FILE*)> file_;
+  std::vector<access_trace_record>      buf_;
+  bool                                  enabled_ = false;
+  uint32_t                              epoch_   = 0;
+};
+
+using access_tracer = ITYR_CONCAT(access_tracer_, ITYR_ORI_ACCESS_TRACE);
+
+// Reads a trace file written by `access_tracer_enabled`
+class access_trace_reader {
+public:
+  access_trace_reader(const std::string& filename)
+    : file_(std::fopen(filename.c_str(), "r"), &std::fclose) {
+    if (!file_) {
+      common::die("Cannot open the access trace file %s", filename.c_str());
+    }
+    if (std::fread(&header_, sizeof(header_), 1, file_.get()) != 1 ||
+        std::strncmp(header_.magic, access_trace_header::magic_str, sizeof(header_.magic)) != 0 ||
+        header_.version != access_trace_header::current_version) {
+      common::die("%s is not a valid access trace file", filename.c_str());
+    }
+  }
+
+  const access_trace_header& header() const { return header_; }
+
+  // Returns false at the end of the trace
+  bool next(access_trace_record& r) {
+    return std::fread(&r, sizeof(r), 1, file_.get()) == 1;
+  }
+
+private:
+  std::unique_ptr<FILE, int (*)(FILE*)> file_;
+  access_trace_header                   header_;
+};
+
+ITYR_TEST_CASE("[ityr::ori::access_trace] write and read a trace") {
+  common::runtime_options common_opts;
+  common::singleton_initializer<common::topology::instance> topo;
+
+  std::stringstream ss;
+  ss << "ityr_access_trace_test_" << common::topology::my_rank() << ".ignore";
+  std::string filename = ss.str();
+
+  std::byte* addr = reinterpret_cast<std::byte*>(0x100000);
+
+  {
+    access_tracer_enabled tracer(65536, filename);
+    tracer.record(access_trace_event::alloc_coll, addr, 1024);
+    tracer.record(access_trace_event::checkout, addr, 16, access_trace_mode::read); // not recorded
+    tracer.start();
+    tracer.record(access_trace_event::checkout, addr + 16, 32, access_trace_mode::read_write);
+    tracer.record(access_trace_event::acquire, nullptr, 0);
+    tracer.record(access_trace_event::get, addr + 64, 8, access_trace_mode::read, 1);
+    tracer.stop();
+  }
+
+  access_trace_reader reader(filename);
+  ITYR_CHECK(reader.header().rank == common::topology::my_rank());
+  ITYR_CHECK(reader.header().n_ranks == common::topology::n_ranks());
+  ITYR_CHECK(reader.header().block_size == 65536);
+
+  access_trace_record r;
+
+  ITYR_REQUIRE(reader.next(r));
+  ITYR_CHECK(r.event == access_trace_event::alloc_coll);
+  ITYR_CHECK(r.addr == reinterpret_cast<uintptr_t>(addr));
+  ITYR_CHECK(r.size == 1024);
+
+  ITYR_REQUIRE(reader.next(r));
+  ITYR_CHECK(r.event == access_trace_event::checkout);
+  ITYR_CHECK(r.addr == reinterpret_cast<uintptr_t>(addr + 16));
+  ITYR_CHECK(r.size == 32);
+  ITYR_CHECK(r.mode == access_trace_mode::read_write);
+  ITYR_CHECK(r.epoch == 0);
+  ITYR_CHECK(r.owner == -1);
+
+  ITYR_REQUIRE(reader.next(r));
+  ITYR_CHECK(r.event == access_trace_event::acquire);
+
+  ITYR_REQUIRE(reader.next(r));
+  ITYR_CHECK(r.event == access_trace_event::get);
+  ITYR_CHECK(r.epoch == 1);
+  ITYR_CHECK(r.owner == 1);
+
+  ITYR_CHECK(!reader.next(r));
+
+  std::remove(filename.c_str());
+}
+
+}
@@ -18,6 +18,9 @@
 #include "ityr/ori/tlb.hpp"
 #include "ityr/ori/release_manager.hpp"
 #include "ityr/ori/cache_profiler.hpp"
+#include "ityr/ori/node_cache.hpp"
+#include "ityr/ori/fetch_granularity.hpp"
+#include "ityr/ori/twin_diff.hpp"
 
 namespace ityr::ori {
 
@@ -36,6 +39,9 @@ public:
       cs_(cache_size / BlockSize, cache_block(this)),
       cache_win_(common::rma::create_win(reinterpret_cast<std::byte*>(vm_.addr()), vm_.size())),
       max_dirty_cache_blocks_(max_dirty_cache_size_option::value() / BlockSize),
+      node_cache_(init_node_cache()),
+      adaptive_fetch_(adaptive_sub_block_option::value()),
+      enable_twin_diff_(twin_diff_option::value()),
       cprof_(cs_.num_entries()) {
     ITYR_CHECK(cache_size_ > 0);
     ITYR_CHECK(common::is_pow2(cache_size_));
@@ -44,7 +50,7 @@ public:
     ITYR_CHECK(sub_block_size_ <= BlockSize);
   }
 
-  template <bool SkipFetch, bool IncrementRef>
+  template <bool SkipFetch, bool IncrementRef, bool MakeTwin = false>
   bool checkout_fast(std::byte* addr, std::size_t size) {
     ITYR_CHECK(addr);
     ITYR_CHECK(size > 0);
@@ -63,6 +69,10 @@ public:
 
     block_region br = {addr - blk_addr, addr + size - blk_addr};
 
+    if (adaptive_fetch_) {
+      cb.requested_regions.add(br);
+    }
+
     if constexpr (SkipFetch) {
       cprof_.record_writeonly(cb.entry_idx, br, cb.valid_regions);
       cb.valid_regions.add(br);
@@ -70,6 +80,11 @@ public:
       if (fetch_begin(cb, br)) {
         add_fetching_win(*cb.win);
       }
+      if constexpr (MakeTwin) {
+        if (enable_twin_diff_) {
+          twins_to_make_.push_back({blk_addr, br});
+        }
+      }
     }
 
     if constexpr (IncrementRef) {
@@ -79,20 +94,32 @@ public:
     return true;
   }
 
-  template <bool SkipFetch, bool IncrementRef>
+  template <bool SkipFetch, bool IncrementRef, bool MakeTwin = false>
   void checkout_blk(std::byte*               blk_addr,
                     std::byte*               req_addr_b,
                     std::byte*               req_addr_e,
                     const common::rma::win&  win,
                     common::topology::rank_t owner,
-                    std::size_t              pm_offset) {
+                    std::size_t              pm_offset,
+                    const void*              alloc_addr,
+                    block_size_t             fetch_block_size,
+                    cache_partition_t        partition = 0) {
     ITYR_CHECK(blk_addr <= req_addr_b);
     ITYR_CHECK(blk_addr <= req_addr_e);
     ITYR_CHECK(req_addr_b <= blk_addr + BlockSize);
     ITYR_CHECK(req_addr_e <= blk_addr + BlockSize);
     ITYR_CHECK(req_addr_b < req_addr_e);
+    ITYR_CHECK(common::is_pow2(fetch_block_size));
+
+    cache_block& cb = get_entry(blk_addr, partition);
 
-    cache_block& cb = get_entry(blk_addr);
+    cb.fetch_block_size = std::min(fetch_block_size, BlockSize);
+
+    if (adaptive_fetch_) {
+      auto it = fetch_granularities_.find(alloc_addr);
+      ITYR_CHECK(it != fetch_granularities_.end());
+      cb.fetch_granularity = &it->second.granularity;
+    }
 
     if (blk_addr != cb.mapped_addr) {
       cb.addr      = blk_addr;
@@ -108,6 +135,10 @@ public:
 
     block_region br = {req_addr_b - blk_addr, req_addr_e - blk_addr};
 
+    if (adaptive_fetch_) {
+      cb.requested_regions.add(br);
+    }
+
     if constexpr (SkipFetch) {
       cprof_.record_writeonly(cb.entry_idx, br, cb.valid_regions);
       cb.valid_regions.add(br);
@@ -115,6 +146,11 @@ public:
       if (fetch_begin(cb, br)) {
         add_fetching_win(win);
       }
+      if constexpr (MakeTwin) {
+        if (enable_twin_diff_) {
+          twins_to_make_.push_back({blk_addr, br});
+        }
+      }
     }
 
     if constexpr (IncrementRef) {
@@ -136,6 +172,16 @@ public:
     }
 
     fetch_complete();
+
+    if (!twins_to_make_.empty()) {
+      // Twins are made after the fetched data arrive and before the user modifies them
+      for (auto [blk_addr, br] : twins_to_make_) {
+        if (is_cached(blk_addr)) {
+          make_twin(get_entry<false>(blk_addr), br);
+        }
+      }
+      twins_to_make_.clear();
+    }
   }
 
   template <bool RegisterDirty, bool DecrementRef>
@@ -215,6 +261,7 @@ public:
     // FIXME: no need to writeback dirty data here?
     ensure_all_cache_clean();
     invalidate_all();
+    update_node_acquire_seq();
   }
 
   template <typename ReleaseHandler>
@@ -226,6 +273,7 @@ public:
       rm_.ensure_released(rh);
     }
     invalidate_all();
+    update_node_acquire_seq();
   }
 
   void poll() {
@@ -249,6 +297,54 @@ public:
     cs_.ensure_evicted(cache_key(addr));
   }
 
+  block_size_t sub_block_size() const { return sub_block_size_; }
+  std::size_t cache_size() const { return cache_size_; }
+
+  // Register the fetch granularity of an allocation beginning at `addr` (null for noncollective memory).
+  // The granularity is adjusted dynamically only if ITYR_ORI_ADAPTIVE_SUB_BLOCK is enabled.
+  void add_alloc(void* addr, std::size_t size, block_size_t fetch_block_size) {
+    if (adaptive_fetch_) {
+      block_size_t min = std::min(adaptive_sub_block_min_option::value(), std::size_t(BlockSize));
+      block_size_t max = std::min(adaptive_sub_block_max_option::value(), std::size_t(BlockSize));
+      ITYR_REQUIRE_MESSAGE(common::is_pow2(min) && common::is_pow2(max) && min <= max,
+                           "ITYR_ORI_ADAPTIVE_SUB_BLOCK_MIN/MAX must be powers of two (min <= max)");
+      fetch_granularities_.try_emplace(addr, fetch_granularity_entry{
+          addr, size, adaptive_fetch_granularity(fetch_block_size, min, max)});
+    }
+  }
+
+  // Must be called after all cache blocks of the allocation are evicted
+  void remove_alloc(void* addr) {
+    if (adaptive_fetch_) {
+      auto it = fetch_granularities_.find(addr);
+      ITYR_CHECK(it != fetch_granularities_.end());
+      fetch_granularity_history_.push_back({it->second.addr, it->second.size,
+                                            it->second.granularity.get(),
+                                            it->second.granularity.n_records()});
+      fetch_granularities_.erase(it);
+    }
+  }
+
+  cache_partition_t reserve_partition(std::size_t size) {
+    cache_entry_idx_t nentries = (size + BlockSize - 1) / BlockSize;
+    try {
+      return cs_.reserve_partition(nentries);
+    } catch (cache_full_exception& e) {
+      // write back all dirty cache and retry
+      ensure_all_cache_clean();
+      try {
+        return cs_.reserve_partition(nentries);
+      } catch (cache_full_exception& e) {
+        common::die("Cannot reserve a cache partition of %ld bytes (cache size: %ld bytes)",
+                    size, cache_size_);
+      }
+    }
+  }
+
+  void release_partition(cache_partition_t partition) {
+    cs_.release_partition(partition);
+  }
+
   void discard_dirty(std::byte* blk_addr,
                      std::byte* req_addr_b,
                      std::byte* req_addr_e) {
@@ -270,6 +366,74 @@ public:
     }
   }
 
+  void writeback_region_begin(std::byte* blk_addr,
+                              std::byte* req_addr_b,
+                              std::byte* req_addr_e) {
+    ITYR_CHECK(blk_addr <= req_addr_b);
+    ITYR_CHECK(blk_addr <= req_addr_e);
+    ITYR_CHECK(req_addr_b <= blk_addr + BlockSize);
+    ITYR_CHECK(req_addr_e <= blk_addr + BlockSize);
+    ITYR_CHECK(req_addr_b < req_addr_e);
+
+    if (is_cached(blk_addr)) {
+      cache_block& cb = get_entry<false>(blk_addr);
+
+      // The entire dirty data in the block are written back for simplicity
+      if (!cb.dirty_regions.empty()) {
+        writeback_begin(cb);
+      }
+    }
+  }
+
+  void writeback_region_complete() {
+    writeback_complete();
+  }
+
+  void overwrite_blk(std::byte*       blk_addr,
+                     std::byte*       req_addr_b,
+                     std::byte*       req_addr_e,
+                     const std::byte* from_addr) {
+    ITYR_CHECK(blk_addr <= req_addr_b);
+    ITYR_CHECK(blk_addr <= req_addr_e);
+    ITYR_CHECK(req_addr_b <= blk_addr + BlockSize);
+    ITYR_CHECK(req_addr_e <= blk_addr + BlockSize);
+    ITYR_CHECK(req_addr_b < req_addr_e);
+
+    if (is_cached(blk_addr)) {
+      cache_block& cb = get_entry<false>(blk_addr);
+
+      if (cb.is_writing_back()) {
+        // The ongoing writeback must not be reordered with the subsequent put to the same location
+        writeback_complete();
+      }
+
+      // Dirty data in the region are superseded by the new data written directly to home
+      block_region br = {req_addr_b - blk_addr, req_addr_e - blk_addr};
+      cb.dirty_regions.remove(br);
+      cb.twin_regions.remove(br);
+
+      // Patch the cached copy so that subsequent reads from the cache observe the new data.
+      // The region might be invalid, in which case copying data does no harm.
+      ITYR_CHECK(cb.entry_idx < cs_.num_entries());
+      std::byte* to_addr = reinterpret_cast<std::byte*>(vm_.addr()) + cb.entry_idx * BlockSize + br.begin;
+      std::memcpy(to_addr, from_addr, req_addr_e - req_addr_b);
+    }
+
+    if (node_cache_) {
+      node_cache_overwritten_blks_.push_back(blk_addr);
+    }
+  }
+
+  void overwrite_complete() {
+    if (node_cache_) {
+      // Stale copies in the node cache must be invalidated after the new data reached home
+      for (std::byte* blk_addr : node_cache_overwritten_blks_) {
+        node_cache_->invalidate(blk_addr);
+      }
+      node_cache_overwritten_blks_.clear();
+    }
+  }
+
   void get_copy_blk(std::byte* blk_addr,
                     std::byte* req_addr_b,
                     std::byte* req_addr_e,
@@ -312,22 +476,36 @@ public:
 
   void cache_prof_begin() { invalidate_all(); cprof_.start(); }
   void cache_prof_end() { cprof_.stop(); }
-  void cache_prof_print() const { cprof_.print(); }
+  // Collective, as the adaptive fetch granularities are reduced across processes
+  void cache_prof_print() const {
+    cprof_.print();
+    if (adaptive_fetch_) {
+      print_fetch_granularities();
+    }
+  }
+
+  /* APIs for debugging */
+
+  std::size_t n_twin_diff_writebacks() const { return n_twin_diff_writebacks_; }
 
 private:
   using writeback_epoch_t = uint64_t;
 
   struct cache_block {
-    cache_entry_idx_t        entry_idx       = std::numeric_limits<cache_entry_idx_t>::max();
-    std::byte*               addr            = nullptr;
-    std::byte*               mapped_addr     = nullptr;
-    const common::rma::win*  win             = nullptr;
-    common::topology::rank_t owner           = -1;
-    std::size_t              pm_offset       = 0;
-    int                      ref_count       = 0;
-    writeback_epoch_t        writeback_epoch = 0;
+    cache_entry_idx_t        entry_idx        = std::numeric_limits<cache_entry_idx_t>::max();
+    std::byte*               addr             = nullptr;
+    std::byte*               mapped_addr      = nullptr;
+    const common::rma::win*  win              = nullptr;
+    common::topology::rank_t owner            = -1;
+    std::size_t              pm_offset        = 0;
+    block_size_t             fetch_block_size = BlockSize;
+    int                      ref_count        = 0;
+    writeback_epoch_t        writeback_epoch  = 0;
     block_regions            valid_regions;
     block_regions            dirty_regions;
+    block_regions            requested_regions; // only for adaptive fetch granularity
+    block_regions            twin_regions; // only for twin/diff writeback
+    adaptive_fetch_granularity* fetch_granularity = nullptr;
     cache_manager*           outer;
 
     cache_block(cache_manager* outer_p) : outer(outer_p) {}
@@ -339,9 +517,16 @@ private:
     void invalidate() {
       outer->cprof_.invalidate(entry_idx, valid_regions);
 
+      if (fetch_granularity) {
+        fetch_granularity->record(valid_regions.size(),
+                                  get_intersection(valid_regions, requested_regions).size());
+      }
+      requested_regions.clear();
+
       ITYR_CHECK(!is_writing_back());
       ITYR_CHECK(dirty_regions.empty());
       valid_regions.clear();
+      twin_regions.clear();
       ITYR_CHECK(is_evictable());
 
       common::verbose<3>("Cache block %ld for [%p, %p) invalidated",
@@ -360,6 +545,7 @@ private:
       ITYR_CHECK(is_evictable());
       invalidate();
       entry_idx = std::numeric_limits<cache_entry_idx_t>::max();
+      fetch_granularity = nullptr;
       // for safety
       outer->cache_tlb_.clear();
     }
@@ -375,6 +561,23 @@ private:
     return ss.str();
   }
 
+  std::unique_ptr<node_cache<BlockSize>> init_node_cache() const {
+    std::size_t size = node_cache_size_option::value();
+    if (size == 0 || common::topology::intra_n_ranks() == 1) {
+      return nullptr;
+    }
+    ITYR_REQUIRE_MESSAGE(size % BlockSize == 0,
+                         "ITYR_ORI_NODE_CACHE_SIZE must be a multiple of the block size");
+    return std::make_unique<node_cache<BlockSize>>(size);
+  }
+
+  void update_node_acquire_seq() {
+    if (node_cache_) {
+      // Data in the node cache can be reused only if they were fetched after this point
+      node_acquire_seq_ = node_cache_->new_seq();
+    }
+  }
+
   common::physical_mem init_cache_pm() {
     common::physical_mem pm(cache_shmem_name(common::topology::my_rank()), vm_.size(), true);
     pm.map_to_vm(vm_.addr(), vm_.size(), 0);
@@ -389,20 +592,20 @@ private:
     return reinterpret_cast<uintptr_t>(addr) / BlockSize;
   }
 
-  block_region pad_fetch_region(block_region br) const {
-    return {common::round_down_pow2(br.begin, sub_block_size_),
-            common::round_up_pow2(br.end, sub_block_size_)};
+  block_region pad_fetch_region(block_region br, block_size_t fetch_block_size) const {
+    return {common::round_down_pow2(br.begin, fetch_block_size),
+            common::round_up_pow2(br.end, fetch_block_size)};
   }
 
   template <bool UpdateLRU = true>
-  cache_block& get_entry(void* addr) {
+  cache_block& get_entry(void* addr, cache_partition_t partition = 0) {
     try {
-      return cs_.template ensure_cached<UpdateLRU>(cache_key(addr));
+      return cs_.template ensure_cached<UpdateLRU>(cache_key(addr), partition);
     } catch (cache_full_exception& e) {
       // write back all dirty cache and retry
       ensure_all_cache_clean();
       try {
-        return cs_.template ensure_cached<UpdateLRU>(cache_key(addr));
+        return cs_.template ensure_cached<UpdateLRU>(cache_key(addr), partition);
       } catch (cache_full_exception& e) {
         common::die("cache is exhausted (too much checked-out memory)");
       }
@@ -432,12 +635,15 @@ private:
       return false;
     }
 
-    block_region br_pad = pad_fetch_region(br);
+    block_region br_pad = pad_fetch_region(br, cb.fetch_granularity ? cb.fetch_granularity->get()
+                                                                    : cb.fetch_block_size);
 
     std::byte* cache_begin = reinterpret_cast<std::byte*>(vm_.addr());
 
     block_regions fetch_regions = cb.valid_regions.inverse(br_pad);
 
+    bool fetching = false;
+
     // fetch only nondirty sections
     for (auto [blk_offset_b, blk_offset_e] : fetch_regions) {
       ITYR_CHECK(cb.entry_idx < cs_.num_entries());
@@ -446,18 +652,29 @@ private:
       std::size_t size      = blk_offset_e - blk_offset_b;
       std::size_t pm_offset = cb.pm_offset + blk_offset_b;
 
+      if (node_cache_) {
+        std::byte* blk_data = cache_begin + cb.entry_idx * BlockSize;
+        if (node_cache_->get(cb.addr, {blk_offset_b, blk_offset_e}, blk_data, node_acquire_seq_)) {
+          cprof_.record_node_hit(size);
+          continue;
+        }
+        // the sequence number must be taken before issuing RMA
+        node_cache_to_publish_.push_back({cb.addr, {blk_offset_b, blk_offset_e}, node_cache_->new_seq()});
+      }
+
       common::verbose<3>("Fetching [%p, %p) (%ld bytes) to cache block %d from rank %d (win=%p, disp=%ld)",
                          cb.addr + blk_offset_b, cb.addr + blk_offset_e, size,
                          cb.entry_idx, cb.owner, cb.win, pm_offset);
 
       common::rma::get_nb(*cache_win_, addr, size, *cb.win, cb.owner, pm_offset);
+      fetching = true;
     }
 
     cb.valid_regions.add(br_pad);
 
     cprof_.record(cb.entry_idx, br, fetch_regions);
 
-    return true;
+    return fetching;
   }
 
   void fetch_complete() {
@@ -469,6 +686,20 @@ private:
       }
       fetching_wins_.clear();
     }
+
+    if (!node_cache_to_publish_.empty()) {
+      for (auto [blk_addr, br, seq] : node_cache_to_publish_) {
+        // The block may have been evicted in the meantime
+        if (is_cached(blk_addr)) {
+          cache_block& cb = get_entry<false>(blk_addr);
+          if (cb.valid_regions.include(br)) {
+            std::byte* blk_data = reinterpret_cast<std::byte*>(vm_.addr()) + cb.entry_idx * BlockSize;
+            node_cache_->put(blk_addr, br, blk_data, seq);
+          }
+        }
+      }
+      node_cache_to_publish_.clear();
+    }
   }
 
   void add_fetching_win(const common::rma::win& win) {
@@ -514,27 +745,86 @@ private:
       ITYR_CHECK(cb.writeback_epoch < writeback_epoch_);
     }
 
-    std::byte* cache_begin = reinterpret_cast<std::byte*>(vm_.addr());
+    ITYR_CHECK(cb.entry_idx < cs_.num_entries());
 
-    for (auto [blk_offset_b, blk_offset_e] : cb.dirty_regions) {
-      ITYR_CHECK(cb.entry_idx < cs_.num_entries());
+    std::size_t written_size = 0;
 
-      std::byte*  addr      = cache_begin + cb.entry_idx * BlockSize + blk_offset_b;
-      std::size_t size      = blk_offset_e - blk_offset_b;
-      std::size_t pm_offset = cb.pm_offset + blk_offset_b;
+    if (twins_ && !cb.twin_regions.empty()) {
+      std::byte* blk_data = reinterpret_cast<std::byte*>(vm_.addr()) + cb.entry_idx * BlockSize;
+      std::byte* twin     = twins_.get() + cb.entry_idx * BlockSize;
 
-      common::verbose<3>("Writing back [%p, %p) (%ld bytes) to rank %d (win=%p, disp=%ld)",
-                         cb.addr + blk_offset_b, cb.addr + blk_offset_e, size,
-                         cb.owner, cb.win, pm_offset);
+      for (auto br : cb.dirty_regions) {
+        // Regions without twins are entirely written back
+        for (auto br_ : cb.twin_regions.inverse(br)) {
+          writeback_region(cb, br_);
+          written_size += br_.size();
+        }
 
-      common::rma::put_nb(*cache_win_, addr, size, *cb.win, cb.owner, pm_offset);
+        // Only modified bytes are written back for twinned regions
+        for (auto br_ : get_intersection(cb.twin_regions, {br})) {
+          for_each_modified_region(blk_data, twin, br_, twin_diff_max_gap, [&](block_region m) {
+            writeback_region(cb, m);
+            written_size += m.size();
+            // The home now has the same data
+            std::memcpy(twin + m.begin, blk_data + m.begin, m.size());
+          });
+        }
+      }
+
+      n_twin_diff_writebacks_++;
+
+    } else {
+      for (auto br : cb.dirty_regions) {
+        writeback_region(cb, br);
+        written_size += br.size();
+      }
     }
 
+    cprof_.record_writeback(cb.dirty_regions.size(), written_size);
+
     cb.dirty_regions.clear();
 
     cb.writeback_epoch = writeback_epoch_;
 
     writing_back_wins_.push_back(cb.win);
+
+    if (node_cache_) {
+      node_cache_written_back_blks_.push_back(cb.addr);
+    }
+  }
+
+  void writeback_region(cache_block& cb, block_region br) {
+    std::byte*  addr      = reinterpret_cast<std::byte*>(vm_.addr()) + cb.entry_idx * BlockSize + br.begin;
+    std::size_t size      = br.size();
+    std::size_t pm_offset = cb.pm_offset + br.begin;
+
+    common::verbose<3>("Writing back [%p, %p) (%ld bytes) to rank %d (win=%p, disp=%ld)",
+                       cb.addr + br.begin, cb.addr + br.end, size,
+                       cb.owner, cb.win, pm_offset);
+
+    common::rma::put_nb(*cache_win_, addr, size, *cb.win, cb.owner, pm_offset);
+  }
+
+  // Keep a pristine copy (twin) of the valid data in `br` so that only modified bytes are written back.
+  // Dirty data that have not been written back are not twinned, as they differ from those in home.
+  void make_twin(cache_block& cb, block_region br) {
+    ITYR_CHECK(enable_twin_diff_);
+    ITYR_CHECK(cb.entry_idx < cs_.num_entries());
+
+    if (!twins_) {
+      // Allocated on first use, as it is as large as the cache
+      twins_ = std::make_unique<std::byte[]>(cache_size_);
+    }
+
+    std::byte* blk_data = reinterpret_cast<std::byte*>(vm_.addr()) + cb.entry_idx * BlockSize;
+    std::byte* twin     = twins_.get() + cb.entry_idx * BlockSize;
+
+    for (auto br_ : cb.twin_regions.inverse(br)) {
+      for (auto br__ : cb.dirty_regions.inverse(br_)) {
+        std::memcpy(twin + br__.begin, blk_data + br__.begin, br__.size());
+        cb.twin_regions.add(br__);
+      }
+    }
   }
 
   void writeback_complete() {
@@ -550,6 +840,14 @@ private:
       }
       writing_back_wins_.clear();
 
+      if (node_cache_) {
+        // Stale copies in the node cache must be invalidated after the new data reached home
+        for (std::byte* blk_addr : node_cache_written_back_blks_) {
+          node_cache_->invalidate(blk_addr);
+        }
+        node_cache_written_back_blks_.clear();
+      }
+
       writeback_epoch_++;
     }
 
@@ -569,6 +867,57 @@ private:
     });
   }
 
+  void print_fetch_granularities() const {
+    // Collective allocations are registered in the same order in all processes
+    std::vector<fetch_granularity_record> records = fetch_granularity_history_;
+    std::vector<const fetch_granularity_entry*> live_entries;
+    for (const auto& [addr, e] : fetch_granularities_) {
+      live_entries.push_back(&e);
+    }
+    std::sort(live_entries.begin(), live_entries.end(),
+              [](const auto* e1, const auto* e2) { return e1->addr < e2->addr; });
+    for (const auto* e : live_entries) {
+      records.push_back({e->addr, e->size, e->granularity.get(), e->granularity.n_records()});
+    }
+
+    std::size_t n = records.size();
+    ITYR_CHECK(n == common::mpi_bcast_value(n, 0, common::topology::mpicomm()));
+
+    std::vector<block_size_t> granularities;
+    std::vector<std::size_t> n_records;
+    for (const auto& r : records) {
+      granularities.push_back(r.granularity);
+      n_records.push_back(r.n_records);
+    }
+    std::vector<block_size_t> min_granularities(n);
+    std::vector<block_size_t> max_granularities(n);
+    std::vector<std::size_t> n_records_all(n);
+    common::mpi_reduce(granularities.data(), min_granularities.data(), n, 0, common::topology::mpicomm(), MPI_MIN);
+    common::mpi_reduce(granularities.data(), max_granularities.data(), n, 0, common::topology::mpicomm(), MPI_MAX);
+    common::mpi_reduce(n_records.data(), n_records_all.data(), n, 0, common::topology::mpicomm());
+
+    bool any_fetched = std::any_of(n_records_all.begin(), n_records_all.end(),
+                                   [](std::size_t c) { return c > 0; });
+
+    if (common::topology::my_rank() == 0 && any_fetched) {
+      printf("[Adaptive fetch granularity]\n");
+      for (std::size_t i = 0; i < n; i++) {
+        // Skip allocations never fetched from remote processes
+        if (n_records_all[i] == 0) continue;
+
+        if (records[i].addr) {
+          printf("  [%p, %p) (%ld bytes): ", records[i].addr,
+                 reinterpret_cast<std::byte*>(records[i].addr) + records[i].size, records[i].size);
+        } else {
+          printf("  Noncollective memory: ");
+        }
+        printf("%u - %u bytes (min - max across processes)\n", min_granularities[i], max_granularities[i]);
+      }
+      printf("\n");
+      fflush(stdout);
+    }
+  }
+
   std::size_t                            cache_size_;
   block_size_t                           sub_block_size_;
 
@@ -601,6 +950,54 @@ private:
   // A release epoch is an interval between the events when all cache become clean.
   release_manager                        rm_;
 
+  using node_seq_t = typename node_cache<BlockSize>::seq_t;
+
+  struct node_cache_publish_entry {
+    std::byte*   blk_addr;
+    block_region br;
+    node_seq_t   seq;
+  };
+
+  // Node-level cache shared by intra-node processes (disabled if null)
+  std::unique_ptr<node_cache<BlockSize>> node_cache_;
+  node_seq_t                             node_acquire_seq_ = 0;
+  std::vector<node_cache_publish_entry>  node_cache_to_publish_;
+  std::vector<std::byte*>                node_cache_written_back_blks_;
+  std::vector<std::byte*>                node_cache_overwritten_blks_;
+
+  struct fetch_granularity_entry {
+    void*                      addr; // null for noncollective memory
+    std::size_t                size;
+    adaptive_fetch_granularity granularity;
+  };
+
+  struct fetch_granularity_record {
+    void*        addr;
+    std::size_t  size;
+    block_size_t granularity;
+    std::size_t  n_records;
+  };
+
+  // Adaptive fetch granularity for each allocation (identified by its address, as collective
+  // allocations may share the same window)
+  bool                                   adaptive_fetch_;
+  std::unordered_map<const void*, fetch_granularity_entry> fetch_granularities_;
+  std::vector<fetch_granularity_record>  fetch_granularity_history_;
+
+  struct twin_request {
+    std::byte*   blk_addr;
+    block_region br;
+  };
+
+  // Pristine copies of cache blocks checked out with the read-write mode, which are compared with
+  // the current data at writeback to put only modified bytes (null until the first twin is made).
+  // Modified regions separated by small gaps are merged into a single put.
+  static constexpr std::size_t           twin_diff_max_gap = 64;
+  bool                                   enable_twin_diff_;
+  std::unique_ptr<std::byte[]>           twins_;
+  std::vector<twin_request>              twins_to_make_;
+  std::size_t                            n_twin_diff_writebacks_ = 0; // for debugging
+
   cache_profiler                         cprof_;
 };
 
@@ -15,6 +15,8 @@ public:
   cache_profiler_disabled(cache_entry_idx_t) {}
   void record(cache_entry_idx_t, block_region, const block_regions&) {}
   void record_writeonly(cache_entry_idx_t, block_region, const block_regions&) {}
+  void record_node_hit(std::size_t) {}
+  void record_writeback(std::size_t, std::size_t) {}
   void invalidate(cache_entry_idx_t, const block_regions&) {}
   void start() {}
   void stop() {}
@@ -86,6 +88,19 @@ public:
     blk.requested_regions.add(requested_region);
   }
 
+  void record_node_hit(std::size_t size) {
+    if (enabled_) {
+      node_hit_bytes_ += size;
+    }
+  }
+
+  void record_writeback(std::size_t dirty_size, std::size_t written_size) {
+    if (enabled_) {
+      dirty_bytes_        += dirty_size;
+      written_back_bytes_ += written_size;
+    }
+  }
+
   void invalidate(cache_entry_idx_t block_idx, const block_regions& valid_regions) {
     ITYR_CHECK(0 <= block_idx);
     ITYR_CHECK(block_idx < n_blocks_);
@@ -105,6 +120,9 @@ public:
     temporal_hit_bytes_   = 0;
     spatial_hit_bytes_    = 0;
     skip_fetch_hit_bytes_ = 0;
+    node_hit_bytes_       = 0;
+    dirty_bytes_          = 0;
+    written_back_bytes_   = 0;
     block_hit_count_      = 0;
     block_miss_count_     = 0;
 
@@ -122,6 +140,9 @@ public:
     auto temporal_hit_bytes_all   = common::mpi_reduce_value(temporal_hit_bytes_  , 0, common::topology::mpicomm());
     auto spatial_hit_bytes_all    = common::mpi_reduce_value(spatial_hit_bytes_   , 0, common::topology::mpicomm());
     auto skip_fetch_hit_bytes_all = common::mpi_reduce_value(skip_fetch_hit_bytes_, 0, common::topology::mpicomm());
+    auto node_hit_bytes_all       = common::mpi_reduce_value(node_hit_bytes_      , 0, common::topology::mpicomm());
+    auto dirty_bytes_all          = common::mpi_reduce_value(dirty_bytes_         , 0, common::topology::mpicomm());
+    auto written_back_bytes_all   = common::mpi_reduce_value(written_back_bytes_  , 0, common::topology::mpicomm());
     auto block_hit_count_all      = common::mpi_reduce_value(block_hit_count_     , 0, common::topology::mpicomm());
     auto block_miss_count_all     = common::mpi_reduce_value(block_miss_count_    , 0, common::topology::mpicomm());
 
@@ -133,6 +154,9 @@ public:
       printf("  Temporal hit:     %18ld bytes\n" , temporal_hit_bytes_all);
       printf("  Spatial hit:      %18ld bytes\n" , spatial_hit_bytes_all);
       printf("  Skip-fetch hit:   %18ld bytes\n" , skip_fetch_hit_bytes_all);
+      printf("  Node cache hit:   %18ld bytes\n" , node_hit_bytes_all);
+      printf("  Dirty:            %18ld bytes\n" , dirty_bytes_all);
+      printf("  Written back:     %18ld bytes\n" , written_back_bytes_all);
       printf("  Hit count:        %18ld blocks\n", block_hit_count_all);
       printf("  Miss count:       %18ld blocks\n", block_miss_count_all);
       printf("\n");
@@ -154,6 +178,9 @@ private:
   std::size_t              temporal_hit_bytes_   = 0; // cache hit for data requested again by the user
   std::size_t              spatial_hit_bytes_    = 0; // cache hit for data not previously requested by the user
   std::size_t              skip_fetch_hit_bytes_ = 0; // cache hit for write-only data (skipping remote fetch)
+  std::size_t              node_hit_bytes_       = 0; // fetched from the node-shared cache instead of remote processes
+  std::size_t              dirty_bytes_          = 0; // dirty when written back
+  std::size_t              written_back_bytes_   = 0; // put to remote processes at writeback (less than dirty with twin/diff)
   std::size_t              block_hit_count_      = 0; // Cache hits counted for each block
   std::size_t              block_miss_count_     = 0; // Cache misses counted for each block
 
@@ -16,6 +16,9 @@ namespace ityr::ori {
 
 using cache_entry_idx_t = int;
 
+// Partition 0 is shared by all keys; other partitions are reserved by `reserve_partition()`
+using cache_partition_t = int;
+
 class cache_full_exception : public std::exception {};
 
 template <typename Key, typename Entry>
@@ -26,20 +29,25 @@ public:
     : nentries_(nentries),
       entry_initial_state_(e),
       entries_(init_entries()),
-      lru_(init_lru()),
+      lrus_(init_lrus()),
       table_(init_table()) {}
 
   cache_entry_idx_t num_entries() const { return nentries_; }
 
+  cache_entry_idx_t num_entries(cache_partition_t p) const {
+    ITYR_CHECK(is_active_partition(p));
+    return lrus_[p].size();
+  }
+
   bool is_cached(Key key) const {
     return table_.find(key) != table_.end();
   }
 
   template <bool UpdateLRU = true>
-  Entry& ensure_cached(Key key) {
+  Entry& ensure_cached(Key key, cache_partition_t p = 0) {
     auto it = table_.find(key);
     if (it == table_.end()) {
-      cache_entry_idx_t idx = get_empty_slot();
+      cache_entry_idx_t idx = get_empty_slot(p);
       cache_entry& ce = entries_[idx];
 
       ce.entry.on_cache_map(idx);
@@ -75,6 +83,68 @@ public:
     }
   }
 
+  // Move `nentries` slots from the shared partition to a new partition, so that entries cached
+  // in the new partition are evicted only by keys of the same partition (and vice versa).
+  // Throws `cache_full_exception` if not enough slots can be evicted from the shared partition.
+  cache_partition_t reserve_partition(cache_entry_idx_t nentries) {
+    ITYR_CHECK(nentries > 0);
+
+    if (static_cast<cache_entry_idx_t>(lrus_[0].size()) <= nentries) {
+      // The shared partition must have at least one entry
+      throw cache_full_exception{};
+    }
+
+    std::vector<cache_entry_idx_t> victims;
+    for (const auto& idx : lrus_[0]) {
+      if (static_cast<cache_entry_idx_t>(victims.size()) == nentries) break;
+      cache_entry& ce = entries_[idx];
+      if (!ce.allocated || ce.entry.is_evictable()) {
+        victims.push_back(idx);
+      }
+    }
+    if (static_cast<cache_entry_idx_t>(victims.size()) < nentries) {
+      throw cache_full_exception{};
+    }
+
+    cache_partition_t p = 1;
+    while (p < static_cast<cache_partition_t>(lrus_.size()) && partition_active_[p]) p++;
+    if (p == static_cast<cache_partition_t>(lrus_.size())) {
+      lrus_.emplace_back();
+      partition_active_.push_back(false);
+    }
+    partition_active_[p] = true;
+
+    for (cache_entry_idx_t idx : victims) {
+      cache_entry& ce = entries_[idx];
+      if (ce.allocated) {
+        evict(ce);
+      }
+      lrus_[p].splice(lrus_[p].end(), lrus_[0], ce.lru_it);
+      ce.partition = p;
+    }
+
+    return p;
+  }
+
+  // Return all slots of partition `p` to the shared partition
+  void release_partition(cache_partition_t p) {
+    ITYR_CHECK(p != 0);
+    ITYR_CHECK(is_active_partition(p));
+
+    for (const auto& idx : lrus_[p]) {
+      cache_entry& ce = entries_[idx];
+      if (ce.allocated) {
+        ITYR_CHECK(ce.entry.is_evictable());
+        evict(ce);
+      }
+      ce.partition = 0;
+    }
+
+    // Empty slots are placed at the front so that they are reused first
+    lrus_[0].splice(lrus_[0].begin(), lrus_[p]);
+    partition_active_[p] = false;
+  }
+
   template <typename Func>
   void for_each_entry(Func&& f) {
     for (auto& ce : entries_) {
@@ -90,6 +160,7 @@ private:
     Key                                             key;
     Entry                                           entry;
     cache_entry_idx_t                               idx = std::numeric_limits<cache_entry_idx_t>::max();
+    cache_partition_t                               partition = 0;
     typename std::list<cache_entry_idx_t>::iterator lru_it;
 
     cache_entry(const Entry& e) : entry(e) {}
@@ -105,14 +176,15 @@ private:
     return entries;
   }
 
-  std::list<cache_entry_idx_t> init_lru() {
-    std::list<cache_entry_idx_t> lru;
+  std::vector<std::list<cache_entry_idx_t>> init_lrus() {
+    std::vector<std::list<cache_entry_idx_t>> lrus(1);
+    std::list<cache_entry_idx_t>& lru = lrus[0];
     for (auto& ce : entries_) {
       lru.push_back(ce.idx);
       ce.lru_it = std::prev(lru.end());
       ITYR_CHECK(*ce.lru_it == ce.idx);
     }
-    return lru;
+    return lrus;
   }
 
   std::unordered_map<Key, cache_entry_idx_t> init_table() {
@@ -122,24 +194,34 @@ private:
     return table;
   }
 
+  bool is_active_partition(cache_partition_t p) const {
+    return 0 <= p && p < static_cast<cache_partition_t>(lrus_.size()) && partition_active_[p];
+  }
+
   void move_to_back_lru(cache_entry& ce) {
-    lru_.splice(lru_.end(), lru_, ce.lru_it);
-    ITYR_CHECK(std::prev(lru_.end()) == ce.lru_it);
+    auto& lru = lrus_[ce.partition];
+    lru.splice(lru.end(), lru, ce.lru_it);
+    ITYR_CHECK(std::prev(lru.end()) == ce.lru_it);
     ITYR_CHECK(*ce.lru_it == ce.idx);
   }
 
-  cache_entry_idx_t get_empty_slot() {
+  void evict(cache_entry& ce) {
+    Key prev_key = ce.key;
+    table_.erase(prev_key);
+    ce.entry.on_evict();
+    ce.allocated = false;
+  }
+
+  cache_entry_idx_t get_empty_slot(cache_partition_t p) {
+    ITYR_CHECK(is_active_partition(p));
     // FIXME: Performance issue?
-    for (const auto& idx : lru_) {
+    for (const auto& idx : lrus_[p]) {
       cache_entry& ce = entries_[idx];
       if (!ce.allocated) {
         return ce.idx;
       }
       if (ce.entry.is_evictable()) {
-        Key prev_key = ce.key;
-        table_.erase(prev_key);
-        ce.entry.on_evict();
-        ce.allocated = false;
+        evict(ce);
         return ce.idx;
       }
     }
@@ -149,7 +231,8 @@ private:
   cache_entry_idx_t                          nentries_;
   Entry                                      entry_initial_state_;
   std::vector<cache_entry>                   entries_; // index (cache_entry_idx_t) -> entry (cache_entry)
-  std::list<cache_entry_idx_t>               lru_; // front (oldest) <----> back (newest)
+  std::vector<std::list<cache_entry_idx_t>>  lrus_; // partition -> LRU list (front (oldest) <----> back (newest))
+  std::vector<bool>                          partition_active_ = {true};
   std::unordered_map<Key, cache_entry_idx_t> table_; // hash table (Key -> cache_entry_idx_t)
 };
 
@@ -248,6 +331,44 @@ ITYR_TEST_CASE("[ityr::ori::cache_system] testing cache system") {
     }
   }
 
+  ITYR_SUBCASE("reserved partitions should not be evicted by other partitions") {
+    int npart = 20;
+    cache_partition_t p = cs.reserve_partition(npart);
+    ITYR_CHECK(p != 0);
+    ITYR_CHECK(cs.num_entries(0) == nelems - npart);
+    ITYR_CHECK(cs.num_entries(p) == npart);
+
+    for (int i = 0; i < npart; i++) {
+      cs.ensure_cached(keys[i], p);
+    }
+    for (int i = npart; i < nkey; i++) {
+      cs.ensure_cached(keys[i]);
+      for (int j = 0; j < npart; j++) {
+        ITYR_CHECK(cs.is_cached(keys[j]));
+      }
+    }
+
+    // LRU eviction within the partition
+    for (int i = 0; i < nkey; i++) {
+      cs.ensure_evicted(keys[i]);
+    }
+    for (int i = 0; i < npart * 2; i++) {
+      cs.ensure_cached(keys[i], p);
+    }
+    for (int i = 0; i < npart; i++) {
+      ITYR_CHECK(!cs.is_cached(keys[i]));
+      ITYR_CHECK(cs.is_cached(keys[npart + i]));
+    }
+
+    cs.release_partition(p);
+    ITYR_CHECK(cs.num_entries(0) == nelems);
+    for (int i = 0; i < npart * 2; i++) {
+      ITYR_CHECK(!cs.is_cached(keys[i]));
+    }
+
+    ITYR_CHECK_THROWS_AS(cs.reserve_partition(nelems), cache_full_exception);
+  }
+
   for (key_t k : keys) {
     cs.ensure_evicted(k);
   }
@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <memory>
+#include <map>
 
 #include "ityr/common/util.hpp"
 #include "ityr/common/mpi_util.hpp"
@@ -10,23 +11,59 @@
 #include "ityr/common/virtual_mem.hpp"
 #include "ityr/common/physical_mem.hpp"
 #include "ityr/ori/mem_mapper.hpp"
+#include "ityr/ori/cache_system.hpp"
 
 namespace ityr::ori {
 
 using coll_mem_id_t = uint64_t;
 
+struct coll_mem_options {
+  // Per-allocation block size (0 for the default). Must be a power of two within
+  // [`min_coll_block_size`, `max_coll_block_size`]. Below the cache block size, it is used as
+  // the fetch granularity of this allocation (instead of the sub-block size); above the cache
+  // block size, it is used as the granularity of home distribution, which is supported only with
+  // the cyclic mapper (`ITYR_ORI_DEFAULT_MEM_MAPPER=cyclic`); otherwise, it is rejected.
+  std::size_t block_size = 0;
+
+  // Size of the cache partition exclusively reserved for this allocation (0 for the shared cache).
+  // Cache blocks of this allocation are never evicted by other allocations and vice versa.
+  std::size_t cache_partition_size = 0;
+
+  // Adaptive home placement. Accesses to each block are counted per process, and at collective
+  // fences, the home of a block persistently dominated by accesses from one remote process is
+  // migrated to that process (see `ITYR_ORI_HOME_MIGRATION_*` options).
+  bool adaptive_home = false;
+};
+
+inline constexpr std::size_t min_coll_block_size = 4096;
+inline constexpr std::size_t max_coll_block_size = std::size_t(16) * 1024 * 1024;
+
 class coll_mem {
 public:
   coll_mem(std::size_t                       size,
            coll_mem_id_t                     id,
-           std::unique_ptr<mem_mapper::base> mmapper)
+           std::unique_ptr<mem_mapper::base> mmapper,
+           block_size_t                      fetch_block_size,
+           cache_partition_t                 cache_partition,
+           std::size_t                       home_spare_size,
+           const common::rma::win*           shared_win = nullptr)
     : size_(size),
       id_(id),
+      fetch_block_size_(fetch_block_size),
+      cache_partition_(cache_partition),
       mmapper_(std::move(mmapper)),
+      home_spare_size_(home_spare_size),
       vm_(common::reserve_same_vm_coll(mmapper_->effective_size(), mmapper_->block_size())),
       intra_home_pms_(init_intra_home_pms()),
       intra_home_vms_(init_intra_home_vms()),
-      win_(common::rma::create_win(reinterpret_cast<std::byte*>(local_home_vm().addr()), local_home_vm().size())) {}
+      win_(shared_win ? nullptr : common::rma::create_win(reinterpret_cast<std::byte*>(local_home_vm().addr()), local_home_vm().size())),
+      shared_win_(shared_win),
+      home_attachment_(attach_local_home()),
+      home_disps_(init_home_disps()) {
+    if (home_spare_size_ > 0) {
+      reset_home_placement();
+    }
+  }
 
   coll_mem(coll_mem&&) = default;
   coll_mem& operator=(coll_mem&&) = default;
@@ -35,9 +72,169 @@ public:
   std::size_t size() const { return size_; }
   std::size_t local_size() const { return local_home_vm().size(); }
   std::size_t effective_size() const { return vm_.size(); }
+  block_size_t fetch_block_size() const { return fetch_block_size_; }
+  cache_partition_t cache_partition() const { return cache_partition_; }
 
   const mem_mapper::base& mem_mapper() const { return *mmapper_; }
 
+  // Returns the current home segment containing `offset`, which reflects migrated homes.
+  // Without migrated homes, it is the same as the segment of the static memory mapper.
+  mem_mapper::segment get_segment(std::size_t offset) const {
+    auto seg = mmapper_->get_segment(offset);
+    if (migrated_homes_.empty()) return seg;
+
+    std::size_t bs = mmapper_->block_size();
+
+    auto it = migrated_homes_.upper_bound(offset);
+    if (it != migrated_homes_.begin()) {
+      auto [blk_offset, home] = *std::prev(it);
+      if (offset < blk_offset + bs) {
+        return mem_mapper::segment{.owner     = home.owner,
+                                   .offset_b  = blk_offset,
+                                   .offset_e  = blk_offset + bs,
+                                   .pm_offset = home.pm_offset};
+      }
+      if (seg.offset_b < blk_offset + bs) {
+        seg.pm_offset += blk_offset + bs - seg.offset_b;
+        seg.offset_b = blk_offset + bs;
+      }
+    }
+    if (it != migrated_homes_.end() && it->first < seg.offset_e) {
+      seg.offset_e = it->first;
+    }
+    return seg;
+  }
+
+  // Home memory size of each process, including the spare region for migrated homes
+  std::size_t home_capacity(common::topology::rank_t rank) const {
+    return mmapper_->local_size(rank) + home_spare_size_;
+  }
+
+  bool adaptive_home() const { return home_spare_size_ > 0; }
+  std::size_t home_spare_size() const { return home_spare_size_; }
+
+  void count_access(const void* addr, std::size_t size) {
+    ITYR_CHECK(adaptive_home());
+    std::size_t bs = mmapper_->block_size();
+    std::size_t offset = reinterpret_cast<const std::byte*>(addr) -
+                         reinterpret_cast<const std::byte*>(vm_.addr());
+    for (std::size_t b = offset / bs; b < (offset + size + bs - 1) / bs; b++) {
+      access_counts_[b]++;
+    }
+  }
+
+  struct home_migration {
+    std::size_t              offset;
+    common::topology::rank_t owner_from;
+    std::size_t              pm_offset_from;
+    common::topology::rank_t owner_to;
+    std::size_t              pm_offset_to;
+  };
+
+  // Decide which blocks to migrate from the access counts of the last epoch (collective).
+  // The dominant process of a block is the one accessing it most (the smallest rank if tied).
+  // A block is migrated if a remote process is dominant with at least `threshold` of all accesses
+  // for `n_epochs` consecutive epochs in which the block is accessed, and has a free spare slot.
+  std::vector<home_migration> plan_home_migration(double threshold, int n_epochs) {
+    ITYR_CHECK(adaptive_home());
+
+    auto my_rank = common::topology::my_rank();
+    auto n_ranks = common::topology::n_ranks();
+    std::size_t n_blks = access_counts_.size();
+
+    std::vector<std::size_t> max_counts(n_blks);
+    std::vector<std::size_t> total_counts(n_blks);
+    common::mpi_allreduce(access_counts_.data(), max_counts.data(), n_blks, common::topology::mpicomm(), MPI_MAX);
+    common::mpi_allreduce(access_counts_.data(), total_counts.data(), n_blks, common::topology::mpicomm(), MPI_SUM);
+
+    std::vector<int> candidates(n_blks);
+    std::vector<int> dominants(n_blks);
+    for (std::size_t b = 0; b < n_blks; b++) {
+      candidates[b] = (max_counts[b] > 0 && access_counts_[b] == max_counts[b]) ? my_rank : n_ranks;
+    }
+    common::mpi_allreduce(candidates.data(), dominants.data(), n_blks, common::topology::mpicomm(), MPI_MIN);
+
+    std::fill(access_counts_.begin(), access_counts_.end(), 0);
+
+    std::size_t bs = mmapper_->block_size();
+
+    std::vector<home_migration> migrations;
+    for (std::size_t b = 0; b < n_blks; b++) {
+      if (total_counts[b] == 0) continue;
+
+      std::size_t offset = b * bs;
+      auto seg = get_segment(offset);
+
+      if (dominants[b] == seg.owner ||
+          max_counts[b] < threshold * total_counts[b]) {
+        remote_epochs_[b] = 0;
+        continue;
+      }
+
+      if (++remote_epochs_[b] < n_epochs) continue;
+
+      common::topology::rank_t owner_to = dominants[b];
+
+      std::size_t pm_offset_to;
+      auto static_seg = mmapper_->get_segment(offset);
+      if (owner_to == static_seg.owner) {
+        pm_offset_to = static_seg.pm_offset + (offset - static_seg.offset_b);
+      } else if (!free_spare_slots_[owner_to].empty()) {
+        pm_offset_to = free_spare_slots_[owner_to].back();
+        free_spare_slots_[owner_to].pop_back();
+      } else {
+        // No spare slot is available now; retry at the next fence
+        continue;
+      }
+
+      migrations.push_back({offset, seg.owner, seg.pm_offset + (offset - seg.offset_b),
+                            owner_to, pm_offset_to});
+      remote_epochs_[b] = 0;
+    }
+
+    return migrations;
+  }
+
+  // Copy the data of migrated blocks to their new homes and update the indirection table
+  // (collective). No process may access the blocks during migration.
+  void migrate_homes(const std::vector<home_migration>& migrations) {
+    auto my_rank = common::topology::my_rank();
+    std::size_t bs = mmapper_->block_size();
+    std::byte* home_addr = reinterpret_cast<std::byte*>(local_home_vm().addr());
+
+    bool fetched = false;
+    for (const auto& m : migrations) {
+      if (m.owner_to == my_rank) {
+        common::rma::get_nb(win(), home_addr + m.pm_offset_to, bs,
+                            win(), m.owner_from, home_disp(m.owner_from) + m.pm_offset_from);
+        fetched = true;
+      }
+    }
+    if (fetched) {
+      common::rma::flush(win());
+    }
+
+    common::mpi_barrier(common::topology::mpicomm());
+
+    // Spare slots of previous homes are reused only after all copies are completed
+    for (const auto& m : migrations) {
+      auto static_seg = mmapper_->get_segment(m.offset);
+      if (m.owner_from != static_seg.owner) {
+        free_spare_slots_[m.owner_from].push_back(m.pm_offset_from);
+      }
+      if (m.owner_to == static_seg.owner) {
+        migrated_homes_.erase(m.offset);
+      } else {
+        migrated_homes_[m.offset] = migrated_home{m.owner_to, m.pm_offset_to};
+      }
+
+      common::verbose<2>("Migrate home of [%p, %p) from rank %d to rank %d",
+                         reinterpret_cast<std::byte*>(vm_.addr()) + m.offset,
+                         reinterpret_cast<std::byte*>(vm_.addr()) + m.offset + bs,
+                         m.owner_from, m.owner_to);
+    }
+  }
+
   const common::virtual_mem& vm() const { return vm_; }
 
   const common::physical_mem& local_home_pm() const {
@@ -58,7 +255,25 @@ public:
     return intra_home_vms_[intra_rank];
   }
 
-  const common::rma::win& win() const { return *win_; }
+  const common::rma::win& win() const { return shared_win_ ? *shared_win_ : *win_; }
+
+  // Displacement of the beginning of the home memory of `owner` in `win()`.
+  // It is nonzero only if the home memory is attached to a window shared by all allocations.
+  std::size_t home_disp(common::topology::rank_t owner) const {
+    return shared_win_ ? home_disps_[owner] : 0;
+  }
+
+  // Reuse the memory region, the home memory, and the RMA window for another allocation
+  // whose memory mapping is compatible (see `mem_mapper::base::can_reuse_for()`)
+  void reuse(std::size_t size, block_size_t fetch_block_size, cache_partition_t cache_partition) {
+    ITYR_CHECK(size <= vm_.size());
+    size_             = size;
+    fetch_block_size_ = fetch_block_size;
+    cache_partition_  = cache_partition;
+    if (adaptive_home()) {
+      reset_home_placement();
+    }
+  }
 
 private:
   static std::string home_shmem_name(coll_mem_id_t id, int global_rank) {
@@ -69,7 +284,7 @@ private:
 
   std::vector<common::physical_mem> init_intra_home_pms() const {
     common::physical_mem pm_local(home_shmem_name(id_, common::topology::my_rank()),
-                                  mmapper_->local_size(common::topology::my_rank()),
+                                  home_capacity(common::topology::my_rank()),
                                   true);
 
     common::mpi_barrier(common::topology::intra_mpicomm());
@@ -81,8 +296,7 @@ private:
         home_pms[i] = std::move(pm_local);
       } else {
         int target_rank = common::topology::intra2global_rank(i);
-        int target_local_size = mmapper_->local_size(target_rank);
-        common::physical_mem pm(home_shmem_name(id_, target_rank), target_local_size, false);
+        common::physical_mem pm(home_shmem_name(id_, target_rank), home_capacity(target_rank), false);
         home_pms[i] = std::move(pm);
       }
     }
@@ -101,13 +315,68 @@ private:
     return home_vms;
   }
 
-  std::size_t                        size_;
-  coll_mem_id_t                      id_;
-  std::unique_ptr<mem_mapper::base>  mmapper_;
-  common::virtual_mem                vm_;
-  std::vector<common::physical_mem>  intra_home_pms_; // intra-rank -> pm
-  std::vector<common::virtual_mem>   intra_home_vms_; // intra-rank -> vm
-  std::unique_ptr<common::rma::win>  win_;
+  struct home_detacher {
+    const common::rma::win* win;
+    void operator()(void* addr) const { common::rma::detach(*win, addr); }
+  };
+
+  std::unique_ptr<void, home_detacher> attach_local_home() const {
+    if (!shared_win_ || local_home_vm().size() == 0) {
+      return {nullptr, home_detacher{shared_win_}};
+    }
+    common::rma::attach(*shared_win_, local_home_vm().addr(), local_home_vm().size());
+    return {local_home_vm().addr(), home_detacher{shared_win_}};
+  }
+
+  std::vector<std::size_t> init_home_disps() const {
+    if (!shared_win_) return {};
+    // Displacements in dynamic windows are the absolute addresses in the target process
+    std::size_t my_disp = reinterpret_cast<std::size_t>(local_home_vm().addr());
+    std::vector<std::size_t> disps(common::topology::n_ranks());
+    common::mpi_allgather(&my_disp, disps.data(), 1, common::topology::mpicomm());
+    return disps;
+  }
+
+  void reset_home_placement() {
+    std::size_t bs = mmapper_->block_size();
+    std::size_t n_blks = vm_.size() / bs;
+
+    migrated_homes_.clear();
+    access_counts_.assign(n_blks, 0);
+    remote_epochs_.assign(n_blks, 0);
+
+    free_spare_slots_.resize(common::topology::n_ranks());
+    for (common::topology::rank_t r = 0; r < common::topology::n_ranks(); r++) {
+      free_spare_slots_[r].clear();
+      std::size_t local_size = mmapper_->local_size(r);
+      for (std::size_t o = home_spare_size_; o >= bs; o -= bs) {
+        free_spare_slots_[r].push_back(local_size + o - bs);
+      }
+    }
+  }
+
+  struct migrated_home {
+    common::topology::rank_t owner;
+    std::size_t              pm_offset;
+  };
+
+  std::size_t                           size_;
+  coll_mem_id_t                         id_;
+  block_size_t                          fetch_block_size_;
+  cache_partition_t                     cache_partition_;
+  std::unique_ptr<mem_mapper::base>     mmapper_;
+  std::size_t                           home_spare_size_; // per-process home memory for migrated blocks
+  std::map<std::size_t, migrated_home>  migrated_homes_; // block offset -> current home (only for migrated blocks)
+  std::vector<std::size_t>              access_counts_; // block -> # of accesses by this process in the current epoch
+  std::vector<int>                      remote_epochs_; // block -> # of consecutive epochs dominated by a remote process
+  std::vector<std::vector<std::size_t>> free_spare_slots_; // global rank -> free pm offsets in the spare region
+  common::virtual_mem                   vm_;
+  std::vector<common::physical_mem>     intra_home_pms_; // intra-rank -> pm
+  std::vector<common::virtual_mem>      intra_home_vms_; // intra-rank -> vm
+  std::unique_ptr<common::rma::win>     win_;
+  const common::rma::win*               shared_win_;
+  std::unique_ptr<void, home_detacher>  home_attachment_;
+  std::vector<std::size_t>              home_disps_; // global rank -> displacement in `shared_win_`
 };
 
 template <typename Fn>
@@ -122,7 +391,7 @@ void for_each_mem_segment(const coll_mem& cm, const void* addr, std::size_t size
 
   std::size_t offset = offset_b;
   while (offset < offset_e) {
-    auto seg = cm.mem_mapper().get_segment(offset);
+    auto seg = cm.get_segment(offset);
     fn(seg);
     offset = seg.offset_e;
   }
@@ -1,7 +1,9 @@
 #pragma once
 
 #include "ityr/common/util.hpp"
+#include "ityr/common/logger.hpp"
 #include "ityr/ori/util.hpp"
+#include "ityr/ori/options.hpp"
 #include "ityr/ori/mem_mapper.hpp"
 #include "ityr/ori/coll_mem.hpp"
 
@@ -9,7 +11,9 @@ namespace ityr::ori {
 
 class coll_mem_manager {
 public:
-  coll_mem_manager() {}
+  coll_mem_manager()
+    : shared_win_(init_shared_win()),
+      pool_max_size_(coll_mem_pool_size_option::value()) {}
 
   coll_mem& get(void* addr) {
     for (auto [addr_begin, addr_end, id] : coll_mem_ids_) {
@@ -20,30 +24,136 @@ public:
     common::die("Address %p was passed but not allocated by Itoyori", addr);
   }
 
-  coll_mem& create(std::size_t size, std::unique_ptr<mem_mapper::base> mmapper) {
-    coll_mem_id_t id = coll_mems_.size();
+  // Allocations with adaptive home placement are searched separately, as they are usually few and
+  // looked up at every checkout for access counting. Returns nullptr if `addr` is not in any of them.
+  coll_mem* find_adaptive_home(void* addr) {
+    for (auto [addr_begin, addr_end, id] : adaptive_home_ids_) {
+      if (addr_begin <= addr && addr < addr_end) {
+        return &*coll_mems_[id];
+      }
+    }
+    return nullptr;
+  }
 
-    coll_mem& cm = *coll_mems_.emplace_back(std::in_place, size, id, std::move(mmapper));
-    std::byte* raw_ptr = reinterpret_cast<std::byte*>(cm.vm().addr());
+  bool has_adaptive_home() const { return !adaptive_home_ids_.empty(); }
 
-    coll_mem_ids_.emplace_back(std::make_tuple(raw_ptr, raw_ptr + size, id));
+  coll_mem& create(std::size_t                       size,
+                   std::unique_ptr<mem_mapper::base> mmapper,
+                   block_size_t                      fetch_block_size,
+                   cache_partition_t                 cache_partition = 0,
+                   std::size_t                       home_spare_size = 0) {
+    if (auto cm_p = reuse_pooled(size, *mmapper, fetch_block_size, cache_partition, home_spare_size)) {
+      add_ids(*cm_p);
+      return *cm_p;
+    }
+
+    coll_mem_id_t id = coll_mems_.size();
+
+    coll_mem& cm = *coll_mems_.emplace_back(std::in_place, size, id, std::move(mmapper),
+                                            fetch_block_size, cache_partition, home_spare_size,
+                                            shared_win_.get());
+    add_ids(cm);
 
     return cm;
   }
 
   void destroy(coll_mem& cm) {
-    std::byte* p = reinterpret_cast<std::byte*>(cm.vm().addr());
-    auto it = std::find(coll_mem_ids_.begin(), coll_mem_ids_.end(),
-                        std::make_tuple(p, p + cm.size(), cm.id()));
-    ITYR_CHECK(it != coll_mem_ids_.end());
-    coll_mem_ids_.erase(it);
+    remove_ids(coll_mem_ids_, cm);
+    if (cm.adaptive_home()) {
+      remove_ids(adaptive_home_ids_, cm);
+    }
+
+    // As collective allocation and deallocation are called in the same order on all processes,
+    // the pooling decision is consistent among processes
+    if (pool_size_ + cm.effective_size() <= pool_max_size_) {
+      // Freeing the RMA window would synchronize all processes; a pooled region must also not be
+      // reused before the other processes finish accessing it
+      common::mpi_barrier(common::topology::mpicomm());
+      pool_.push_back(cm.id());
+      pool_size_ += cm.effective_size();
+      return;
+    }
 
     coll_mems_[cm.id()].reset();
   }
 
+  std::size_t pool_size() const { return pool_size_; }
+
+  template <typename Fn>
+  void for_each_alloc(Fn fn) {
+    for (auto [addr_begin, addr_end, id] : coll_mem_ids_) {
+      fn(*coll_mems_[id]);
+    }
+  }
+
 private:
+  using ids_t = std::vector<std::tuple<void*, void*, coll_mem_id_t>>;
+
+  void add_ids(const coll_mem& cm) {
+    std::byte* p = reinterpret_cast<std::byte*>(cm.vm().addr());
+    coll_mem_ids_.emplace_back(std::make_tuple(p, p + cm.size(), cm.id()));
+    if (cm.adaptive_home()) {
+      adaptive_home_ids_.emplace_back(std::make_tuple(p, p + cm.size(), cm.id()));
+    }
+  }
+
+  static void remove_ids(ids_t& ids, const coll_mem& cm) {
+    std::byte* p = reinterpret_cast<std::byte*>(cm.vm().addr());
+    auto it = std::find(ids.begin(), ids.end(), std::make_tuple(p, p + cm.size(), cm.id()));
+    ITYR_CHECK(it != ids.end());
+    ids.erase(it);
+  }
+
+  // If ITYR_ORI_COLL_MEM_SINGLE_WIN is enabled, the home memory of all collective allocations is
+  // attached to a single dynamic window, so that cache blocks of different allocations can be
+  // fetched and written back with one flush per fence (instead of one flush per allocation).
+  std::unique_ptr<common::rma::win> init_shared_win() const {
+    if (!coll_mem_single_win_option::value()) {
+      return nullptr;
+    }
+    if constexpr (!common::rma::support_dynamic_win) {
+      common::verbose("ITYR_ORI_COLL_MEM_SINGLE_WIN is ignored because the RMA layer does not support dynamic windows");
+      return nullptr;
+    } else {
+      return common::rma::create_win_dynamic();
+    }
+  }
+
+  // Freed collective memory regions are kept alive (with their home memory and RMA windows) in the
+  // pool, up to `ITYR_ORI_COLL_MEM_POOL_SIZE` bytes in total. A pooled region is reused for a new
+  // allocation with a compatible memory mapping and at most twice as large as needed.
+  coll_mem* reuse_pooled(std::size_t             size,
+                         const mem_mapper::base& mmapper,
+                         block_size_t            fetch_block_size,
+                         cache_partition_t       cache_partition,
+                         std::size_t             home_spare_size) {
+    // Prefer the most recently freed region
+    for (auto it = pool_.rbegin(); it != pool_.rend(); it++) {
+      coll_mem& cm = *coll_mems_[*it];
+      if (cm.mem_mapper().can_reuse_for(mmapper) &&
+          cm.effective_size() <= 2 * mmapper.effective_size() &&
+          cm.home_spare_size() == home_spare_size) {
+        pool_.erase(std::next(it).base());
+        pool_size_ -= cm.effective_size();
+
+        cm.reuse(size, fetch_block_size, cache_partition);
+
+        common::verbose<2>("Reuse pooled collective memory [%p, %p) (%ld bytes)",
+                           cm.vm().addr(), reinterpret_cast<std::byte*>(cm.vm().addr()) + size, size);
+
+        return &cm;
+      }
+    }
+    return nullptr;
+  }
+
+  std::unique_ptr<common::rma::win>                    shared_win_;
   std::vector<std::optional<coll_mem>>                 coll_mems_;
-  std::vector<std::tuple<void*, void*, coll_mem_id_t>> coll_mem_ids_;
+  ids_t                                                coll_mem_ids_;
+  ids_t                                                adaptive_home_ids_;
+  std::size_t                                          pool_max_size_;
+  std::size_t                                          pool_size_ = 0;
+  std::vector<coll_mem_id_t>                           pool_;
 };
 
 }
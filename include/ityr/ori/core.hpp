@@ -17,6 +17,7 @@
 #include "ityr/ori/noncoll_mem.hpp"
 #include "ityr/ori/home_manager.hpp"
 #include "ityr/ori/cache_manager.hpp"
+#include "ityr/ori/access_trace.hpp"
 
 namespace ityr::ori::core {
 
@@ -51,8 +52,8 @@ void for_each_seg_blk(const coll_mem& cm, void* addr, std::size_t size,
                                                              std::byte* req_addr_b,
                                                              std::byte* req_addr_e) {
         std::size_t pm_offset = seg.pm_offset + (blk_addr - seg_addr);
-        ITYR_CHECK(pm_offset + BlockSize <= cm.mem_mapper().local_size(seg.owner));
-        cache_blk_fn(blk_addr, req_addr_b, req_addr_e, seg.owner, pm_offset);
+        ITYR_CHECK(pm_offset + BlockSize <= cm.home_capacity(seg.owner));
+        cache_blk_fn(blk_addr, req_addr_b, req_addr_e, seg.owner, cm.home_disp(seg.owner) + pm_offset);
       });
     }
   });
@@ -61,12 +62,19 @@ void for_each_seg_blk(const coll_mem& cm, void* addr, std::size_t size,
 template <block_size_t BlockSize>
 class core_default {
   static constexpr bool enable_vm_map = ITYR_ORI_ENABLE_VM_MAP;
+  static constexpr bool enable_access_trace = std::is_same_v<access_tracer, access_tracer_enabled>;
 
 public:
   core_default(std::size_t cache_size, std::size_t sub_block_size)
-    : noncoll_mem_(noncoll_allocator_size_option::value()),
+    : noncoll_mem_(noncoll_allocator_size_option::value(),
+                   noncoll_allocator_max_size_option::value()),
       home_manager_(calc_home_mmap_limit(cache_size / BlockSize)),
-      cache_manager_(cache_size, sub_block_size) {}
+      cache_manager_(cache_size, sub_block_size),
+      bulk_getput_threshold_(calc_bulk_getput_threshold(cache_size)),
+      bulk_getput_chunk_size_(bulk_getput_chunk_size_option::value()),
+      tracer_(BlockSize) {
+    cache_manager_.add_alloc(nullptr, 0, cache_manager_.sub_block_size());
+  }
 
   static constexpr block_size_t block_size = BlockSize;
 
@@ -80,13 +88,47 @@ public:
 
     auto mmapper = std::make_unique<MemMapper<BlockSize>>(size, common::topology::n_ranks(),
                                                           std::forward<MemMapperArgs>(mmargs)...);
-    coll_mem& cm = cm_manager_.create(size, std::move(mmapper));
-    void* addr = cm.vm().addr();
+    return malloc_coll_impl(size, std::move(mmapper), cache_manager_.sub_block_size(), 0);
+  }
 
-    common::verbose("Allocate collective memory [%p, %p) (%ld bytes) (win=%p)",
-                    addr, reinterpret_cast<std::byte*>(addr) + size, size, &cm.win());
+  void* malloc_coll(std::size_t size, const coll_mem_options& opts) {
+    ITYR_REQUIRE_MESSAGE(size > 0, "Memory allocation size cannot be 0");
+    ITYR_REQUIRE_MESSAGE(size == common::mpi_bcast_value(size, 0, common::topology::mpicomm()),
+                         "The size passed to malloc_coll() is different among workers");
+    ITYR_REQUIRE_MESSAGE(opts.block_size == 0 ||
+                         (common::is_pow2(opts.block_size) &&
+                          min_coll_block_size <= opts.block_size &&
+                          opts.block_size <= max_coll_block_size),
+                         "The block size passed to malloc_coll() must be a power of two within [%ld, %ld]",
+                         min_coll_block_size, max_coll_block_size);
+
+    std::unique_ptr<mem_mapper::base> mmapper;
+    if constexpr (std::is_same_v<default_mem_mapper<BlockSize>, mem_mapper::cyclic<BlockSize>>) {
+      // Larger blocks are distributed as contiguous segments; the block mappers already assign
+      // large contiguous regions to each process
+      std::size_t seg_size = std::max(opts.block_size, std::size_t(BlockSize));
+      mmapper = std::make_unique<mem_mapper::cyclic<BlockSize>>(size, common::topology::n_ranks(), seg_size);
+    } else {
+      ITYR_REQUIRE_MESSAGE(opts.block_size <= BlockSize,
+                           "The block size passed to malloc_coll() cannot be larger than the cache block size (%ld) "
+                           "unless ITYR_ORI_DEFAULT_MEM_MAPPER=cyclic", BlockSize);
+      mmapper = std::make_unique<default_mem_mapper<BlockSize>>(size, common::topology::n_ranks());
+    }
 
-    return addr;
+    block_size_t fetch_block_size = opts.block_size == 0 ? cache_manager_.sub_block_size() :
+                                    std::min(opts.block_size, std::size_t(BlockSize));
+
+    cache_partition_t partition = 0;
+    if (opts.cache_partition_size > 0) {
+      partition = cache_manager_.reserve_partition(opts.cache_partition_size);
+    }
+
+    std::size_t home_spare_size = 0;
+    if (opts.adaptive_home) {
+      home_spare_size = common::round_down_pow2(home_migration_capacity_option::value(), std::size_t(BlockSize));
+    }
+
+    return malloc_coll_impl(size, std::move(mmapper), fetch_block_size, partition, home_spare_size);
   }
 
   void* malloc(std::size_t size) {
@@ -118,6 +160,14 @@ public:
       cache_manager_.ensure_evicted(addr);
     }
 
+    if (cm.cache_partition() != 0) {
+      cache_manager_.release_partition(cm.cache_partition());
+    }
+
+    cache_manager_.remove_alloc(addr);
+
+    tracer_.record(access_trace_event::free_coll, addr, cm.size());
+
     common::verbose("Deallocate collective memory [%p, %p) (%ld bytes) (win=%p)",
                     addr, reinterpret_cast<std::byte*>(addr) + cm.size(), cm.size(), &cm.win());
 
@@ -157,7 +207,13 @@ public:
 
     std::byte* from_addr_ = reinterpret_cast<std::byte*>(const_cast<void*>(from_addr));
 
-    // TODO: support get/put for data larger than the cache size
+    trace_access(access_trace_event::get, from_addr_, size, mode::read);
+
+    if (size >= bulk_getput_threshold_) {
+      get_bulk(from_addr_, reinterpret_cast<std::byte*>(to_addr), size);
+      return;
+    }
+
     if (common::round_down_pow2(from_addr_, BlockSize) ==
         common::round_down_pow2(from_addr_ + size, BlockSize)) {
       // if the size is sufficiently small, it is safe to skip incrementing reference count for cache blocks
@@ -177,6 +233,13 @@ public:
 
     std::byte* to_addr_ = reinterpret_cast<std::byte*>(to_addr);
 
+    trace_access(access_trace_event::put, to_addr_, size, mode::write);
+
+    if (size >= bulk_getput_threshold_) {
+      put_bulk(reinterpret_cast<const std::byte*>(from_addr), to_addr_, size);
+      return;
+    }
+
     if (common::round_down_pow2(to_addr_, BlockSize) ==
         common::round_down_pow2(to_addr_ + size, BlockSize)) {
       // if the size is sufficiently small, it is safe to skip incrementing reference count for cache blocks
@@ -205,6 +268,8 @@ public:
     ITYR_CHECK(addr);
     ITYR_CHECK(size > 0);
 
+    trace_access(access_trace_event::checkout, addr, size, Mode{});
+
     checkout_impl_nb<Mode, true>(reinterpret_cast<std::byte*>(addr), size);
   }
 
@@ -232,12 +297,16 @@ public:
     ITYR_CHECK(addr);
     ITYR_CHECK(size > 0);
 
+    trace_access(access_trace_event::checkin, addr, size, Mode{});
+
     checkin_impl<Mode, true>(reinterpret_cast<std::byte*>(addr), size);
   }
 
   void release() {
     common::verbose("Release fence begin");
 
+    tracer_.record(access_trace_event::release, nullptr, 0);
+
     cache_manager_.release();
 
     common::verbose("Release fence end");
@@ -248,12 +317,16 @@ public:
   release_handler release_lazy() {
     common::verbose<2>("Lazy release handler is created");
 
+    tracer_.record(access_trace_event::release, nullptr, 0);
+
     return cache_manager_.release_lazy();
   }
 
   void acquire() {
     common::verbose("Acquire fence begin");
 
+    tracer_.record(access_trace_event::acquire, nullptr, 0);
+
     cache_manager_.acquire();
 
     common::verbose("Acquire fence end");
@@ -262,6 +335,8 @@ public:
   void acquire(release_handler rh) {
     common::verbose("Acquire fence (lazy) begin");
 
+    tracer_.record(access_trace_event::acquire, nullptr, 0);
+
     cache_manager_.acquire(rh);
 
     common::verbose("Acquire fence (lazy) end");
@@ -271,6 +346,80 @@ public:
     cache_manager_.poll();
   }
 
+  // Collective. Migrate homes of collective memory blocks with adaptive home placement, according
+  // to the accesses counted since the last call. It must be called when no memory is checked out.
+  void migrate_homes() {
+    if (!cm_manager_.has_adaptive_home()) return;
+
+    cache_manager_.ensure_all_cache_clean();
+
+    cm_manager_.for_each_alloc([&](coll_mem& cm) {
+      if (!cm.adaptive_home()) return;
+
+      auto migrations = cm.plan_home_migration(home_migration_threshold_option::value(),
+                                               home_migration_epochs_option::value());
+      if (migrations.empty()) return;
+
+      // Home mappings and cache blocks may refer to the previous homes
+      for (std::size_t o = 0; o < cm.effective_size(); o += BlockSize) {
+        std::byte* addr = reinterpret_cast<std::byte*>(cm.vm().addr()) + o;
+        home_manager_.ensure_evicted(addr);
+        cache_manager_.ensure_evicted(addr);
+      }
+
+      cm.migrate_homes(migrations);
+
+      common::verbose("Migrated homes of %ld blocks in collective memory [%p, %p)",
+                      migrations.size(), cm.vm().addr(),
+                      reinterpret_cast<std::byte*>(cm.vm().addr()) + cm.size());
+    });
+  }
+
+  // Atomic operations on noncollective memory, which bypass the cache.
+  // Memory accessed by atomic operations must not be accessed by other operations (e.g., get/put).
+  template <typename T>
+  T atomic_get(const T* addr) {
+    ITYR_CHECK(noncoll_mem_.has(addr));
+    T result;
+    common::rma::atomic_get_nb(&result, noncoll_mem_.win(), noncoll_mem_.get_owner(addr),
+                               noncoll_mem_.get_disp(addr));
+    common::rma::flush(noncoll_mem_.win());
+    return result;
+  }
+
+  template <typename T>
+  T atomic_put(T value, T* addr) {
+    ITYR_CHECK(noncoll_mem_.has(addr));
+    T result;
+    common::rma::atomic_put_nb(&value, &result, noncoll_mem_.win(), noncoll_mem_.get_owner(addr),
+                               noncoll_mem_.get_disp(addr));
+    common::rma::flush(noncoll_mem_.win());
+    return result;
+  }
+
+  template <typename T>
+  T atomic_cas(T value, T compare, T* addr) {
+    ITYR_CHECK(noncoll_mem_.has(addr));
+    T result;
+    common::rma::atomic_cas_nb(&value, &compare, &result, noncoll_mem_.win(), noncoll_mem_.get_owner(addr),
+                               noncoll_mem_.get_disp(addr));
+    common::rma::flush(noncoll_mem_.win());
+    return result;
+  }
+
+  std::size_t cache_size() const { return cache_manager_.cache_size(); }
+
+  common::topology::rank_t get_owner(void* addr) {
+    if (noncoll_mem_.has(addr)) {
+      return noncoll_mem_.get_owner(addr);
+    } else {
+      coll_mem& cm = cm_manager_.get(addr);
+      std::size_t offset = reinterpret_cast<std::byte*>(addr) -
+                           reinterpret_cast<std::byte*>(cm.vm().addr());
+      return cm.get_segment(offset).owner;
+    }
+  }
+
   void collect_deallocated() {
     noncoll_mem_.collect_deallocated();
   }
@@ -278,9 +427,11 @@ public:
   void cache_prof_begin() {
     home_manager_.home_prof_begin();
     cache_manager_.cache_prof_begin();
+    tracer_.start();
   }
 
   void cache_prof_end() {
+    tracer_.stop();
     home_manager_.home_prof_end();
     cache_manager_.cache_prof_end();
   }
@@ -297,6 +448,10 @@ public:
     return cm.local_home_vm().addr();
   }
 
+  std::size_t n_twin_diff_writebacks() const {
+    return cache_manager_.n_twin_diff_writebacks();
+  }
+
 private:
   std::size_t calc_home_mmap_limit(std::size_t n_cache_blocks) const {
     std::size_t sys_limit = sys_mmap_entry_limit();
@@ -309,27 +464,75 @@ private:
     return std::min(max_val, candidate);
   }
 
+  void* malloc_coll_impl(std::size_t                       size,
+                         std::unique_ptr<mem_mapper::base> mmapper,
+                         block_size_t                      fetch_block_size,
+                         cache_partition_t                 cache_partition,
+                         std::size_t                       home_spare_size = 0) {
+    coll_mem& cm = cm_manager_.create(size, std::move(mmapper), fetch_block_size, cache_partition,
+                                      home_spare_size);
+    void* addr = cm.vm().addr();
+
+    cache_manager_.add_alloc(addr, size, fetch_block_size);
+
+    tracer_.record(access_trace_event::alloc_coll, addr, size);
+
+    common::verbose("Allocate collective memory [%p, %p) (%ld bytes) (win=%p)",
+                    addr, reinterpret_cast<std::byte*>(addr) + size, size, &cm.win());
+
+    return addr;
+  }
+
+  std::size_t calc_bulk_getput_threshold(std::size_t cache_size) const {
+    if constexpr (!common::rma::instance::instance_type::support_unregistered_origin) {
+      // Bulk transfers issue RMA from user buffers
+      return std::numeric_limits<std::size_t>::max();
+    } else {
+      // Transfers that would occupy more than half of the cache always bypass it
+      return std::min(bulk_getput_threshold_option::value(), cache_size / 2);
+    }
+  }
+
+  template <typename Mode>
+  void trace_access(access_trace_event event, void* addr, std::size_t size, Mode) {
+    if constexpr (enable_access_trace) {
+      // The owner of collective memory is not recorded, as it depends on the memory mapper
+      int owner = noncoll_mem_.has(addr) ? noncoll_mem_.get_owner(addr) : -1;
+      tracer_.record(event, addr, size, to_access_trace_mode(Mode{}), owner);
+    }
+  }
+
   template <typename Mode, bool IncrementRef>
   void checkout_impl_nb(std::byte* addr, std::size_t size) {
     constexpr bool skip_fetch = std::is_same_v<Mode, mode::write_t>;
+    constexpr bool make_twin  = std::is_same_v<Mode, mode::read_write_t>;
     if (noncoll_mem_.has(addr)) {
-      checkout_noncoll_nb<skip_fetch, IncrementRef>(addr, size);
+      checkout_noncoll_nb<skip_fetch, IncrementRef, make_twin>(addr, size);
     } else {
-      checkout_coll_nb<skip_fetch, IncrementRef>(addr, size);
+      checkout_coll_nb<skip_fetch, IncrementRef, make_twin>(addr, size);
     }
   }
 
-  template <bool SkipFetch, bool IncrementRef>
+  template <bool SkipFetch, bool IncrementRef, bool MakeTwin>
   void checkout_coll_nb(std::byte* addr, std::size_t size) {
+    coll_mem* cm_p = nullptr;
+    if (cm_manager_.has_adaptive_home()) {
+      // Accesses are counted before the fast paths so that home and cached accesses are equally counted
+      cm_p = cm_manager_.find_adaptive_home(addr);
+      if (cm_p) {
+        cm_p->count_access(addr, size);
+      }
+    }
+
     if (home_manager_.template checkout_fast<IncrementRef>(addr, size)) {
       return;
     }
 
-    if (cache_manager_.template checkout_fast<SkipFetch, IncrementRef>(addr, size)) {
+    if (cache_manager_.template checkout_fast<SkipFetch, IncrementRef, MakeTwin>(addr, size)) {
       return;
     }
 
-    coll_mem& cm = cm_manager_.get(addr);
+    coll_mem& cm = cm_p ? *cm_p : cm_manager_.get(addr);
 
     for_each_seg_blk<BlockSize>(cm, addr, size,
       // home segment
@@ -341,13 +544,14 @@ private:
       // cache block
       [&](std::byte* blk_addr, std::byte* req_addr_b, std::byte* req_addr_e,
           common::topology::rank_t owner, std::size_t pm_offset) {
-        cache_manager_.template checkout_blk<SkipFetch, IncrementRef>(
+        cache_manager_.template checkout_blk<SkipFetch, IncrementRef, MakeTwin>(
             blk_addr, req_addr_b, req_addr_e,
-            cm.win(), owner, pm_offset);
+            cm.win(), owner, pm_offset, cm.vm().addr(),
+            cm.fetch_block_size(), cm.cache_partition());
       });
   }
 
-  template <bool SkipFetch, bool IncrementRef>
+  template <bool SkipFetch, bool IncrementRef, bool MakeTwin>
   void checkout_noncoll_nb(std::byte* addr, std::size_t size) {
     ITYR_CHECK(noncoll_mem_.has(addr));
 
@@ -362,18 +566,20 @@ private:
       return;
     }
 
-    if (cache_manager_.template checkout_fast<SkipFetch, IncrementRef>(addr, size)) {
+    if (cache_manager_.template checkout_fast<SkipFetch, IncrementRef, MakeTwin>(addr, size)) {
       return;
     }
 
     for_each_block<BlockSize>(addr, size, [&](std::byte* blk_addr,
                                               std::byte* req_addr_b,
                                               std::byte* req_addr_e) {
-      cache_manager_.template checkout_blk<SkipFetch, IncrementRef>(
+      cache_manager_.template checkout_blk<SkipFetch, IncrementRef, MakeTwin>(
           blk_addr, req_addr_b, req_addr_e,
           noncoll_mem_.win(),
           target_rank,
-          noncoll_mem_.get_disp(blk_addr));
+          noncoll_mem_.get_disp(blk_addr),
+          nullptr,
+          cache_manager_.sub_block_size());
     });
   }
 
@@ -558,6 +764,180 @@ private:
     });
   }
 
+  /*
+   * Bulk get/put functions transfer data directly between the user buffer and home memory
+   * without going through the cache, so that large transfers neither evict other cache blocks
+   * nor are limited by the cache capacity. RMA operations are issued for each block and
+   * completed every `bulk_getput_chunk_size_` bytes to bound the amount of in-flight data.
+   * Cached copies of the transferred region are kept coherent with this process's own view:
+   * dirty data are written back before a bulk get, and cached copies are patched by a bulk put.
+   */
+
+  void get_bulk(std::byte* from_addr, std::byte* to_addr, std::size_t size) {
+    if (noncoll_mem_.has(from_addr)) {
+      get_bulk_noncoll(from_addr, to_addr, size);
+    } else {
+      get_bulk_coll(from_addr, to_addr, size);
+    }
+  }
+
+  void get_bulk_coll(std::byte* from_addr, std::byte* to_addr, std::size_t size) {
+    coll_mem& cm = cm_manager_.get(from_addr);
+
+    for_each_seg_blk<BlockSize>(cm, from_addr, size,
+      // home segment
+      [&](std::byte*, std::size_t, common::topology::rank_t, std::size_t) {},
+      // cache block
+      [&](std::byte* blk_addr, std::byte* req_addr_b, std::byte* req_addr_e,
+          common::topology::rank_t, std::size_t) {
+        cache_manager_.writeback_region_begin(blk_addr, req_addr_b, req_addr_e);
+      });
+
+    cache_manager_.writeback_region_complete();
+
+    std::size_t outstanding_bytes = 0;
+
+    for_each_seg_blk<BlockSize>(cm, from_addr, size,
+      // home segment
+      [&](std::byte* seg_addr, std::size_t seg_size, common::topology::rank_t owner, std::size_t pm_offset) {
+        const common::virtual_mem& vm = cm.intra_home_vm(common::topology::intra_rank(owner));
+        std::byte* seg_addr_b         = std::max(from_addr, seg_addr);
+        std::byte* seg_addr_e         = std::min(seg_addr + seg_size, from_addr + size);
+        std::size_t seg_offset        = seg_addr_b - seg_addr;
+        std::byte* from_addr_         = reinterpret_cast<std::byte*>(vm.addr()) + pm_offset + seg_offset;
+        std::byte* to_addr_           = to_addr + (seg_addr_b - from_addr);
+        std::memcpy(to_addr_, from_addr_, seg_addr_e - seg_addr_b);
+      },
+      // cache block
+      [&](std::byte* blk_addr, std::byte* req_addr_b, std::byte* req_addr_e,
+          common::topology::rank_t owner, std::size_t pm_offset) {
+        common::rma::get_nb(to_addr + (req_addr_b - from_addr), req_addr_e - req_addr_b,
+                            cm.win(), owner, pm_offset + (req_addr_b - blk_addr));
+        bulk_chunk_progress(cm.win(), outstanding_bytes, req_addr_e - req_addr_b);
+      });
+
+    if (outstanding_bytes > 0) {
+      common::rma::flush(cm.win());
+    }
+  }
+
+  void get_bulk_noncoll(std::byte* from_addr, std::byte* to_addr, std::size_t size) {
+    ITYR_CHECK(noncoll_mem_.has(from_addr));
+
+    auto target_rank = noncoll_mem_.get_owner(from_addr);
+    ITYR_CHECK(0 <= target_rank);
+    ITYR_CHECK(target_rank < common::topology::n_ranks());
+
+    if (common::topology::is_locally_accessible(target_rank)) {
+      std::memcpy(to_addr, from_addr, size);
+      return;
+    }
+
+    for_each_block<BlockSize>(from_addr, size, [&](std::byte* blk_addr,
+                                                   std::byte* req_addr_b,
+                                                   std::byte* req_addr_e) {
+      cache_manager_.writeback_region_begin(blk_addr, req_addr_b, req_addr_e);
+    });
+
+    cache_manager_.writeback_region_complete();
+
+    std::size_t outstanding_bytes = 0;
+
+    for_each_block<BlockSize>(from_addr, size, [&](std::byte* blk_addr,
+                                                   std::byte* req_addr_b,
+                                                   std::byte* req_addr_e) {
+      common::rma::get_nb(to_addr + (req_addr_b - from_addr), req_addr_e - req_addr_b,
+                          noncoll_mem_.win(), target_rank,
+                          noncoll_mem_.get_disp(blk_addr) + (req_addr_b - blk_addr));
+      bulk_chunk_progress(noncoll_mem_.win(), outstanding_bytes, req_addr_e - req_addr_b);
+    });
+
+    if (outstanding_bytes > 0) {
+      common::rma::flush(noncoll_mem_.win());
+    }
+  }
+
+  void put_bulk(const std::byte* from_addr, std::byte* to_addr, std::size_t size) {
+    if (noncoll_mem_.has(to_addr)) {
+      put_bulk_noncoll(from_addr, to_addr, size);
+    } else {
+      put_bulk_coll(from_addr, to_addr, size);
+    }
+  }
+
+  void put_bulk_coll(const std::byte* from_addr, std::byte* to_addr, std::size_t size) {
+    coll_mem& cm = cm_manager_.get(to_addr);
+
+    std::size_t outstanding_bytes = 0;
+
+    for_each_seg_blk<BlockSize>(cm, to_addr, size,
+      // home segment
+      [&](std::byte* seg_addr, std::size_t seg_size, common::topology::rank_t owner, std::size_t pm_offset) {
+        const common::virtual_mem& vm = cm.intra_home_vm(common::topology::intra_rank(owner));
+        std::byte* seg_addr_b         = std::max(to_addr, seg_addr);
+        std::byte* seg_addr_e         = std::min(seg_addr + seg_size, to_addr + size);
+        std::size_t seg_offset        = seg_addr_b - seg_addr;
+        const std::byte* from_addr_   = from_addr + (seg_addr_b - to_addr);
+        std::byte* to_addr_           = reinterpret_cast<std::byte*>(vm.addr()) + pm_offset + seg_offset;
+        std::memcpy(to_addr_, from_addr_, seg_addr_e - seg_addr_b);
+      },
+      // cache block
+      [&](std::byte* blk_addr, std::byte* req_addr_b, std::byte* req_addr_e,
+          common::topology::rank_t owner, std::size_t pm_offset) {
+        const std::byte* from_addr_ = from_addr + (req_addr_b - to_addr);
+        cache_manager_.overwrite_blk(blk_addr, req_addr_b, req_addr_e, from_addr_);
+        common::rma::put_nb(from_addr_, req_addr_e - req_addr_b,
+                            cm.win(), owner, pm_offset + (req_addr_b - blk_addr));
+        bulk_chunk_progress(cm.win(), outstanding_bytes, req_addr_e - req_addr_b);
+      });
+
+    if (outstanding_bytes > 0) {
+      common::rma::flush(cm.win());
+    }
+
+    cache_manager_.overwrite_complete();
+  }
+
+  void put_bulk_noncoll(const std::byte* from_addr, std::byte* to_addr, std::size_t size) {
+    ITYR_CHECK(noncoll_mem_.has(to_addr));
+
+    auto target_rank = noncoll_mem_.get_owner(to_addr);
+    ITYR_CHECK(0 <= target_rank);
+    ITYR_CHECK(target_rank < common::topology::n_ranks());
+
+    if (common::topology::is_locally_accessible(target_rank)) {
+      std::memcpy(to_addr, from_addr, size);
+      return;
+    }
+
+    std::size_t outstanding_bytes = 0;
+
+    for_each_block<BlockSize>(to_addr, size, [&](std::byte* blk_addr,
+                                                 std::byte* req_addr_b,
+                                                 std::byte* req_addr_e) {
+      const std::byte* from_addr_ = from_addr + (req_addr_b - to_addr);
+      cache_manager_.overwrite_blk(blk_addr, req_addr_b, req_addr_e, from_addr_);
+      common::rma::put_nb(from_addr_, req_addr_e - req_addr_b,
+                          noncoll_mem_.win(), target_rank,
+                          noncoll_mem_.get_disp(blk_addr) + (req_addr_b - blk_addr));
+      bulk_chunk_progress(noncoll_mem_.win(), outstanding_bytes, req_addr_e - req_addr_b);
+    });
+
+    if (outstanding_bytes > 0) {
+      common::rma::flush(noncoll_mem_.win());
+    }
+
+    cache_manager_.overwrite_complete();
+  }
+
+  void bulk_chunk_progress(const common::rma::win& win, std::size_t& outstanding_bytes, std::size_t size) {
+    outstanding_bytes += size;
+    if (outstanding_bytes >= bulk_getput_chunk_size_) {
+      common::rma::flush(win);
+      outstanding_bytes = 0;
+    }
+  }
+
   template <block_size_t BS>
   using default_mem_mapper = mem_mapper::ITYR_ORI_DEFAULT_MEM_MAPPER<BS>;
 
@@ -565,13 +945,17 @@ private:
   noncoll_mem              noncoll_mem_;
   home_manager<BlockSize>  home_manager_;
   cache_manager<BlockSize> cache_manager_;
+  std::size_t              bulk_getput_threshold_;
+  std::size_t              bulk_getput_chunk_size_;
+  access_tracer            tracer_;
 };
 
 template <block_size_t BlockSize>
 class core_nocache {
 public:
   core_nocache(std::size_t, std::size_t)
-    : noncoll_mem_(noncoll_allocator_size_option::value()) {}
+    : noncoll_mem_(noncoll_allocator_size_option::value(),
+                   noncoll_allocator_max_size_option::value()) {}
 
   static constexpr block_size_t block_size = BlockSize;
 
@@ -585,7 +969,7 @@ public:
 
     auto mmapper = std::make_unique<MemMapper<BlockSize>>(size, common::topology::n_ranks(),
                                                           std::forward<MemMapperArgs>(mmargs)...);
-    coll_mem& cm = cm_manager_.create(size, std::move(mmapper));
+    coll_mem& cm = cm_manager_.create(size, std::move(mmapper), BlockSize);
     void* addr = cm.vm().addr();
 
     common::verbose("Allocate collective memory [%p, %p) (%ld bytes) (win=%p)",
@@ -594,6 +978,20 @@ public:
     return addr;
   }
 
+  void* malloc_coll(std::size_t size, const coll_mem_options& opts) {
+    // No cache to partition and no home migration; only the distribution granularity matters
+    if constexpr (std::is_same_v<default_mem_mapper<BlockSize>, mem_mapper::cyclic<BlockSize>>) {
+      if (opts.block_size > BlockSize) {
+        return malloc_coll<mem_mapper::cyclic>(size, opts.block_size);
+      }
+    } else {
+      ITYR_REQUIRE_MESSAGE(opts.block_size <= BlockSize,
+                           "The block size passed to malloc_coll() cannot be larger than the cache block size (%ld) "
+                           "unless ITYR_ORI_DEFAULT_MEM_MAPPER=cyclic", BlockSize);
+    }
+    return malloc_coll(size);
+  }
+
   void* malloc(std::size_t size) {
     ITYR_CHECK_MESSAGE(size > 0, "Memory allocation size cannot be 0");
 
@@ -684,6 +1082,54 @@ public:
 
   void poll() {}
 
+  void migrate_homes() {}
+
+  // Atomic operations on noncollective memory, which bypass the cache.
+  // Memory accessed by atomic operations must not be accessed by other operations (e.g., get/put).
+  template <typename T>
+  T atomic_get(const T* addr) {
+    ITYR_CHECK(noncoll_mem_.has(addr));
+    T result;
+    common::rma::atomic_get_nb(&result, noncoll_mem_.win(), noncoll_mem_.get_owner(addr),
+                               noncoll_mem_.get_disp(addr));
+    common::rma::flush(noncoll_mem_.win());
+    return result;
+  }
+
+  template <typename T>
+  T atomic_put(T value, T* addr) {
+    ITYR_CHECK(noncoll_mem_.has(addr));
+    T result;
+    common::rma::atomic_put_nb(&value, &result, noncoll_mem_.win(), noncoll_mem_.get_owner(addr),
+                               noncoll_mem_.get_disp(addr));
+    common::rma::flush(noncoll_mem_.win());
+    return result;
+  }
+
+  template <typename T>
+  T atomic_cas(T value, T compare, T* addr) {
+    ITYR_CHECK(noncoll_mem_.has(addr));
+    T result;
+    common::rma::atomic_cas_nb(&value, &compare, &result, noncoll_mem_.win(), noncoll_mem_.get_owner(addr),
+                               noncoll_mem_.get_disp(addr));
+    common::rma::flush(noncoll_mem_.win());
+    return result;
+  }
+
+  // Checked-out data are kept in separately allocated buffers
+  std::size_t cache_size() const { return std::numeric_limits<std::size_t>::max(); }
+
+  common::topology::rank_t get_owner(void* addr) {
+    if (noncoll_mem_.has(addr)) {
+      return noncoll_mem_.get_owner(addr);
+    } else {
+      coll_mem& cm = cm_manager_.get(addr);
+      std::size_t offset = reinterpret_cast<std::byte*>(addr) -
+                           reinterpret_cast<std::byte*>(cm.vm().addr());
+      return cm.get_segment(offset).owner;
+    }
+  }
+
   void collect_deallocated() {
     noncoll_mem_.collect_deallocated();
   }
@@ -841,6 +1287,10 @@ public:
     return std::malloc(size);
   }
 
+  void* malloc_coll(std::size_t size, const coll_mem_options&) {
+    return std::malloc(size);
+  }
+
   void* malloc(std::size_t size) {
     return std::malloc(size);
   }
@@ -884,6 +1334,30 @@ public:
 
   void poll() {}
 
+  void migrate_homes() {}
+
+  template <typename T>
+  T atomic_get(const T* addr) {
+    return __atomic_load_n(addr, __ATOMIC_SEQ_CST);
+  }
+
+  template <typename T>
+  T atomic_put(T value, T* addr) {
+    return __atomic_exchange_n(addr, value, __ATOMIC_SEQ_CST);
+  }
+
+  template <typename T>
+  T atomic_cas(T value, T compare, T* addr) {
+    __atomic_compare_exchange_n(addr, &compare, value, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+    return compare;
+  }
+
+  std::size_t cache_size() const { return std::numeric_limits<std::size_t>::max(); }
+
+  common::topology::rank_t get_owner(void*) {
+    return common::topology::my_rank();
+  }
+
   void collect_deallocated() {}
 
   void cache_prof_begin() {}
@@ -956,6 +1430,202 @@ ITYR_TEST_CASE("[ityr::ori::core] malloc/free with cyclic policy") {
   }
 }
 
+ITYR_TEST_CASE("[ityr::ori::core] reuse pooled collective memory") {
+  constexpr block_size_t bs = 65536;
+  common::singleton_initializer<coll_mem_pool_size_option> pool_opt(std::size_t(64) * bs);
+  common::runtime_options common_opts;
+  runtime_options opts;
+  common::singleton_initializer<common::topology::instance> topo;
+  common::singleton_initializer<common::rma::instance> rma;
+  core<bs> c(16 * bs, bs / 4);
+
+  auto n_ranks = common::topology::n_ranks();
+
+  ITYR_SUBCASE("same size") {
+    void* p1 = c.malloc_coll<mem_mapper::block>(bs * n_ranks);
+    c.free_coll(p1);
+    void* p2 = c.malloc_coll<mem_mapper::block>(bs * n_ranks);
+    ITYR_CHECK(p1 == p2);
+    c.free_coll(p2);
+  }
+
+  ITYR_SUBCASE("different mappers or sizes") {
+    void* p1 = c.malloc_coll<mem_mapper::block>(bs * n_ranks);
+    c.free_coll(p1);
+    void* p2 = c.malloc_coll<mem_mapper::cyclic>(bs * n_ranks);
+    ITYR_CHECK(p1 != p2);
+    void* p3 = c.malloc_coll<mem_mapper::block>(bs * n_ranks * 2);
+    ITYR_CHECK(p1 != p3);
+    c.free_coll(p2);
+    c.free_coll(p3);
+
+    // A smaller cyclic allocation can reuse a larger one
+    void* p4 = c.malloc_coll<mem_mapper::cyclic>(bs * n_ranks - 1);
+    ITYR_CHECK(p2 == p4);
+    c.free_coll(p4);
+  }
+
+  ITYR_SUBCASE("data access after reuse") {
+    using value_t = std::size_t;
+    std::size_t n = bs * n_ranks / sizeof(value_t);
+    std::vector<value_t> buf(n);
+
+    for (std::size_t r = 0; r < 3; r++) {
+      value_t* p = reinterpret_cast<value_t*>(c.malloc_coll<mem_mapper::cyclic>(n * sizeof(value_t)));
+
+      if (common::topology::my_rank() == 0) {
+        for (std::size_t i = 0; i < n; i++) {
+          buf[i] = i + r;
+        }
+        c.put(buf.data(), p, n * sizeof(value_t));
+      }
+
+      c.release();
+      common::mpi_barrier(common::topology::mpicomm());
+      c.acquire();
+
+      c.get(p, buf.data(), n * sizeof(value_t));
+      for (std::size_t i = 0; i < n; i++) {
+        ITYR_CHECK(buf[i] == i + r);
+      }
+
+      c.free_coll(p);
+    }
+  }
+}
+
+ITYR_TEST_CASE("[ityr::ori::core] collective memory in a single window") {
+  common::singleton_initializer<coll_mem_single_win_option> single_win_opt(true);
+  common::singleton_initializer<adaptive_sub_block_option> adaptive_opt(true);
+  common::runtime_options common_opts;
+  runtime_options opts;
+  common::singleton_initializer<common::topology::instance> topo;
+  common::singleton_initializer<common::rma::instance> rma;
+  constexpr block_size_t bs = 65536;
+  core<bs> c(16 * bs, bs / 4);
+
+  auto my_rank = common::topology::my_rank();
+  auto n_ranks = common::topology::n_ranks();
+
+  int n = bs * n_ranks;
+  uint8_t* ps[3];
+  ps[0] = reinterpret_cast<uint8_t*>(c.malloc_coll<mem_mapper::block >(n));
+  ps[1] = reinterpret_cast<uint8_t*>(c.malloc_coll<mem_mapper::cyclic>(n));
+  ps[2] = reinterpret_cast<uint8_t*>(c.malloc_coll<mem_mapper::block >(n));
+
+  for (int k = 0; k < 3; k++) {
+    uint8_t* home_ptr = reinterpret_cast<uint8_t*>(c.get_local_mem(ps[k]));
+    for (std::size_t i = 0; i < bs; i++) {
+      home_ptr[i] = my_rank + k;
+    }
+  }
+
+  c.release();
+  common::mpi_barrier(common::topology::mpicomm());
+  c.acquire();
+
+  // Blocks of different allocations are fetched at the same time
+  for (int k = 0; k < 3; k++) {
+    c.checkout(ps[k], n, mode::read);
+  }
+  for (int k = 0; k < 3; k++) {
+    for (int i = 0; i < n; i++) {
+      ITYR_CHECK_MESSAGE(ps[k][i] == i / bs + k, "rank: ", my_rank, ", k: ", k, ", i: ", i);
+    }
+  }
+  for (int k = 0; k < 3; k++) {
+    c.checkin(ps[k], n, mode::read);
+  }
+
+  std::vector<uint8_t> buf(n);
+  c.get(ps[1], buf.data(), n);
+  for (int i = 0; i < n; i++) {
+    ITYR_CHECK_MESSAGE(buf[i] == i / bs + 1, "rank: ", my_rank, ", i: ", i);
+  }
+
+  c.free_coll(ps[0]);
+  c.free_coll(ps[1]);
+  c.free_coll(ps[2]);
+}
+
+ITYR_TEST_CASE("[ityr::ori::core] adaptive home placement") {
+  common::singleton_initializer<home_migration_epochs_option> epochs_opt(2);
+  common::runtime_options common_opts;
+  runtime_options opts;
+  common::singleton_initializer<common::topology::instance> topo;
+  common::singleton_initializer<common::rma::instance> rma;
+  constexpr block_size_t bs = 65536;
+  core<bs> c(16 * bs, bs / 4);
+
+  auto my_rank = common::topology::my_rank();
+  auto n_ranks = common::topology::n_ranks();
+
+  int n_blks = 4 * n_ranks;
+  coll_mem_options cm_opts;
+  cm_opts.adaptive_home = true;
+  uint8_t* p = reinterpret_cast<uint8_t*>(c.malloc_coll<mem_mapper::block>(n_blks * bs));
+  uint8_t* q = reinterpret_cast<uint8_t*>(c.malloc_coll(n_blks * bs, cm_opts));
+
+  std::vector<common::topology::rank_t> initial_owners(n_blks);
+  for (int b = 0; b < n_blks; b++) {
+    initial_owners[b] = c.get_owner(q + b * bs);
+  }
+
+  // Process r exclusively updates the first block initially owned by process r + 1
+  auto target_blk_of = [&](common::topology::rank_t r) {
+    int b = 0;
+    while (initial_owners[b] != (r + 1) % n_ranks) b++;
+    return b;
+  };
+
+  int target_blk = target_blk_of(my_rank);
+  uint8_t* target = q + target_blk * bs;
+
+  auto update_target = [&](bool first) {
+    c.checkout(target, bs, mode::read_write);
+    for (std::size_t i = 0; i < bs; i++) {
+      target[i] = first ? my_rank : target[i] + 1;
+    }
+    c.checkin(target, bs, mode::read_write);
+
+    c.release();
+    common::mpi_barrier(common::topology::mpicomm());
+    c.migrate_homes();
+    c.acquire();
+  };
+
+  // The home of the target block is migrated to this process after two epochs
+  update_target(true);
+  ITYR_CHECK(c.get_owner(target) == initial_owners[target_blk]);
+  update_target(false);
+  ITYR_CHECK(c.get_owner(target) == my_rank);
+
+  // The homes of the other blocks are not migrated (the last block is not the first one of any process)
+  ITYR_CHECK(c.get_owner(q + (n_blks - 1) * bs) == initial_owners[n_blks - 1]);
+  ITYR_CHECK(c.get_owner(p + target_blk * bs) == target_blk / 4);
+
+  // The migration is consistently seen by all processes
+  common::topology::rank_t writer = (my_rank + 1) % n_ranks;
+  int read_blk = target_blk_of(writer);
+  ITYR_CHECK(c.get_owner(q + read_blk * bs) == writer);
+
+  // Data are preserved across migration, and updates to the new home are visible to other processes
+  for (int n_updates = 2; n_updates < 4; n_updates++) {
+    c.checkout(q + read_blk * bs, bs, mode::read);
+    for (std::size_t i = 0; i < bs; i++) {
+      ITYR_CHECK_MESSAGE(q[read_blk * bs + i] == writer + n_updates - 1, "rank: ", my_rank, ", i: ", i);
+    }
+    c.checkin(q + read_blk * bs, bs, mode::read);
+
+    common::mpi_barrier(common::topology::mpicomm());
+
+    update_target(false);
+  }
+
+  c.free_coll(p);
+  c.free_coll(q);
+}
+
 ITYR_TEST_CASE("[ityr::ori::core] malloc and free (noncollective)") {
   common::runtime_options common_opts;
   runtime_options opts;
@@ -1002,6 +1672,26 @@ ITYR_TEST_CASE("[ityr::ori::core] malloc and free (noncollective)") {
       c.free(ptrs_recv[i], std::size_t(1) << i);
     }
   }
+
+  if (common::rma::support_dynamic_win &&
+      noncoll_allocator_max_size_option::value() != noncoll_allocator_size_option::value()) {
+    ITYR_SUBCASE("grow beyond the initial heap size") {
+      std::size_t size = std::size_t(1) * 1024 * 1024;
+      int n_allocs = noncoll_allocator_size_option::value() / size * 4;
+      std::vector<std::size_t*> ptrs(n_allocs);
+      for (int i = 0; i < n_allocs; i++) {
+        ptrs[i] = reinterpret_cast<std::size_t*>(c.malloc(size));
+        std::size_t v = i;
+        c.put(&v, ptrs[i] + size / sizeof(std::size_t) - 1, sizeof(std::size_t));
+      }
+      for (int i = 0; i < n_allocs; i++) {
+        std::size_t v;
+        c.get(ptrs[i] + size / sizeof(std::size_t) - 1, &v, sizeof(std::size_t));
+        ITYR_CHECK(v == std::size_t(i));
+        c.free(ptrs[i], size);
+      }
+    }
+  }
 }
 
 ITYR_TEST_CASE("[ityr::ori::core] get/put") {
@@ -1087,6 +1777,100 @@ ITYR_TEST_CASE("[ityr::ori::core] get/put") {
   c.free_coll(ps[1]);
 }
 
+ITYR_TEST_CASE("[ityr::ori::core] get/put larger than the cache size") {
+  if constexpr (!common::rma::instance::instance_type::support_unregistered_origin) {
+    // bulk transfers are disabled
+    return;
+  }
+
+  common::runtime_options common_opts;
+  runtime_options opts;
+  common::singleton_initializer<common::topology::instance> topo;
+  common::singleton_initializer<common::rma::instance> rma;
+  constexpr block_size_t bs = 65536;
+  int n_cb = 16;
+  core<bs> c(n_cb * bs, bs / 4);
+
+  auto my_rank = common::topology::my_rank();
+  auto n_ranks = common::topology::n_ranks();
+
+  std::size_t n = 4 * n_cb * bs / sizeof(std::size_t);
+
+  std::size_t* ps[2];
+  ps[0] = reinterpret_cast<std::size_t*>(c.malloc_coll<mem_mapper::block >(n * sizeof(std::size_t)));
+  ps[1] = reinterpret_cast<std::size_t*>(c.malloc_coll<mem_mapper::cyclic>(n * sizeof(std::size_t)));
+
+  std::vector<std::size_t> buf(n);
+
+  auto barrier = [&]() {
+    c.release();
+    common::mpi_barrier(common::topology::mpicomm());
+    c.acquire();
+  };
+
+  for (auto p : ps) {
+    if (my_rank == 0) {
+      for (std::size_t i = 0; i < n; i++) {
+        buf[i] = i;
+      }
+      c.put(buf.data(), p, n * sizeof(std::size_t));
+    }
+
+    barrier();
+
+    ITYR_SUBCASE("get the entire array") {
+      c.get(p, buf.data(), n * sizeof(std::size_t));
+      for (std::size_t i = 0; i < n; i++) {
+        ITYR_CHECK(buf[i] == i);
+      }
+    }
+
+    ITYR_SUBCASE("get after writing to the cache") {
+      // dirty data in the cache must be visible to the subsequent bulk get
+      if (my_rank == 0) {
+        std::size_t i = (n / n_ranks) * (n_ranks - 1) + 3;
+        std::size_t special = 417;
+        c.checkout(p + i, sizeof(std::size_t), mode::read_write);
+        p[i] = special;
+        c.checkin(p + i, sizeof(std::size_t), mode::read_write);
+
+        c.get(p, buf.data(), n * sizeof(std::size_t));
+        for (std::size_t j = 0; j < n; j++) {
+          ITYR_CHECK(buf[j] == (j == i ? special : j));
+        }
+      }
+    }
+
+    ITYR_SUBCASE("put after reading into the cache") {
+      // cached copies must not be stale after the bulk put
+      std::size_t i = (n / n_ranks) * ((my_rank + 1) % n_ranks) + 3;
+      std::size_t v;
+      c.get(p + i, &v, sizeof(std::size_t));
+      ITYR_CHECK(v == i);
+
+      barrier();
+
+      if (my_rank == 0) {
+        for (std::size_t j = 0; j < n; j++) {
+          buf[j] = j * 2;
+        }
+        c.put(buf.data(), p, n * sizeof(std::size_t));
+
+        c.get(p + i, &v, sizeof(std::size_t));
+        ITYR_CHECK(v == i * 2);
+      }
+
+      barrier();
+
+      c.get(p + i, &v, sizeof(std::size_t));
+      ITYR_CHECK(v == i * 2);
+    }
+  }
+
+  c.free_coll(ps[0]);
+  c.free_coll(ps[1]);
+}
+
 ITYR_TEST_CASE("[ityr::ori::core] checkout/checkin (small, aligned)") {
   common::runtime_options common_opts;
   runtime_options opts;
@@ -1166,6 +1950,138 @@ ITYR_TEST_CASE("[ityr::ori::core] checkout/checkin (small, aligned)") {
   c.free_coll(ps[1]);
 }
 
+ITYR_TEST_CASE("[ityr::ori::core] checkout/checkin with per-allocation block sizes") {
+  common::runtime_options common_opts;
+  runtime_options opts;
+  common::singleton_initializer<common::topology::instance> topo;
+  common::singleton_initializer<common::rma::instance> rma;
+  constexpr block_size_t bs = 65536;
+  int n_cb = 16;
+  core<bs> c(n_cb * bs, bs / 4);
+
+  auto my_rank = common::topology::my_rank();
+  auto n_ranks = common::topology::n_ranks();
+
+  std::size_t n = bs * n_ranks;
+  std::size_t* ps[2];
+  ps[0] = reinterpret_cast<std::size_t*>(
+      c.malloc_coll(n * sizeof(std::size_t), coll_mem_options{4096, 0}));
+  ps[1] = reinterpret_cast<std::size_t*>(
+      c.malloc_coll(n * sizeof(std::size_t), coll_mem_options{bs * 4, bs * 4}));
+
+  auto barrier = [&]() {
+    c.release();
+    common::mpi_barrier(common::topology::mpicomm());
+    c.acquire();
+  };
+
+  // access in chunks so that the checked-out region fits in a cache partition
+  std::size_t chunk = bs / sizeof(std::size_t);
+
+  for (auto p : ps) {
+    if (my_rank == 0) {
+      for (std::size_t i = 0; i < n; i += chunk) {
+        c.checkout(p + i, chunk * sizeof(std::size_t), mode::write);
+        for (std::size_t j = i; j < i + chunk; j++) {
+          p[j] = j;
+        }
+        c.checkin(p + i, chunk * sizeof(std::size_t), mode::write);
+      }
+    }
+
+    barrier();
+
+    for (std::size_t i = 0; i < n; i += chunk) {
+      c.checkout(p + i, chunk * sizeof(std::size_t), mode::read);
+      for (std::size_t j = i; j < i + chunk; j++) {
+        ITYR_CHECK_MESSAGE(p[j] == j, "rank: ", my_rank, ", j: ", j);
+      }
+      c.checkin(p + i, chunk * sizeof(std::size_t), mode::read);
+    }
+
+    // random single-element accesses
+    for (std::size_t i = 0; i < 1000; i++) {
+      std::size_t j = (i * 7919 + my_rank * 104729) % n;
+      std::size_t v;
+      c.get(p + j, &v, sizeof(std::size_t));
+      ITYR_CHECK(v == j);
+    }
+
+    barrier();
+  }
+
+  c.free_coll(ps[0]);
+  c.free_coll(ps[1]);
+}
+
+ITYR_TEST_CASE("[ityr::ori::core] checkout/checkin with twin/diff writeback") {
+  common::singleton_initializer<twin_diff_option> twin_diff_opt(true);
+  common::runtime_options common_opts;
+  runtime_options opts;
+  common::singleton_initializer<common::topology::instance> topo;
+  common::singleton_initializer<common::rma::instance> rma;
+  constexpr block_size_t bs = 65536;
+  int n_cb = 16;
+  // Twins are a feature of the cache manager
+  core_default<bs> c(n_cb * bs, bs / 4);
+
+  auto my_rank = common::topology::my_rank();
+  auto n_ranks = common::topology::n_ranks();
+
+  int n = bs * n_ranks;
+  uint8_t* p = reinterpret_cast<uint8_t*>(c.malloc_coll<mem_mapper::block>(n));
+
+  auto barrier = [&]() {
+    c.release();
+    common::mpi_barrier(common::topology::mpicomm());
+    c.acquire();
+  };
+
+  uint8_t* home_ptr = reinterpret_cast<uint8_t*>(c.get_local_mem(p));
+  for (std::size_t i = 0; i < bs; i++) {
+    home_ptr[i] = 0;
+  }
+
+  barrier();
+
+  // All processes share the first block (owned by rank 0), each checking out its own sub-range
+  // and modifying only every fourth byte in it
+  std::size_t sub_size = bs / n_ranks / 4 * 4;
+  std::size_t my_begin = sub_size * my_rank;
+
+  auto expected = [&](std::size_t i, int n_updates) {
+    return (i < sub_size * n_ranks && i % 4 == 0) ? n_updates : 0;
+  };
+
+  int n_iters = 3;
+  for (int iter = 0; iter < n_iters; iter++) {
+    c.checkout(p + my_begin, sub_size, mode::read_write);
+    for (std::size_t i = my_begin; i < my_begin + sub_size; i += 4) {
+      p[i]++;
+    }
+    c.checkin(p + my_begin, sub_size, mode::read_write);
+
+    barrier();
+
+    c.checkout(p, bs, mode::read);
+    for (std::size_t i = 0; i < bs; i++) {
+      ITYR_CHECK_MESSAGE(p[i] == expected(i, iter + 1), "iter: ", iter, ", rank: ", my_rank, ", i: ", i);
+    }
+    c.checkin(p, bs, mode::read);
+
+    barrier();
+  }
+
+  // The shared block is cached (and thus written back with diffs) if its home is not directly accessible
+  if (!common::topology::is_locally_accessible(0)) {
+    ITYR_CHECK(c.n_twin_diff_writebacks() >= std::size_t(n_iters));
+  } else {
+    ITYR_CHECK(c.n_twin_diff_writebacks() == 0);
+  }
+
+  c.free_coll(p);
+}
+
 ITYR_TEST_CASE("[ityr::ori::core] checkout/checkin (large, not aligned)") {
   common::runtime_options common_opts;
   runtime_options opts;
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "ityr/common/util.hpp"
+#include "ityr/ori/util.hpp"
+
+namespace ityr::ori {
+
+// Fetch granularity (sub-block size) of an allocation adjusted between `min` and `max`,
+// based on the ratio of fetched bytes that were never requested by the user before invalidation.
+class adaptive_fetch_granularity {
+public:
+  adaptive_fetch_granularity(block_size_t initial, block_size_t min, block_size_t max)
+    : min_(min),
+      max_(max),
+      cur_(std::clamp(initial, min, max)) {
+    ITYR_CHECK(common::is_pow2(min_));
+    ITYR_CHECK(common::is_pow2(max_));
+    ITYR_CHECK(min_ <= max_);
+    ITYR_CHECK(common::is_pow2(cur_));
+  }
+
+  block_size_t get() const { return cur_; }
+
+  std::size_t n_records() const { return n_records_total_; }
+
+  // Called when a cache block is invalidated; `valid_bytes` of the block were valid in the cache
+  // and `requested_bytes` of them were requested by the user
+  void record(std::size_t valid_bytes, std::size_t requested_bytes) {
+    ITYR_CHECK(requested_bytes <= valid_bytes);
+    if (valid_bytes == 0) return;
+
+    valid_bytes_     += valid_bytes;
+    requested_bytes_ += requested_bytes;
+    n_records_total_++;
+
+    if (++n_records_ >= window) {
+      adjust();
+    }
+  }
+
+private:
+  static constexpr int    window           = 64;
+  static constexpr double wasted_ratio_max = 0.5;
+  static constexpr double wasted_ratio_min = 0.125;
+
+  void adjust() {
+    double wasted_ratio = static_cast<double>(valid_bytes_ - requested_bytes_) / valid_bytes_;
+
+    if (wasted_ratio > wasted_ratio_max && cur_ > min_) {
+      // sparse accesses; most of the padding is wasted
+      cur_ /= 2;
+    } else if (wasted_ratio < wasted_ratio_min && cur_ < max_) {
+      // dense accesses; fewer and larger fetches would suffice
+      cur_ *= 2;
+    }
+
+    valid_bytes_     = 0;
+    requested_bytes_ = 0;
+    n_records_       = 0;
+  }
+
+  block_size_t min_;
+  block_size_t max_;
+  block_size_t cur_;
+  std::size_t  valid_bytes_     = 0;
+  std::size_t  requested_bytes_ = 0;
+  int          n_records_       = 0;
+  std::size_t  n_records_total_ = 0;
+};
+
+ITYR_TEST_CASE("[ityr::ori::adaptive_fetch_granularity] adjust fetch granularity") {
+  block_size_t min = 1024;
+  block_size_t max = 65536;
+  adaptive_fetch_granularity fg(4096, min, max);
+  ITYR_CHECK(fg.get() == 4096);
+
+  ITYR_SUBCASE("sparse accesses") {
+    for (int i = 0; i < 1000; i++) {
+      fg.record(fg.get(), 8);
+    }
+    ITYR_CHECK(fg.get() == min);
+  }
+
+  ITYR_SUBCASE("dense accesses") {
+    for (int i = 0; i < 1000; i++) {
+      fg.record(fg.get(), fg.get());
+    }
+    ITYR_CHECK(fg.get() == max);
+  }
+
+  ITYR_SUBCASE("moderately wasted fetches") {
+    for (int i = 0; i < 1000; i++) {
+      fg.record(4096, 3072);
+    }
+    ITYR_CHECK(fg.get() == 4096);
+  }
+}
+
+}
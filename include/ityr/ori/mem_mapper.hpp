@@ -1,5 +1,7 @@
 #pragma once
 
+#include <typeinfo>
+
 #include "ityr/common/util.hpp"
 #include "ityr/ori/util.hpp"
 
@@ -37,6 +39,10 @@ public:
   // pm_offset is the offset from the beginning of the owner's local physical memory for the block.
   virtual segment get_segment(std::size_t offset) const = 0;
 
+  // Returns true if memory mapped by this mapper can be reused for the allocation mapped by `m`,
+  // i.e., both have the same mapping for [0, m.size) and this has enough capacity.
+  virtual bool can_reuse_for(const base& m) const = 0;
+
 protected:
   std::size_t size_;
   int         n_ranks_;
@@ -77,6 +83,12 @@ public:
                    .pm_offset = 0};
   }
 
+  bool can_reuse_for(const base& m) const override {
+    if (typeid(m) != typeid(*this)) return false;
+    const block& b = static_cast<const block&>(m);
+    return n_ranks_ == b.n_ranks_ && n_blk_ == b.n_blk_;
+  }
+
 private:
   std::tuple<std::size_t, std::size_t> get_seg_range(int seg_id) const {
     std::size_t blk_id_b = (seg_id * n_blk_ + n_ranks_ - 1) / n_ranks_;
@@ -150,6 +162,12 @@ public:
                    .pm_offset = blk_id_l * seg_size_};
   }
 
+  bool can_reuse_for(const base& m) const override {
+    if (typeid(m) != typeid(*this)) return false;
+    const cyclic& c = static_cast<const cyclic&>(m);
+    return n_ranks_ == c.n_ranks_ && seg_size_ == c.seg_size_ && local_size_impl() >= c.local_size_impl();
+  }
+
 private:
   // non-virtual common part
   std::size_t local_size_impl() const {
@@ -230,6 +248,12 @@ public:
                    .pm_offset = 0};
   }
 
+  bool can_reuse_for(const base& m) const override {
+    if (typeid(m) != typeid(*this)) return false;
+    const block_adws& b = static_cast<const block_adws&>(m);
+    return n_ranks_ == b.n_ranks_ && n_blk_ == b.n_blk_;
+  }
+
 private:
   std::tuple<std::size_t, std::size_t> get_seg_range(int seg_id) const {
     std::size_t blk_id_b = (seg_id * n_blk_) / n_ranks_;
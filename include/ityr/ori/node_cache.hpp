@@ -0,0 +1,307 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+#include <sstream>
+#include <algorithm>
+
+#include "ityr/common/util.hpp"
+#include "ityr/common/mpi_util.hpp"
+#include "ityr/common/topology.hpp"
+#include "ityr/common/virtual_mem.hpp"
+#include "ityr/common/physical_mem.hpp"
+#include "ityr/ori/util.hpp"
+#include "ityr/ori/block_regions.hpp"
+
+namespace ityr::ori {
+
+/*
+ * A node-level cache shared by all processes within the same node in POSIX shared memory.
+ *
+ * This is a second-level, direct-mapped cache placed under the private cache of each process.
+ * When a process fetches data of a remote memory block into its private cache, it first looks
+ * up the node cache, and on a miss, publishes the data fetched via RMA to the node cache after
+ * the fetch is completed. As a result, a memory block read by many processes on the same node is
+ * transferred over the network only once.
+ *
+ * Each slot is protected by a version word working as a sequence lock: writers make it odd while
+ * updating the slot, and readers retry (or give up) if the version changes while copying data.
+ * Valid data are managed at the granularity of `BlockSize / 64` bytes with a 64-bit bitmap.
+ *
+ * Consistency is guaranteed with sequence numbers taken from a node-wide monotonic counter:
+ * - Each fetch is assigned a sequence number before issuing RMA, and a slot records the
+ *   smallest sequence number of its valid data.
+ * - A process can reuse data only if they were fetched after its last acquire fence.
+ * - After a process writes data back to home, the slot of the block is invalidated, and data
+ *   fetched before the writeback completion can no longer be inserted to the slot.
+ */
+template <block_size_t BlockSize>
+class node_cache {
+  static constexpr int          n_granules   = 64;
+  static constexpr block_size_t granule_size = BlockSize / n_granules;
+  static_assert(BlockSize % n_granules == 0);
+
+public:
+  using seq_t = uint64_t;
+
+  node_cache(std::size_t size)
+    : n_slots_(size / BlockSize),
+      header_size_(common::round_up_pow2(sizeof(header) + sizeof(slot) * n_slots_, common::get_page_size())),
+      pm_(init_pm()),
+      vm_(init_vm()),
+      header_(reinterpret_cast<header*>(vm_.addr())),
+      slots_(reinterpret_cast<slot*>(header_ + 1)),
+      data_(reinterpret_cast<std::byte*>(vm_.addr()) + header_size_) {
+    ITYR_CHECK(n_slots_ > 0);
+    // Zero-filled shared memory is a valid initial state (no valid data, all versions even)
+    static_assert(std::atomic<seq_t>::is_always_lock_free);
+    static_assert(std::atomic<uintptr_t>::is_always_lock_free);
+  }
+
+  ~node_cache() {
+    // ensure no process is accessing the shared memory before it is unlinked
+    common::mpi_barrier(common::topology::intra_mpicomm());
+  }
+
+  node_cache(const node_cache&) = delete;
+  node_cache& operator=(const node_cache&) = delete;
+
+  seq_t new_seq() {
+    return header_->clock.fetch_add(1, std::memory_order_seq_cst) + 1;
+  }
+
+  // Copy the region `br` of the block at `blk_addr` to `to_blk_addr + br.begin` if the region is
+  // valid in the node cache and was fetched after `acquire_seq`. Returns false on a miss.
+  bool get(std::byte* blk_addr, block_region br, std::byte* to_blk_addr, seq_t acquire_seq) {
+    slot& s = get_slot(blk_addr);
+
+    seq_t v1 = s.version.load(std::memory_order_acquire);
+    if (v1 % 2 == 1) {
+      // being updated by another process
+      return false;
+    }
+
+    uint64_t mask = granule_mask_cover(br);
+    if (s.key.load(std::memory_order_relaxed) != reinterpret_cast<uintptr_t>(blk_addr) ||
+        (s.valid.load(std::memory_order_relaxed) & mask) != mask ||
+        s.fetch_seq.load(std::memory_order_relaxed) <= acquire_seq) {
+      return false;
+    }
+
+    std::memcpy(to_blk_addr + br.begin, slot_data(s) + br.begin, br.size());
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return s.version.load(std::memory_order_relaxed) == v1;
+  }
+
+  // Publish the region `br` of the block at `blk_addr`, whose data are at `from_blk_addr + br.begin`
+  // and were fetched with the sequence number `fetch_seq`. Only fully covered granules are
+  // published, and the update is skipped if the slot is busy.
+  void put(std::byte* blk_addr, block_region br, const std::byte* from_blk_addr, seq_t fetch_seq) {
+    uint64_t mask = granule_mask_inner(br);
+    if (mask == 0) return;
+
+    slot& s = get_slot(blk_addr);
+
+    seq_t v = s.version.load(std::memory_order_relaxed);
+    if (v % 2 == 1 ||
+        !s.version.compare_exchange_strong(v, v + 1, std::memory_order_acquire)) {
+      return;
+    }
+
+    if (fetch_seq >= s.min_seq.load(std::memory_order_relaxed)) {
+      uintptr_t key = reinterpret_cast<uintptr_t>(blk_addr);
+      if (s.key.load(std::memory_order_relaxed) != key ||
+          s.valid.load(std::memory_order_relaxed) == 0) {
+        s.key.store(key, std::memory_order_relaxed);
+        s.valid.store(0, std::memory_order_relaxed);
+        s.fetch_seq.store(fetch_seq, std::memory_order_relaxed);
+      } else {
+        s.fetch_seq.store(std::min(s.fetch_seq.load(std::memory_order_relaxed), fetch_seq),
+                          std::memory_order_relaxed);
+      }
+
+      for_each_granule_range(mask, [&](block_size_t b, block_size_t e) {
+        std::memcpy(slot_data(s) + b, from_blk_addr + b, e - b);
+      });
+
+      s.valid.fetch_or(mask, std::memory_order_relaxed);
+    }
+
+    s.version.store(v + 2, std::memory_order_release);
+  }
+
+  // Invalidate the block at `blk_addr`. This must be called after writes to the block are
+  // completed at home, so that stale data fetched before completion are never published again.
+  void invalidate(std::byte* blk_addr) {
+    slot& s = get_slot(blk_addr);
+
+    seq_t min_seq = new_seq();
+
+    seq_t v = s.version.load(std::memory_order_relaxed);
+    while (v % 2 == 1 ||
+           !s.version.compare_exchange_weak(v, v + 1, std::memory_order_acquire)) {
+      v = s.version.load(std::memory_order_relaxed);
+    }
+
+    // The watermark is per slot (not per block), which is conservative but safe
+    if (s.min_seq.load(std::memory_order_relaxed) < min_seq) {
+      s.min_seq.store(min_seq, std::memory_order_relaxed);
+    }
+    if (s.key.load(std::memory_order_relaxed) == reinterpret_cast<uintptr_t>(blk_addr)) {
+      s.valid.store(0, std::memory_order_relaxed);
+    }
+
+    s.version.store(v + 2, std::memory_order_release);
+  }
+
+private:
+  struct header {
+    std::atomic<seq_t> clock;
+  };
+
+  struct slot {
+    std::atomic<seq_t>     version;   // odd while the slot is being updated
+    std::atomic<uintptr_t> key;       // global address of the cached block
+    std::atomic<uint64_t>  valid;     // bitmap of valid granules
+    std::atomic<seq_t>     fetch_seq; // sequence number of the oldest valid data
+    std::atomic<seq_t>     min_seq;   // data fetched before this cannot be inserted
+  };
+
+  static std::string node_cache_shmem_name(int global_rank) {
+    std::stringstream ss;
+    ss << "/ityr_ori_node_cache_" << global_rank;
+    return ss.str();
+  }
+
+  common::physical_mem init_pm() const {
+    std::size_t pm_size = header_size_ + n_slots_ * BlockSize;
+    auto leader_rank = common::topology::intra2global_rank(0);
+
+    if (common::topology::intra_my_rank() == 0) {
+      common::physical_mem pm(node_cache_shmem_name(leader_rank), pm_size, true);
+      common::mpi_barrier(common::topology::intra_mpicomm());
+      return pm;
+    } else {
+      common::mpi_barrier(common::topology::intra_mpicomm());
+      return common::physical_mem(node_cache_shmem_name(leader_rank), pm_size, false);
+    }
+  }
+
+  common::virtual_mem init_vm() const {
+    common::virtual_mem vm(pm_.size(), common::get_page_size());
+    pm_.map_to_vm(vm.addr(), vm.size(), 0);
+    return vm;
+  }
+
+  slot& get_slot(std::byte* blk_addr) const {
+    ITYR_CHECK(reinterpret_cast<uintptr_t>(blk_addr) % BlockSize == 0);
+    return slots_[(reinterpret_cast<uintptr_t>(blk_addr) / BlockSize) % n_slots_];
+  }
+
+  std::byte* slot_data(const slot& s) const {
+    return data_ + (&s - slots_) * BlockSize;
+  }
+
+  static uint64_t granule_mask(int gb, int ge) {
+    ITYR_CHECK(0 <= gb);
+    ITYR_CHECK(gb <= ge);
+    ITYR_CHECK(ge <= n_granules);
+    if (gb == ge) return 0;
+    uint64_t m = (ge - gb == n_granules) ? ~uint64_t(0) : ((uint64_t(1) << (ge - gb)) - 1);
+    return m << gb;
+  }
+
+  // granules overlapping with the region
+  static uint64_t granule_mask_cover(block_region br) {
+    return granule_mask(br.begin / granule_size, (br.end + granule_size - 1) / granule_size);
+  }
+
+  // granules fully contained in the region
+  static uint64_t granule_mask_inner(block_region br) {
+    int gb = (br.begin + granule_size - 1) / granule_size;
+    int ge = br.end / granule_size;
+    return gb < ge ? granule_mask(gb, ge) : 0;
+  }
+
+  template <typename Fn>
+  static void for_each_granule_range(uint64_t mask, Fn fn) {
+    int g = 0;
+    while (g < n_granules) {
+      if (!((mask >> g) & 1)) { g++; continue; }
+      int gb = g;
+      while (g < n_granules && ((mask >> g) & 1)) g++;
+      fn(gb * granule_size, g * granule_size);
+    }
+  }
+
+  std::size_t          n_slots_;
+  std::size_t          header_size_;
+  common::physical_mem pm_;
+  common::virtual_mem  vm_;
+  header*              header_;
+  slot*                slots_;
+  std::byte*           data_;
+};
+
+ITYR_TEST_CASE("[ityr::ori::node_cache] get/put/invalidate") {
+  common::runtime_options common_opts;
+  common::singleton_initializer<common::topology::instance> topo;
+
+  constexpr block_size_t bs = 65536;
+  node_cache<bs> nc(4 * bs);
+
+  std::vector<std::byte> blk(bs);
+  std::vector<std::byte> buf(bs);
+  for (std::size_t i = 0; i < bs; i++) {
+    blk[i] = std::byte(i % 251);
+  }
+
+  std::byte* blk_addr = reinterpret_cast<std::byte*>(uintptr_t(bs) * 1000);
+
+  auto acquire_seq = nc.new_seq();
+  auto fetch_seq   = nc.new_seq();
+
+  block_region br_all  = {0, bs};
+  block_region br_half = {0, bs / 2};
+
+  // nothing is cached initially
+  ITYR_CHECK(!nc.get(blk_addr, br_all, buf.data(), acquire_seq));
+
+  nc.put(blk_addr, br_half, blk.data(), fetch_seq);
+
+  ITYR_CHECK(nc.get(blk_addr, br_half, buf.data(), acquire_seq));
+  ITYR_CHECK(std::equal(buf.begin(), buf.begin() + bs / 2, blk.begin()));
+
+  // the latter half is not valid
+  ITYR_CHECK(!nc.get(blk_addr, br_all, buf.data(), acquire_seq));
+
+  // a different block mapped to the same slot
+  ITYR_CHECK(!nc.get(blk_addr + 4 * bs, br_half, buf.data(), acquire_seq));
+
+  ITYR_SUBCASE("stale data after an acquire fence") {
+    auto acquire_seq2 = nc.new_seq();
+    ITYR_CHECK(!nc.get(blk_addr, br_half, buf.data(), acquire_seq2));
+  }
+
+  ITYR_SUBCASE("invalidation") {
+    nc.invalidate(blk_addr);
+    ITYR_CHECK(!nc.get(blk_addr, br_half, buf.data(), acquire_seq));
+
+    // data fetched before invalidation cannot be published
+    nc.put(blk_addr, br_half, blk.data(), fetch_seq);
+    ITYR_CHECK(!nc.get(blk_addr, br_half, buf.data(), acquire_seq));
+
+    nc.put(blk_addr, br_half, blk.data(), nc.new_seq());
+    ITYR_CHECK(nc.get(blk_addr, br_half, buf.data(), acquire_seq));
+  }
+
+  ITYR_SUBCASE("partial granules are not published") {
+    block_region br_small = {10, 100};
+    std::byte* blk_addr2 = blk_addr + bs;
+    nc.put(blk_addr2, br_small, blk.data(), nc.new_seq());
+    ITYR_CHECK(!nc.get(blk_addr2, br_small, buf.data(), acquire_seq));
+  }
+}
+
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <functional>
+
 #include "ityr/common/util.hpp"
 #include "ityr/common/rma.hpp"
 #include "ityr/common/allocator.hpp"
@@ -8,19 +10,33 @@ namespace ityr::ori {
 
 // TODO: unify these implementations with the common allocator
 
+// The memory region [addr, addr + max_size) is reserved, but only the first `initial_size` bytes are
+// initially available. When the available region is exhausted, it is grown geometrically (up to
+// `max_size`), and the newly available region is passed to `grow_fn` (e.g., to attach it to an RMA window).
 class root_resource final : public common::pmr::memory_resource {
 public:
-  root_resource(void* addr, std::size_t size)
+  using grow_fn_t = std::function<void(void*, std::size_t)>;
+
+  root_resource(void* addr, std::size_t initial_size, std::size_t max_size, grow_fn_t grow_fn = {})
     : addr_(addr),
-      size_(size),
-      freelist_(reinterpret_cast<uintptr_t>(addr_), size_) {}
+      size_(initial_size),
+      max_size_(max_size),
+      grow_fn_(grow_fn),
+      freelist_(reinterpret_cast<uintptr_t>(addr_), size_) {
+    ITYR_CHECK(initial_size <= max_size);
+  }
+
+  std::size_t size() const { return size_; }
 
   void* do_allocate(std::size_t bytes, std::size_t alignment) override {
-    ITYR_CHECK(bytes <= size_);
+    ITYR_CHECK(bytes <= max_size_);
 
     auto s = freelist_.get(bytes, alignment);
-    if (!s.has_value()) {
-      common::die("[ityr::ori::noncoll_mem] Could not allocate memory for malloc_local()");
+    while (!s.has_value()) {
+      if (!grow(bytes + alignment)) {
+        common::die("[ityr::ori::noncoll_mem] Could not allocate memory for malloc_local()");
+      }
+      s = freelist_.get(bytes, alignment);
     }
 
     return reinterpret_cast<void*>(*s);
@@ -38,29 +54,64 @@ public:
   }
 
 private:
+  bool grow(std::size_t min_bytes) {
+    std::size_t new_size = std::min(std::max(size_ * 2, size_ + min_bytes), max_size_);
+    new_size = std::min(common::round_up_pow2(new_size, common::get_page_size()), max_size_);
+    if (new_size <= size_) {
+      return false;
+    }
+
+    std::byte* grow_addr = reinterpret_cast<std::byte*>(addr_) + size_;
+    std::size_t grow_size = new_size - size_;
+
+    common::verbose("Grow noncollective heap [%p, %p) (%ld bytes)",
+                    grow_addr, grow_addr + grow_size, grow_size);
+
+    if (grow_fn_) {
+      grow_fn_(grow_addr, grow_size);
+    }
+
+    freelist_.add(reinterpret_cast<uintptr_t>(grow_addr), grow_size);
+    size_ = new_size;
+    return true;
+  }
+
   void*            addr_;
   std::size_t      size_;
+  std::size_t      max_size_;
+  grow_fn_t        grow_fn_;
   common::freelist freelist_;
 };
 
 class noncoll_mem final : public common::pmr::memory_resource {
 public:
-  noncoll_mem(std::size_t local_max_size)
-    : local_max_size_(local_max_size),
+  noncoll_mem(std::size_t initial_size, std::size_t max_size = 0)
+    : initial_size_(initial_size),
+      growable_(common::rma::support_dynamic_win && max_size != initial_size),
+      local_max_size_(calc_local_max_size(max_size)),
       global_max_size_(local_max_size_ * common::topology::n_ranks()),
       vm_(common::reserve_same_vm_coll(global_max_size_, local_max_size_)),
       pm_(init_pm()),
       local_base_addr_(reinterpret_cast<std::byte*>(vm_.addr()) + local_max_size_ * common::topology::my_rank()),
-      win_(common::rma::create_win(local_base_addr_, local_max_size_)),
-      root_mr_(local_base_addr_, local_max_size_ - sizeof(int)), // The last element is used for a flag value for deallocation
+      win_(create_win()),
+      root_mr_(local_base_addr_, initial_size_, local_max_size_,
+               [this](void* addr, std::size_t size) { on_grow(addr, size); }),
       std_pool_mr_(my_std_pool_options(), &root_mr_),
       max_unflushed_free_objs_(common::allocator_max_unflushed_free_objs_option::value()),
       allocated_size_(0),
-      collect_threshold_(std::size_t(16) * 1024),
-      collect_threshold_max_(local_max_size_ * 8 / 10) {
-    // Set the flag value for deallocation
-    *reinterpret_cast<int*>(
-      reinterpret_cast<std::byte*>(local_base_addr_) + local_max_size_ - sizeof(int)) = 1;
+      collect_threshold_(std::size_t(16) * 1024) {
+    ITYR_CHECK(initial_size_ <= local_max_size_);
+    // Set the flag value for deallocation (placed within the initial region registered to the window)
+    dealloc_flag_ = reinterpret_cast<int*>(root_mr_.allocate(sizeof(int), alignof(int)));
+    *dealloc_flag_ = 1;
+  }
+
+  ~noncoll_mem() {
+    if (growable_) {
+      for (void* addr : attached_addrs_) {
+        common::rma::detach(*win_, addr);
+      }
+    }
   }
 
   const common::rma::win& win() const { return *win_; }
@@ -74,7 +125,12 @@ public:
   }
 
   std::size_t get_disp(const void* p) const {
-    return (reinterpret_cast<uintptr_t>(p) - reinterpret_cast<uintptr_t>(vm_.addr())) % local_max_size_;
+    if (growable_) {
+      // Dynamic windows are addressed by absolute addresses, which are the same among all processes
+      return reinterpret_cast<uintptr_t>(p);
+    } else {
+      return (reinterpret_cast<uintptr_t>(p) - reinterpret_cast<uintptr_t>(vm_.addr())) % local_max_size_;
+    }
   }
 
   void* do_allocate(std::size_t bytes, std::size_t alignment = alignof(max_align_t)) override {
@@ -85,9 +141,11 @@ public:
 
     if (allocated_size_ >= collect_threshold_) {
       collect_deallocated();
+      // Try to collect deallocated memory before growing the heap
+      std::size_t collect_threshold_max = root_mr_.size() * 8 / 10;
       collect_threshold_ = allocated_size_ * 2;
-      if (collect_threshold_ > collect_threshold_max_) {
-        collect_threshold_ = (collect_threshold_max_ + allocated_size_) / 2;
+      if (collect_threshold_ > collect_threshold_max) {
+        collect_threshold_ = (collect_threshold_max + allocated_size_) / 2;
       }
     }
 
@@ -144,9 +202,7 @@ public:
     ITYR_CHECK(common::topology::my_rank() != target_rank);
     ITYR_CHECK(get_owner(p) == target_rank);
 
-    int* flag_val_p = reinterpret_cast<int*>(
-      reinterpret_cast<std::byte*>(local_base_addr_) + local_max_size_ - sizeof(int));
-    common::rma::put_nb(win(), flag_val_p, 1, win(), target_rank, get_header_disp(p, alignment));
+    common::rma::put_nb(win(), dealloc_flag_, 1, win(), target_rank, get_header_disp(p, alignment));
 
     static int count = 0;
     count++;
@@ -226,6 +282,39 @@ private:
     return pm;
   }
 
+  std::size_t calc_local_max_size(std::size_t max_size) const {
+    if (!growable_) {
+      return initial_size_;
+    } else if (max_size == 0) {
+      // Reserve 1 TiB of virtual memory in total
+      return common::round_up_pow2((std::size_t(1) << 40) / common::next_pow2(common::topology::n_ranks()),
+                                   common::get_page_size());
+    } else {
+      ITYR_REQUIRE_MESSAGE(max_size > initial_size_,
+                           "ITYR_ORI_NONCOLL_ALLOCATOR_MAX_SIZE must be larger than ITYR_ORI_NONCOLL_ALLOCATOR_SIZE");
+      return max_size;
+    }
+  }
+
+  std::unique_ptr<common::rma::win> create_win() {
+    if (growable_) {
+      auto win = common::rma::create_win_dynamic();
+      common::rma::attach(*win, local_base_addr_, initial_size_);
+      attached_addrs_.push_back(local_base_addr_);
+      return win;
+    } else {
+      return common::rma::create_win(local_base_addr_, local_max_size_);
+    }
+  }
+
+  void on_grow(void* addr, std::size_t size) {
+    if (growable_) {
+      // Physical memory is committed on first touch; only the RMA window needs to be extended
+      common::rma::attach(*win_, addr, size);
+      attached_addrs_.push_back(addr);
+    }
+  }
+
   // FIXME: workaround for boost
   // Ideally: pmr::pool_options{.max_blocks_per_chunk = (std::size_t)16 * 1024 * 1024 * 1024}
   common::pmr::pool_options my_std_pool_options() const {
@@ -271,20 +360,23 @@ private:
     allocated_size_ -= size;
   }
 
+  std::size_t                               initial_size_;
+  bool                                      growable_;
   std::size_t                               local_max_size_;
   std::size_t                               global_max_size_;
   common::virtual_mem                       vm_;
   common::physical_mem                      pm_;
   void*                                     local_base_addr_;
+  std::vector<void*>                        attached_addrs_;
   std::unique_ptr<common::rma::win>         win_;
   root_resource                             root_mr_;
+  int*                                      dealloc_flag_;
   common::pmr::unsynchronized_pool_resource std_pool_mr_;
   int                                       max_unflushed_free_objs_;
   header                                    allocated_list_;
   header*                                   allocated_list_end_ = &allocated_list_;
   std::size_t                               allocated_size_;
   std::size_t                               collect_threshold_;
-  std::size_t                               collect_threshold_max_;
 };
 
 }
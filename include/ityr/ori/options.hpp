@@ -45,6 +45,11 @@ inline void print_compile_options() {
 #define ITYR_ORI_CACHE_PROF disabled
 #endif
   ITYR_PRINT_MACRO(ITYR_ORI_CACHE_PROF);
+
+#ifndef ITYR_ORI_ACCESS_TRACE
+#define ITYR_ORI_ACCESS_TRACE disabled
+#endif
+  ITYR_PRINT_MACRO(ITYR_ORI_ACCESS_TRACE);
 }
 
 struct cache_size_option : public common::option<cache_size_option, std::size_t> {
@@ -59,18 +64,99 @@ struct sub_block_size_option : public common::option<sub_block_size_option, std:
   static std::size_t default_value() { return 4096; }
 };
 
+struct adaptive_sub_block_option : public common::option<adaptive_sub_block_option, bool> {
+  using option::option;
+  static std::string name() { return "ITYR_ORI_ADAPTIVE_SUB_BLOCK"; }
+  static bool default_value() { return false; }
+};
+
+struct adaptive_sub_block_min_option : public common::option<adaptive_sub_block_min_option, std::size_t> {
+  using option::option;
+  static std::string name() { return "ITYR_ORI_ADAPTIVE_SUB_BLOCK_MIN"; }
+  static std::size_t default_value() { return 1024; }
+};
+
+struct adaptive_sub_block_max_option : public common::option<adaptive_sub_block_max_option, std::size_t> {
+  using option::option;
+  static std::string name() { return "ITYR_ORI_ADAPTIVE_SUB_BLOCK_MAX"; }
+  static std::size_t default_value() { return ITYR_ORI_BLOCK_SIZE; }
+};
+
 struct max_dirty_cache_size_option : public common::option<max_dirty_cache_size_option, std::size_t> {
   using option::option;
   static std::string name() { return "ITYR_ORI_MAX_DIRTY_CACHE_SIZE"; }
   static std::size_t default_value() { return cache_size_option::value() / 2; }
 };
 
+struct twin_diff_option : public common::option<twin_diff_option, bool> {
+  using option::option;
+  static std::string name() { return "ITYR_ORI_TWIN_DIFF"; }
+  static bool default_value() { return false; }
+};
+
+struct node_cache_size_option : public common::option<node_cache_size_option, std::size_t> {
+  using option::option;
+  static std::string name() { return "ITYR_ORI_NODE_CACHE_SIZE"; }
+  static std::size_t default_value() { return 0; }
+};
+
+// ori::get/put of at least this size bypass the cache (capped at half of the cache size).
+// Bulk transfers are disabled on RMA layers that cannot issue RMA from unregistered user
+// buffers (i.e., ITYR_RMA_IMPL=utofu), in which case this option is ignored.
+struct bulk_getput_threshold_option : public common::option<bulk_getput_threshold_option, std::size_t> {
+  using option::option;
+  static std::string name() { return "ITYR_ORI_BULK_GETPUT_THRESHOLD"; }
+  static std::size_t default_value() { return cache_size_option::value() / 4; }
+};
+
+struct bulk_getput_chunk_size_option : public common::option<bulk_getput_chunk_size_option, std::size_t> {
+  using option::option;
+  static std::string name() { return "ITYR_ORI_BULK_GETPUT_CHUNK_SIZE"; }
+  static std::size_t default_value() { return std::size_t(1) * 1024 * 1024; }
+};
+
 struct noncoll_allocator_size_option : public common::option<noncoll_allocator_size_option, std::size_t> {
   using option::option;
   static std::string name() { return "ITYR_ORI_NONCOLL_ALLOCATOR_SIZE"; }
   static std::size_t default_value() { return std::size_t(4) * 1024 * 1024; }
 };
 
+struct noncoll_allocator_max_size_option : public common::option<noncoll_allocator_max_size_option, std::size_t> {
+  using option::option;
+  static std::string name() { return "ITYR_ORI_NONCOLL_ALLOCATOR_MAX_SIZE"; }
+  static std::size_t default_value() { return 0; }
+};
+
+struct coll_mem_pool_size_option : public common::option<coll_mem_pool_size_option, std::size_t> {
+  using option::option;
+  static std::string name() { return "ITYR_ORI_COLL_MEM_POOL_SIZE"; }
+  static std::size_t default_value() { return 0; }
+};
+
+struct coll_mem_single_win_option : public common::option<coll_mem_single_win_option, bool> {
+  using option::option;
+  static std::string name() { return "ITYR_ORI_COLL_MEM_SINGLE_WIN"; }
+  static bool default_value() { return false; }
+};
+
+struct home_migration_capacity_option : public common::option<home_migration_capacity_option, std::size_t> {
+  using option::option;
+  static std::string name() { return "ITYR_ORI_HOME_MIGRATION_CAPACITY"; }
+  static std::size_t default_value() { return std::size_t(16) * 1024 * 1024; }
+};
+
+struct home_migration_threshold_option : public common::option<home_migration_threshold_option, double> {
+  using option::option;
+  static std::string name() { return "ITYR_ORI_HOME_MIGRATION_THRESHOLD"; }
+  static double default_value() { return 0.9; }
+};
+
+struct home_migration_epochs_option : public common::option<home_migration_epochs_option, int> {
+  using option::option;
+  static std::string name() { return "ITYR_ORI_HOME_MIGRATION_EPOCHS"; }
+  static int default_value() { return 2; }
+};
+
 struct lazy_release_check_interval_option : public common::option<lazy_release_check_interval_option, int> {
   using option::option;
   static std::string name() { return "ITYR_ORI_LAZY_RELEASE_CHECK_INTERVAL"; }
@@ -86,8 +172,21 @@ struct lazy_release_make_mpi_progress_option : public common::option<lazy_releas
 struct runtime_options {
   common::option_initializer<cache_size_option>                     ITYR_ANON_VAR;
   common::option_initializer<sub_block_size_option>                 ITYR_ANON_VAR;
+  common::option_initializer<adaptive_sub_block_option>             ITYR_ANON_VAR;
+  common::option_initializer<adaptive_sub_block_min_option>         ITYR_ANON_VAR;
+  common::option_initializer<adaptive_sub_block_max_option>         ITYR_ANON_VAR;
   common::option_initializer<max_dirty_cache_size_option>           ITYR_ANON_VAR;
+  common::option_initializer<twin_diff_option>                      ITYR_ANON_VAR;
+  common::option_initializer<node_cache_size_option>                ITYR_ANON_VAR;
+  common::option_initializer<bulk_getput_threshold_option>          ITYR_ANON_VAR;
+  common::option_initializer<bulk_getput_chunk_size_option>         ITYR_ANON_VAR;
   common::option_initializer<noncoll_allocator_size_option>         ITYR_ANON_VAR;
+  common::option_initializer<noncoll_allocator_max_size_option>     ITYR_ANON_VAR;
+  common::option_initializer<coll_mem_pool_size_option>             ITYR_ANON_VAR;
+  common::option_initializer<coll_mem_single_win_option>            ITYR_ANON_VAR;
+  common::option_initializer<home_migration_capacity_option>        ITYR_ANON_VAR;
+  common::option_initializer<home_migration_threshold_option>       ITYR_ANON_VAR;
+  common::option_initializer<home_migration_epochs_option>          ITYR_ANON_VAR;
   common::option_initializer<lazy_release_check_interval_option>    ITYR_ANON_VAR;
   common::option_initializer<lazy_release_make_mpi_progress_option> ITYR_ANON_VAR;
 };
@@ -4,6 +4,7 @@
 #include "ityr/common/options.hpp"
 #include "ityr/common/topology.hpp"
 #include "ityr/common/wallclock.hpp"
+#include "ityr/common/netemu.hpp"
 #include "ityr/common/profiler.hpp"
 #include "ityr/common/prof_events.hpp"
 #include "ityr/common/rma.hpp"
@@ -29,6 +30,7 @@ private:
   common::runtime_options                                    common_opts_;
   common::singleton_initializer<common::topology::instance>  topo_;
   common::singleton_initializer<common::wallclock::instance> clock_;
+  common::singleton_initializer<common::netemu::instance>    netemu_;
   common::singleton_initializer<common::profiler::instance>  prof_;
   common::singleton_initializer<common::rma::instance>       rma_;
   common::prof_events                                        common_prof_events_;
@@ -53,6 +55,11 @@ inline global_ptr<T> malloc_coll(std::size_t count) {
   return global_ptr<T>(reinterpret_cast<T*>(core::instance::get().malloc_coll(count * sizeof(T))));
 }
 
+template <typename T>
+inline global_ptr<T> malloc_coll(std::size_t count, const coll_mem_options& opts) {
+  return global_ptr<T>(reinterpret_cast<T*>(core::instance::get().malloc_coll(count * sizeof(T), opts)));
+}
+
 template <typename T, template <block_size_t> typename MemMapper, typename... MemMapperArgs>
 inline global_ptr<T> malloc_coll(std::size_t count, MemMapperArgs&&... mmargs) {
   return global_ptr<T>(reinterpret_cast<T*>(core::instance::get().malloc_coll<MemMapper>(count * sizeof(T),
@@ -207,6 +214,45 @@ inline void poll() {
   core::instance::get().poll();
 }
 
+// Whether the atomic operations below are supported by the RMA layer
+inline constexpr bool support_atomic = common::rma::support_atomic;
+
+// Atomic operations on noncollective memory, bypassing the cache. Memory regions accessed by atomic
+// operations must not be accessed by other operations (e.g., get/put and checkout/checkin).
+template <typename T>
+inline T atomic_get(global_ptr<T> ptr) {
+  static_assert(std::is_integral_v<T>, "Atomic operations require integral types");
+  return core::instance::get().atomic_get(ptr.raw_ptr());
+}
+
+// Returns the old value
+template <typename T>
+inline T atomic_put(T value, global_ptr<T> ptr) {
+  static_assert(std::is_integral_v<T>, "Atomic operations require integral types");
+  return core::instance::get().atomic_put(value, ptr.raw_ptr());
+}
+
+// Returns the old value (`value` is written only if it is equal to `compare`)
+template <typename T>
+inline T atomic_cas(T value, T compare, global_ptr<T> ptr) {
+  static_assert(std::is_integral_v<T>, "Atomic operations require integral types");
+  return core::instance::get().atomic_cas(value, compare, ptr.raw_ptr());
+}
+
+template <typename T>
+inline common::topology::rank_t get_owner(global_ptr<T> ptr) {
+  return core::instance::get().get_owner(ptr.raw_ptr());
+}
+
+// Capacity of the software cache for checked-out data (unlimited if the core has no cache)
+inline std::size_t cache_size() {
+  return core::instance::get().cache_size();
+}
+
+inline void migrate_homes() {
+  core::instance::get().migrate_homes();
+}
+
 inline void collect_deallocated() {
   core::instance::get().collect_deallocated();
 }
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstring>
+
+#include "ityr/common/util.hpp"
+#include "ityr/ori/util.hpp"
+#include "ityr/ori/block_regions.hpp"
+
+namespace ityr::ori {
+
+// Call `fn(block_region)` for each region within `br` in which the data `cur` differ from their
+// pristine copy (twin) `twin`. Unmodified chunks are skipped with memcmp(), which is vectorized in
+// most libc implementations. Modified regions separated by less than `max_gap` bytes are merged
+// to reduce the number of RMA operations at the cost of writing back some unmodified bytes.
+template <typename Fn>
+inline void for_each_modified_region(const std::byte* cur,
+                                     const std::byte* twin,
+                                     block_region     br,
+                                     std::size_t      max_gap,
+                                     Fn&&             fn) {
+  constexpr std::size_t chunk_size = 64;
+
+  std::size_t e = br.end;
+
+  // Returns the first modified offset in [i, e) (or e if not found)
+  auto next_modified = [&](std::size_t i) {
+    while (i < e) {
+      std::size_t n = std::min(chunk_size, e - i);
+      if (std::memcmp(cur + i, twin + i, n) != 0) {
+        while (cur[i] == twin[i]) i++;
+        return i;
+      }
+      i += n;
+    }
+    return e;
+  };
+
+  // Returns the first unmodified offset in [i, e) (or e if not found)
+  auto next_unmodified = [&](std::size_t i) {
+    while (i < e && cur[i] != twin[i]) i++;
+    return i;
+  };
+
+  std::size_t b = next_modified(br.begin);
+  while (b < e) {
+    std::size_t m_end = next_unmodified(b);
+    std::size_t next_b = next_modified(m_end);
+    while (next_b < e && next_b - m_end < max_gap) {
+      m_end = next_unmodified(next_b);
+      next_b = next_modified(m_end);
+    }
+    fn(block_region{b, m_end});
+    b = next_b;
+  }
+}
+
+ITYR_TEST_CASE("[ityr::ori::twin_diff] modified regions") {
+  constexpr std::size_t n = 1024;
+  std::byte twin[n] = {};
+  std::byte cur[n] = {};
+
+  auto get_modified = [&](block_region br, std::size_t max_gap) {
+    block_regions ret;
+    for_each_modified_region(cur, twin, br, max_gap, [&](block_region r) { ret.add(r); });
+    return ret;
+  };
+
+  ITYR_SUBCASE("unmodified") {
+    ITYR_CHECK(get_modified({0, n}, 0).empty());
+  }
+
+  ITYR_SUBCASE("sparse modifications") {
+    cur[3]   = std::byte(1);
+    cur[100] = std::byte(1);
+    cur[101] = std::byte(1);
+    cur[n-1] = std::byte(1);
+
+    block_regions expected = {{3, 4}, {100, 102}, {n - 1, n}};
+    ITYR_CHECK(get_modified({0, n}, 0) == expected);
+
+    block_regions expected_clipped = {{100, 102}};
+    ITYR_CHECK(get_modified({4, n - 1}, 0) == expected_clipped);
+
+    block_regions expected_merged = {{3, 102}, {n - 1, n}};
+    ITYR_CHECK(get_modified({0, n}, 128) == expected_merged);
+  }
+
+  ITYR_SUBCASE("dense modifications") {
+    for (std::size_t i = 0; i < n; i++) {
+      cur[i] = std::byte(1);
+    }
+    block_regions expected = {{0, n}};
+    ITYR_CHECK(get_modified({0, n}, 0) == expected);
+  }
+}
+
+}
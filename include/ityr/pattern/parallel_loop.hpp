@@ -7,6 +7,7 @@
 #include "ityr/pattern/count_iterator.hpp"
 #include "ityr/pattern/global_iterator.hpp"
 #include "ityr/pattern/serial_loop.hpp"
+#include "ityr/pattern/random.hpp"
 
 namespace ityr {
 
@@ -29,7 +30,7 @@ inline void parallel_loop_generic(execution::parallel_policy policy,
   auto d = std::distance(first, last);
   if (static_cast<std::size_t>(d) <= policy.cutoff_count) {
     auto seq_policy = execution::internal::to_sequenced_policy(policy);
-    for_each_aux(seq_policy, [&](auto&&... its) {
+    for_each_leaf_aux<is_chunk_op_v<Op>>(seq_policy, [&](auto&&... its) {
       op(std::forward<decltype(its)>(its)...);
     }, first, last, firsts...);
     return;
@@ -84,7 +85,7 @@ inline T parallel_reduce_generic(execution::parallel_policy policy,
   auto d = std::distance(first, last);
   if (static_cast<std::size_t>(d) <= policy.cutoff_count) {
     auto seq_policy = execution::internal::to_sequenced_policy(policy);
-    for_each_aux(seq_policy, [&](auto&&... its) {
+    for_each_leaf_aux<is_chunk_op_v<AccumulateOp>>(seq_policy, [&](auto&&... its) {
       accumulate_op(acc, std::forward<decltype(its)>(its)...);
     }, first, last, firsts...);
     return acc;
@@ -135,7 +136,7 @@ inline void loop_generic(const execution::sequenced_policy& policy,
                          ForwardIterators...                firsts) {
   execution::internal::assert_policy(policy);
   auto seq_policy = execution::internal::to_sequenced_policy(policy);
-  for_each_aux(seq_policy, [&](auto&&... its) {
+  for_each_leaf_aux<is_chunk_op_v<Op>>(seq_policy, [&](auto&&... its) {
     op(std::forward<decltype(its)>(its)...);
   }, first, last, firsts...);
 }
@@ -163,7 +164,7 @@ inline auto reduce_generic(const execution::sequenced_policy& policy,
                            ForwardIterators...                firsts) {
   execution::internal::assert_policy(policy);
   auto seq_policy = execution::internal::to_sequenced_policy(policy);
-  for_each_aux(seq_policy, [&](auto&&... its) {
+  for_each_leaf_aux<is_chunk_op_v<AccumulateOp>>(seq_policy, [&](auto&&... its) {
     accumulate_op(acc, std::forward<decltype(its)>(its)...);
   }, first, last, firsts...);
   return acc;
@@ -330,6 +331,105 @@ inline void for_each(const ExecutionPolicy& policy,
   internal::loop_generic(policy, op, first1, last1, first2, first3);
 }
 
+/**
+ * @brief Apply an operator to each contiguous chunk in a range.
+ *
+ * @param policy Execution policy (`ityr::execution`).
+ * @param first  Begin iterator.
+ * @param last   End iterator.
+ * @param op     Operator for each chunk `[first_, last_)` in the range.
+ *
+ * This function is a chunked variant of `ityr::for_each()`. Instead of individual elements, the
+ * operator `op` is given a pair of iterators `(first_, last_)` that represents a subrange of
+ * `[first, last)`, and it is called for disjoint subranges that cover the entire range.
+ *
+ * If global iterators are given (by `ityr::make_global_iterator`), each chunk corresponds to a
+ * region checked out at a time (at most `ityr::execution::sequenced_policy::checkout_count` or
+ * `ityr::execution::parallel_policy::checkout_count` elements), and `op` receives raw pointers to
+ * the checked-out contiguous memory. Because checked-out regions keep the offsets of the global
+ * addresses within memory blocks, the raw pointers have the same alignment as the corresponding
+ * global addresses. This allows the compiler to vectorize simple loops over raw pointers in `op`.
+ *
+ * Example:
+ * ```
+ * ityr::global_vector<double> v(10000, 1.0);
+ * ityr::for_each_chunk(ityr::execution::parallel_policy{.cutoff_count = 1024, .checkout_count = 1024},
+ *                      ityr::make_global_iterator(v.begin(), ityr::checkout_mode::read_write),
+ *                      ityr::make_global_iterator(v.end()  , ityr::checkout_mode::read_write),
+ *                      [](double* first, double* last) {
+ *                        for (double* p = first; p != last; p++) *p *= 2.0;
+ *                      });
+ * // v = {2.0, 2.0, ..., 2.0}
+ * ```
+ *
+ * @see `ityr::for_each()`
+ * @see `ityr::transform_chunk()`
+ * @see `ityr::execution::sequenced_policy`, `ityr::execution::seq`,
+ *      `ityr::execution::parallel_policy`, `ityr::execution::par`
+ */
+template <typename ExecutionPolicy, typename ForwardIterator, typename Op>
+inline void for_each_chunk(const ExecutionPolicy& policy,
+                           ForwardIterator        first,
+                           ForwardIterator        last,
+                           Op                     op) {
+  internal::loop_generic(policy, internal::make_chunk_op(op), first, last);
+}
+
+/**
+ * @brief Apply an operator to each contiguous chunk in ranges.
+ *
+ * @param policy Execution policy (`ityr::execution`).
+ * @param first1 1st begin iterator.
+ * @param last1  1st end iterator.
+ * @param first2 2nd begin iterator.
+ * @param op     Operator for each chunk `[first1_, last1_)` and the corresponding `first2_`.
+ *
+ * The operator `op` is called as `op(first1_, last1_, first2_)` for disjoint subranges of the
+ * given ranges. See the single-range `ityr::for_each_chunk()` for details.
+ *
+ * @see `ityr::for_each()`
+ * @see `ityr::transform_chunk()`
+ * @see `ityr::execution::sequenced_policy`, `ityr::execution::seq`,
+ *      `ityr::execution::parallel_policy`, `ityr::execution::par`
+ */
+template <typename ExecutionPolicy, typename ForwardIterator1, typename ForwardIterator2, typename Op>
+inline void for_each_chunk(const ExecutionPolicy& policy,
+                           ForwardIterator1       first1,
+                           ForwardIterator1       last1,
+                           ForwardIterator2       first2,
+                           Op                     op) {
+  internal::loop_generic(policy, internal::make_chunk_op(op), first1, last1, first2);
+}
+
+/**
+ * @brief Apply an operator to each contiguous chunk in ranges.
+ *
+ * @param policy Execution policy (`ityr::execution`).
+ * @param first1 1st begin iterator.
+ * @param last1  1st end iterator.
+ * @param first2 2nd begin iterator.
+ * @param first3 3rd begin iterator.
+ * @param op     Operator for each chunk `[first1_, last1_)` and the corresponding `first2_` and `first3_`.
+ *
+ * The operator `op` is called as `op(first1_, last1_, first2_, first3_)` for disjoint subranges of
+ * the given ranges. See the single-range `ityr::for_each_chunk()` for details.
+ *
+ * @see `ityr::for_each()`
+ * @see `ityr::transform_chunk()`
+ * @see `ityr::execution::sequenced_policy`, `ityr::execution::seq`,
+ *      `ityr::execution::parallel_policy`, `ityr::execution::par`
+ */
+template <typename ExecutionPolicy, typename ForwardIterator1, typename ForwardIterator2,
+          typename ForwardIterator3, typename Op>
+inline void for_each_chunk(const ExecutionPolicy& policy,
+                           ForwardIterator1       first1,
+                           ForwardIterator1       last1,
+                           ForwardIterator2       first2,
+                           ForwardIterator3       first3,
+                           Op                     op) {
+  internal::loop_generic(policy, internal::make_chunk_op(op), first1, last1, first2, first3);
+}
+
 ITYR_TEST_CASE("[ityr::pattern::serial_loop] serial for_each") {
   class move_only_t {
   public:
@@ -504,6 +604,61 @@ ITYR_TEST_CASE("[ityr::pattern::serial_loop] serial for_each") {
   ori::fini();
 }
 
+ITYR_TEST_CASE("[ityr::pattern::serial_loop] serial for_each with checkout count near the cache size") {
+  common::singleton_initializer<ori::cache_size_option> cache_size_opt(std::size_t(1) << 20);
+  ori::init();
+
+  auto my_rank = common::topology::my_rank();
+  auto n_ranks = common::topology::n_ranks();
+
+  auto barrier = [] {
+    ori::release();
+    common::mpi_barrier(common::topology::mpicomm());
+    ori::acquire();
+  };
+
+  // The array is allocated on rank 0, so that other processes access it entirely through the cache
+  std::size_t cache_n = ori::cache_size() / sizeof(long);
+  long n = cache_n * 2;
+  ori::global_ptr<long> p;
+  if (my_rank == 0) {
+    p = ori::malloc<long>(n);
+  }
+  p = common::mpi_bcast_value(p, 0, common::topology::mpicomm());
+
+  // Chunks are checked out in a pipelined manner only if two of them fit in the cache
+  for (std::size_t c : {cache_n / 8, cache_n / 2, cache_n * 3 / 4}) {
+    execution::sequenced_policy policy {.checkout_count = c};
+
+    if (my_rank == n_ranks - 1) {
+      for_each(
+          policy,
+          count_iterator<long>(0),
+          count_iterator<long>(n),
+          make_global_iterator(p, checkout_mode::write),
+          [&](long i, long& out) { out = i + c; });
+    }
+
+    barrier();
+
+    long sum = 0;
+    for_each(
+        policy,
+        make_global_iterator(p    , checkout_mode::read),
+        make_global_iterator(p + n, checkout_mode::read),
+        [&](long v) { sum += v; });
+    ITYR_CHECK(sum == n * (n - 1) / 2 + n * long(c));
+
+    barrier();
+  }
+
+  if (my_rank == 0) {
+    ori::free(p, n);
+  }
+
+  ori::fini();
+}
+
 ITYR_TEST_CASE("[ityr::pattern::parallel_loop] parallel for_each") {
   ito::init();
   ori::init();
@@ -562,6 +717,66 @@ ITYR_TEST_CASE("[ityr::pattern::parallel_loop] parallel for_each") {
   ito::fini();
 }
 
+ITYR_TEST_CASE("[ityr::pattern::parallel_loop] parallel for_each_chunk") {
+  ito::init();
+  ori::init();
+
+  int n = 100000;
+  ori::global_ptr<int> p1 = ori::malloc_coll<int>(n);
+  ori::global_ptr<int> p2 = ori::malloc_coll<int>(n);
+
+  ito::root_exec([=] {
+    for_each_chunk(
+        execution::parallel_policy{.cutoff_count = 1000, .checkout_count = 100},
+        ityr::count_iterator<int>(0),
+        ityr::count_iterator<int>(n),
+        make_global_iterator(p1, checkout_mode::write),
+        [=](count_iterator<int> first, count_iterator<int> last, int* d) {
+          ITYR_CHECK(last - first <= 100);
+          for (int i = 0; i < last - first; i++) {
+            d[i] = first[i];
+          }
+        });
+
+    for_each_chunk(
+        execution::parallel_policy{.cutoff_count = 1000, .checkout_count = 1000},
+        make_global_iterator(p1    , checkout_mode::read),
+        make_global_iterator(p1 + n, checkout_mode::read),
+        make_global_iterator(p2    , checkout_mode::write),
+        [=](const int* first, const int* last, int* d) {
+          ITYR_CHECK(reinterpret_cast<uintptr_t>(first) % alignof(int) == 0);
+          for (std::size_t i = 0; i < std::size_t(last - first); i++) {
+            d[i] = first[i] * 2;
+          }
+        });
+
+    for_each(
+        execution::par,
+        ityr::count_iterator<int>(0),
+        ityr::count_iterator<int>(n),
+        make_global_iterator(p2, checkout_mode::read),
+        [=](int i, int y) { ITYR_CHECK(y == i * 2); });
+
+    long count = 0;
+    for_each_chunk(
+        execution::sequenced_policy{.checkout_count = 300},
+        make_global_iterator(p2    , checkout_mode::read),
+        make_global_iterator(p2 + n, checkout_mode::read),
+        [&](const int* first, const int* last) {
+          for (; first != last; first++) {
+            count += *first;
+          }
+        });
+    ITYR_CHECK(count == long(n) * (n - 1));
+  });
+
+  ori::free_coll(p1);
+  ori::free_coll(p2);
+
+  ori::fini();
+  ito::fini();
+}
+
 /**
  * @brief Calculate reduction while transforming each element.
  *
@@ -622,17 +837,34 @@ inline T transform_reduce(const ExecutionPolicy& policy,
     return transform_reduce(policy, first_, last_, identity, binary_reduce_op, unary_transform_op);
   }
 
-  auto accumulate_op = [=](T& acc, const auto& v) {
-    acc = binary_reduce_op(acc, unary_transform_op(v));
-  };
-
   auto combine_op = [=](const auto& acc1, const auto& acc2,
                         ForwardIterator, ForwardIterator, ForwardIterator) {
     return binary_reduce_op(acc1, acc2);
   };
 
-  return internal::reduce_generic(policy, accumulate_op, combine_op, identity,
-                                  identity, first, last);
+  if constexpr (std::is_arithmetic_v<T> &&
+                internal::is_vectorizable_leaf_v<ForwardIterator>) {
+    // Reduce each contiguous chunk with a tight loop over raw pointers
+    auto accumulate_op = internal::make_chunk_op([=](T& acc, auto first_, auto last_) {
+      std::size_t n = std::distance(first_, last_);
+      T acc_ = acc;
+      for (std::size_t i = 0; i < n; i++) {
+        acc_ = binary_reduce_op(acc_, unary_transform_op(first_[i]));
+      }
+      acc = acc_;
+    });
+
+    return internal::reduce_generic(policy, accumulate_op, combine_op, identity,
+                                    identity, first, last);
+
+  } else {
+    auto accumulate_op = [=](T& acc, const auto& v) {
+      acc = binary_reduce_op(acc, unary_transform_op(v));
+    };
+
+    return internal::reduce_generic(policy, accumulate_op, combine_op, identity,
+                                    identity, first, last);
+  }
 }
 
 /**
@@ -709,17 +941,34 @@ inline T transform_reduce(const ExecutionPolicy& policy,
     return transform_reduce(policy, first1, last1, first2_, identity, binary_reduce_op, binary_transform_op);
   }
 
-  auto accumulate_op = [=](T& acc, const auto& v1, const auto& v2) {
-    acc = binary_reduce_op(acc, binary_transform_op(v1, v2));
-  };
-
   auto combine_op = [=](const auto& acc1, const auto& acc2,
                         ForwardIterator1, ForwardIterator1, ForwardIterator1, ForwardIterator2) {
     return binary_reduce_op(acc1, acc2);
   };
 
-  return internal::reduce_generic(policy, accumulate_op, combine_op, identity,
-                                  identity, first1, last1, first2);
+  if constexpr (std::is_arithmetic_v<T> &&
+                internal::is_vectorizable_leaf_v<ForwardIterator1, ForwardIterator2>) {
+    // Reduce each contiguous chunk with a tight loop over raw pointers
+    auto accumulate_op = internal::make_chunk_op([=](T& acc, auto first1_, auto last1_, auto first2_) {
+      std::size_t n = std::distance(first1_, last1_);
+      T acc_ = acc;
+      for (std::size_t i = 0; i < n; i++) {
+        acc_ = binary_reduce_op(acc_, binary_transform_op(first1_[i], first2_[i]));
+      }
+      acc = acc_;
+    });
+
+    return internal::reduce_generic(policy, accumulate_op, combine_op, identity,
+                                    identity, first1, last1, first2);
+
+  } else {
+    auto accumulate_op = [=](T& acc, const auto& v1, const auto& v2) {
+      acc = binary_reduce_op(acc, binary_transform_op(v1, v2));
+    };
+
+    return internal::reduce_generic(policy, accumulate_op, combine_op, identity,
+                                    identity, first1, last1, first2);
+  }
 }
 
 /**
@@ -932,11 +1181,23 @@ inline ForwardIteratorD transform(const ExecutionPolicy& policy,
     return transform(policy, first1, last1, first_d_, unary_op);
   }
 
-  auto op = [=](const auto& v1, auto&& d) {
-    d = unary_op(v1);
-  };
+  if constexpr (internal::is_vectorizable_leaf_v<ForwardIterator1, ForwardIteratorD>) {
+    auto op = [=](auto first1_, auto last1_, auto first_d_) {
+      std::size_t n = std::distance(first1_, last1_);
+      for (std::size_t i = 0; i < n; i++) {
+        first_d_[i] = unary_op(first1_[i]);
+      }
+    };
+
+    internal::loop_generic(policy, internal::make_chunk_op(op), first1, last1, first_d);
 
-  internal::loop_generic(policy, op, first1, last1, first_d);
+  } else {
+    auto op = [=](const auto& v1, auto&& d) {
+      d = unary_op(v1);
+    };
+
+    internal::loop_generic(policy, op, first1, last1, first_d);
+  }
 
   return std::next(first_d, std::distance(first1, last1));
 }
@@ -1028,11 +1289,174 @@ inline ForwardIteratorD transform(const ExecutionPolicy& policy,
     return transform(policy, first1, last1, first2, first_d_, binary_op);
   }
 
-  auto op = [=](const auto& v1, const auto& v2, auto&& d) {
-    d = binary_op(v1, v2);
-  };
+  if constexpr (internal::is_vectorizable_leaf_v<ForwardIterator1, ForwardIterator2, ForwardIteratorD>) {
+    auto op = [=](auto first1_, auto last1_, auto first2_, auto first_d_) {
+      std::size_t n = std::distance(first1_, last1_);
+      for (std::size_t i = 0; i < n; i++) {
+        first_d_[i] = binary_op(first1_[i], first2_[i]);
+      }
+    };
 
-  internal::loop_generic(policy, op, first1, last1, first2, first_d);
+    internal::loop_generic(policy, internal::make_chunk_op(op), first1, last1, first2, first_d);
+
+  } else {
+    auto op = [=](const auto& v1, const auto& v2, auto&& d) {
+      d = binary_op(v1, v2);
+    };
+
+    internal::loop_generic(policy, op, first1, last1, first2, first_d);
+  }
+
+  return std::next(first_d, std::distance(first1, last1));
+}
+
+/**
+ * @brief Transform contiguous chunks in a given range and store them in another range.
+ *
+ * @param policy   Execution policy (`ityr::execution`).
+ * @param first1   Input begin iterator.
+ * @param last1    Input end iterator.
+ * @param first_d  Output begin iterator.
+ * @param chunk_op Operator to transform each chunk.
+ *
+ * @return The end iterator of the output range (`first_d + (last1 - first1)`).
+ *
+ * This function is a chunked variant of `ityr::transform()`. The operator `chunk_op` is called as
+ * `chunk_op(first1_, last1_, first_d_)` for disjoint subranges of the input range, and it should
+ * store the results for `[first1_, last1_)` to `[first_d_, first_d_ + (last1_ - first1_))`.
+ *
+ * Global pointers are automatically checked out in the same way as in `ityr::transform()`, and
+ * `chunk_op` receives raw pointers to the checked-out contiguous memory, which have the same
+ * alignment as the corresponding global addresses.
+ *
+ * Example:
+ * ```
+ * ityr::global_vector<double> v1(10000, 1.0);
+ * ityr::global_vector<double> v2(v1.size());
+ * ityr::transform_chunk(ityr::execution::parallel_policy{.cutoff_count = 1024, .checkout_count = 1024},
+ *                       v1.begin(), v1.end(), v2.begin(),
+ *                       [](const double* first, const double* last, double* d) {
+ *                         for (; first != last; first++, d++) *d = *first * 3.0;
+ *                       });
+ * // v2 = {3.0, 3.0, ..., 3.0}
+ * ```
+ *
+ * @see `ityr::transform()`
+ * @see `ityr::for_each_chunk()`
+ * @see `ityr::execution::sequenced_policy`, `ityr::execution::seq`,
+ *      `ityr::execution::parallel_policy`, `ityr::execution::par`
+ */
+template <typename ExecutionPolicy, typename ForwardIterator1,
+          typename ForwardIteratorD, typename ChunkOp>
+inline ForwardIteratorD transform_chunk(const ExecutionPolicy& policy,
+                                        ForwardIterator1       first1,
+                                        ForwardIterator1       last1,
+                                        ForwardIteratorD       first_d,
+                                        ChunkOp                chunk_op) {
+  if constexpr (is_global_iterator_v<ForwardIterator1>) {
+    static_assert(std::is_same_v<typename ForwardIterator1::mode, checkout_mode::read_t> ||
+                  std::is_same_v<typename ForwardIterator1::mode, checkout_mode::no_access_t>);
+
+  } else if constexpr (ori::is_global_ptr_v<ForwardIterator1>) {
+    // automatically convert global pointers to global iterators with read-only access
+    auto first1_ = make_global_iterator(first1, checkout_mode::read);
+    auto last1_  = make_global_iterator(last1 , checkout_mode::read);
+    return transform_chunk(policy, first1_, last1_, first_d, chunk_op);
+  }
+
+  // If the destination value type is trivially copyable, write-only access is possible
+  using value_type_d = typename std::iterator_traits<ForwardIteratorD>::value_type;
+  using checkout_mode_d = std::conditional_t<std::is_trivially_copyable_v<value_type_d>,
+                                             checkout_mode::write_t,
+                                             checkout_mode::read_write_t>;
+  if constexpr (is_global_iterator_v<ForwardIteratorD>) {
+    static_assert(std::is_same_v<typename ForwardIteratorD::mode, checkout_mode_d> ||
+                  std::is_same_v<typename ForwardIteratorD::mode, checkout_mode::no_access_t>);
+
+  } else if constexpr (ori::is_global_ptr_v<ForwardIteratorD>) {
+    // automatically convert global pointers to global iterators
+    auto first_d_ = make_global_iterator(first_d, checkout_mode_d{});
+    return transform_chunk(policy, first1, last1, first_d_, chunk_op);
+  }
+
+  if constexpr (!ori::is_global_ptr_v<ForwardIterator1> && !ori::is_global_ptr_v<ForwardIteratorD>) {
+    // `chunk_op` may not be callable with global pointers, so it is instantiated only after conversion
+    internal::loop_generic(policy, internal::make_chunk_op(chunk_op), first1, last1, first_d);
+  }
+
+  return std::next(first_d, std::distance(first1, last1));
+}
+
+/**
+ * @brief Transform contiguous chunks in given ranges and store them in another range.
+ *
+ * @param policy   Execution policy (`ityr::execution`).
+ * @param first1   1st input begin iterator.
+ * @param last1    1st input end iterator.
+ * @param first2   2nd input begin iterator.
+ * @param first_d  Output begin iterator.
+ * @param chunk_op Operator to transform each pair of chunks.
+ *
+ * @return The end iterator of the output range (`first_d + (last1 - first1)`).
+ *
+ * The operator `chunk_op` is called as `chunk_op(first1_, last1_, first2_, first_d_)` for disjoint
+ * subranges of the input ranges. See the unary `ityr::transform_chunk()` for details.
+ *
+ * @see `ityr::transform()`
+ * @see `ityr::for_each_chunk()`
+ * @see `ityr::execution::sequenced_policy`, `ityr::execution::seq`,
+ *      `ityr::execution::parallel_policy`, `ityr::execution::par`
+ */
+template <typename ExecutionPolicy, typename ForwardIterator1, typename ForwardIterator2,
+          typename ForwardIteratorD, typename ChunkOp>
+inline ForwardIteratorD transform_chunk(const ExecutionPolicy& policy,
+                                        ForwardIterator1       first1,
+                                        ForwardIterator1       last1,
+                                        ForwardIterator2       first2,
+                                        ForwardIteratorD       first_d,
+                                        ChunkOp                chunk_op) {
+  if constexpr (is_global_iterator_v<ForwardIterator1>) {
+    static_assert(std::is_same_v<typename ForwardIterator1::mode, checkout_mode::read_t> ||
+                  std::is_same_v<typename ForwardIterator1::mode, checkout_mode::no_access_t>);
+
+  } else if constexpr (ori::is_global_ptr_v<ForwardIterator1>) {
+    // automatically convert global pointers to global iterators with read-only access
+    auto first1_ = make_global_iterator(first1, checkout_mode::read);
+    auto last1_  = make_global_iterator(last1 , checkout_mode::read);
+    return transform_chunk(policy, first1_, last1_, first2, first_d, chunk_op);
+  }
+
+  if constexpr (is_global_iterator_v<ForwardIterator2>) {
+    static_assert(std::is_same_v<typename ForwardIterator2::mode, checkout_mode::read_t> ||
+                  std::is_same_v<typename ForwardIterator2::mode, checkout_mode::no_access_t>);
+
+  } else if constexpr (ori::is_global_ptr_v<ForwardIterator2>) {
+    // automatically convert global pointers to global iterators with read-only access
+    auto first2_ = make_global_iterator(first2, checkout_mode::read);
+    return transform_chunk(policy, first1, last1, first2_, first_d, chunk_op);
+  }
+
+  // If the destination value type is trivially copyable, write-only access is possible
+  using value_type_d = typename std::iterator_traits<ForwardIteratorD>::value_type;
+  using checkout_mode_d = std::conditional_t<std::is_trivially_copyable_v<value_type_d>,
+                                             checkout_mode::write_t,
+                                             checkout_mode::read_write_t>;
+  if constexpr (is_global_iterator_v<ForwardIteratorD>) {
+    static_assert(std::is_same_v<typename ForwardIteratorD::mode, checkout_mode_d> ||
+                  std::is_same_v<typename ForwardIteratorD::mode, checkout_mode::no_access_t>);
+
+  } else if constexpr (ori::is_global_ptr_v<ForwardIteratorD>) {
+    // automatically convert global pointers to global iterators
+    auto first_d_ = make_global_iterator(first_d, checkout_mode_d{});
+    return transform_chunk(policy, first1, last1, first2, first_d_, chunk_op);
+  }
+
+  if constexpr (!ori::is_global_ptr_v<ForwardIterator1> &&
+                !ori::is_global_ptr_v<ForwardIterator2> &&
+                !ori::is_global_ptr_v<ForwardIteratorD>) {
+    // `chunk_op` may not be callable with global pointers, so it is instantiated only after conversion
+    internal::loop_generic(policy, internal::make_chunk_op(chunk_op), first1, last1, first2, first_d);
+  }
 
   return std::next(first_d, std::distance(first1, last1));
 }
@@ -1085,31 +1509,280 @@ inline void fill(const ExecutionPolicy& policy,
     return;
   }
 
-  auto op = [=](auto&& d) {
-    d = value;
-  };
+  if constexpr (std::is_arithmetic_v<T> &&
+                internal::is_vectorizable_leaf_v<ForwardIterator>) {
+    auto op = [=](auto first_, auto last_) {
+      std::fill(first_, last_, value);
+    };
 
-  internal::loop_generic(policy, op, first, last);
+    internal::loop_generic(policy, internal::make_chunk_op(op), first, last);
+
+  } else {
+    auto op = [=](auto&& d) {
+      d = value;
+    };
+
+    internal::loop_generic(policy, op, first, last);
+  }
 }
 
 /**
- * @brief Calculate a prefix sum (inclusive scan) while transforming each element.
+ * @brief Assign values generated by a function object to each element in a range.
  *
- * @param policy             Execution policy (`ityr::execution`).
- * @param first1             Input begin iterator.
- * @param last1              Input end iterator.
- * @param first_d            Output begin iterator.
- * @param identity           Identity element.
- * @param binary_op          Associative binary operator.
- * @param unary_transform_op Unary operator to transform each element.
- * @param init               Initial value for the prefix sum.
+ * @param policy Execution policy (`ityr::execution`).
+ * @param first  Begin iterator.
+ * @param last   End iterator.
+ * @param gen    Generator function object with no arguments.
  *
- * @return The end iterator of the output range (`first_d + (last1 - first1)`).
+ * This function assigns `gen()` to every element in the given range `[first, last)`.
+ * In parallel execution, `gen` is copied to each task, so the generator should not rely on its
+ * internal state (e.g., a stateful random number engine) to produce distinct or ordered values.
+ * Use `ityr::fill_random()` to fill a range with random numbers.
  *
- * This function applies `unary_transform_op` to each element in the range `[first1, last1)` and
- * calculates a prefix sum over them. The prefix sum is inclusive, which means that the i-th element
- * of the prefix sum includes the i-th element in the input range. That is, the i-th element of the
- * prefix sum is: `init + f(*first1) + ... + f(*(first1 + i))`, where `+` is the associative binary
+ * If global pointers are provided as iterators, they are automatically checked out with the write-only
+ * mode (if the value type is trivially copyable) in the specified granularity
+ * (`ityr::execution::sequenced_policy::checkout_count` if serial,
+ * or `ityr::execution::parallel_policy::checkout_count` if parallel) without explicitly passing them
+ * as global iterators.
+ *
+ * Example:
+ * ```
+ * ityr::global_vector<int> v(5);
+ * ityr::generate(ityr::execution::par, v.begin(), v.end(), [] { return 3; });
+ * // v = {3, 3, 3, 3, 3}
+ * ```
+ *
+ * @see [std::generate -- cppreference.com](https://en.cppreference.com/w/cpp/algorithm/generate)
+ * @see `ityr::fill()`
+ * @see `ityr::fill_random()`
+ * @see `ityr::execution::sequenced_policy`, `ityr::execution::seq`,
+ *      `ityr::execution::parallel_policy`, `ityr::execution::par`
+ */
+template <typename ExecutionPolicy, typename ForwardIterator, typename Generator>
+inline void generate(const ExecutionPolicy& policy,
+                     ForwardIterator        first,
+                     ForwardIterator        last,
+                     Generator              gen) {
+  using value_type = typename std::iterator_traits<ForwardIterator>::value_type;
+
+  // If the value type is trivially copyable, write-only access is possible
+  using checkout_mode_t = std::conditional_t<std::is_trivially_copyable_v<value_type>,
+                                             checkout_mode::write_t,
+                                             checkout_mode::read_write_t>;
+  if constexpr (is_global_iterator_v<ForwardIterator>) {
+    static_assert(std::is_same_v<typename ForwardIterator::mode, checkout_mode_t> ||
+                  std::is_same_v<typename ForwardIterator::mode, checkout_mode::no_access_t>);
+
+  } else if constexpr (ori::is_global_ptr_v<ForwardIterator>) {
+    // automatically convert global pointers to global iterators
+    auto first_ = make_global_iterator(first, checkout_mode_t{});
+    auto last_  = make_global_iterator(last , checkout_mode_t{});
+    generate(policy, first_, last_, gen);
+    return;
+  }
+
+  auto op = [=](auto&& d) mutable {
+    d = gen();
+  };
+
+  internal::loop_generic(policy, op, first, last);
+}
+
+/**
+ * @brief Fill a range with sequentially increasing values.
+ *
+ * @param policy Execution policy (`ityr::execution`).
+ * @param first  Begin iterator.
+ * @param last   End iterator.
+ * @param value  Initial value.
+ *
+ * This function assigns `value + i` to the i-th element in the given range `[first, last)`.
+ * Unlike the standard `std::iota()`, which repeatedly applies `++value`, the value of each element
+ * is computed from its index so that the range can be filled in parallel. Thus, the type `T` must
+ * support addition with an integer.
+ *
+ * If global pointers are provided as iterators, they are automatically checked out with the write-only
+ * mode (if the value type is trivially copyable) in the specified granularity
+ * (`ityr::execution::sequenced_policy::checkout_count` if serial,
+ * or `ityr::execution::parallel_policy::checkout_count` if parallel) without explicitly passing them
+ * as global iterators.
+ *
+ * Example:
+ * ```
+ * ityr::global_vector<int> v(5);
+ * ityr::iota(ityr::execution::par, v.begin(), v.end(), 10);
+ * // v = {10, 11, 12, 13, 14}
+ * ```
+ *
+ * @see [std::iota -- cppreference.com](https://en.cppreference.com/w/cpp/algorithm/iota)
+ * @see `ityr::count_iterator`
+ * @see `ityr::execution::sequenced_policy`, `ityr::execution::seq`,
+ *      `ityr::execution::parallel_policy`, `ityr::execution::par`
+ */
+template <typename ExecutionPolicy, typename ForwardIterator, typename T>
+inline void iota(const ExecutionPolicy& policy,
+                 ForwardIterator        first,
+                 ForwardIterator        last,
+                 const T&               value) {
+  using value_type = typename std::iterator_traits<ForwardIterator>::value_type;
+
+  // If the value type is trivially copyable, write-only access is possible
+  using checkout_mode_t = std::conditional_t<std::is_trivially_copyable_v<value_type>,
+                                             checkout_mode::write_t,
+                                             checkout_mode::read_write_t>;
+  if constexpr (is_global_iterator_v<ForwardIterator>) {
+    static_assert(std::is_same_v<typename ForwardIterator::mode, checkout_mode_t> ||
+                  std::is_same_v<typename ForwardIterator::mode, checkout_mode::no_access_t>);
+
+  } else if constexpr (ori::is_global_ptr_v<ForwardIterator>) {
+    // automatically convert global pointers to global iterators
+    auto first_ = make_global_iterator(first, checkout_mode_t{});
+    auto last_  = make_global_iterator(last , checkout_mode_t{});
+    iota(policy, first_, last_, value);
+    return;
+  }
+
+  using diff_t = typename std::iterator_traits<ForwardIterator>::difference_type;
+
+  if constexpr (std::is_arithmetic_v<T> &&
+                internal::is_vectorizable_leaf_v<ForwardIterator>) {
+    auto op = [=](auto first_, auto last_, auto first_i) {
+      diff_t n_ = std::distance(first_, last_);
+      diff_t i0 = *first_i;
+      for (diff_t i = 0; i < n_; i++) {
+        first_[i] = static_cast<value_type>(value + static_cast<T>(i0 + i));
+      }
+    };
+
+    internal::loop_generic(policy, internal::make_chunk_op(op), first, last,
+                           count_iterator<diff_t>(0));
+
+  } else {
+    auto op = [=](auto&& d, diff_t i) {
+      d = value + i;
+    };
+
+    internal::loop_generic(policy, op, first, last, count_iterator<diff_t>(0));
+  }
+}
+
+/**
+ * @brief Fill a range with random numbers.
+ *
+ * @param policy Execution policy (`ityr::execution`).
+ * @param first  Begin iterator.
+ * @param last   End iterator.
+ * @param seed   Seed for the random number generator.
+ * @param dist   Random number distribution (e.g., `std::uniform_int_distribution`).
+ *
+ * This function assigns `dist(engine)` to each element in the given range `[first, last)`, where
+ * `engine` is a counter-based random number engine (`ityr::philox4x32`) whose stream is determined
+ * by `seed` and the index of the element. As each element is generated independently of the others,
+ * the range can be filled in parallel without communication, and the result is deterministic for
+ * the same seed regardless of the execution policy and the number of processes.
+ *
+ * If global pointers are provided as iterators, they are automatically checked out with the write-only
+ * mode (if the value type is trivially copyable) in the specified granularity
+ * (`ityr::execution::sequenced_policy::checkout_count` if serial,
+ * or `ityr::execution::parallel_policy::checkout_count` if parallel) without explicitly passing them
+ * as global iterators. Thus, no data is fetched from remote memory.
+ *
+ * Example:
+ * ```
+ * ityr::global_vector<int> v(10000);
+ * ityr::fill_random(ityr::execution::par, v.begin(), v.end(), 42,
+ *                   std::uniform_int_distribution<int>(0, 99));
+ * // v = {[0, 99] random numbers}
+ * ```
+ *
+ * @see `ityr::philox4x32`
+ * @see `ityr::generate()`
+ * @see `ityr::execution::sequenced_policy`, `ityr::execution::seq`,
+ *      `ityr::execution::parallel_policy`, `ityr::execution::par`
+ */
+template <typename ExecutionPolicy, typename ForwardIterator, typename Distribution>
+inline void fill_random(const ExecutionPolicy& policy,
+                        ForwardIterator        first,
+                        ForwardIterator        last,
+                        std::uint64_t          seed,
+                        Distribution           dist) {
+  using value_type = typename std::iterator_traits<ForwardIterator>::value_type;
+
+  // If the value type is trivially copyable, write-only access is possible
+  using checkout_mode_t = std::conditional_t<std::is_trivially_copyable_v<value_type>,
+                                             checkout_mode::write_t,
+                                             checkout_mode::read_write_t>;
+  if constexpr (is_global_iterator_v<ForwardIterator>) {
+    static_assert(std::is_same_v<typename ForwardIterator::mode, checkout_mode_t> ||
+                  std::is_same_v<typename ForwardIterator::mode, checkout_mode::no_access_t>);
+
+  } else if constexpr (ori::is_global_ptr_v<ForwardIterator>) {
+    // automatically convert global pointers to global iterators
+    auto first_ = make_global_iterator(first, checkout_mode_t{});
+    auto last_  = make_global_iterator(last , checkout_mode_t{});
+    fill_random(policy, first_, last_, seed, dist);
+    return;
+  }
+
+  auto op = [=](auto&& d, std::uint64_t i) {
+    // Distributions may have internal state (e.g., cached values of `std::normal_distribution`),
+    // so a fresh copy is used for each element to make the result independent of the partitioning
+    philox4x32 engine(seed, i);
+    Distribution dist_ = dist;
+    d = dist_(engine);
+  };
+
+  internal::loop_generic(policy, op, first, last, count_iterator<std::uint64_t>(0));
+}
+
+/**
+ * @brief Fill a range with uniformly distributed random numbers.
+ *
+ * @param policy Execution policy (`ityr::execution`).
+ * @param first  Begin iterator.
+ * @param last   End iterator.
+ * @param seed   Seed for the random number generator.
+ *
+ * Integers are uniformly distributed over `[0, std::numeric_limits<T>::max()]`, and floating-point
+ * numbers are uniformly distributed over `[0, 1)`, where `T` is the value type of the iterator.
+ *
+ * @see `ityr::fill_random()`
+ */
+template <typename ExecutionPolicy, typename ForwardIterator>
+inline void fill_random(const ExecutionPolicy& policy,
+                        ForwardIterator        first,
+                        ForwardIterator        last,
+                        std::uint64_t          seed) {
+  using value_type = typename std::iterator_traits<ForwardIterator>::value_type;
+  static_assert(std::is_arithmetic_v<value_type>);
+
+  if constexpr (std::is_integral_v<value_type>) {
+    fill_random(policy, first, last, seed,
+                std::uniform_int_distribution<value_type>(0, std::numeric_limits<value_type>::max()));
+  } else {
+    fill_random(policy, first, last, seed,
+                std::uniform_real_distribution<value_type>(0, 1));
+  }
+}
+
+/**
+ * @brief Calculate a prefix sum (inclusive scan) while transforming each element.
+ *
+ * @param policy             Execution policy (`ityr::execution`).
+ * @param first1             Input begin iterator.
+ * @param last1              Input end iterator.
+ * @param first_d            Output begin iterator.
+ * @param identity           Identity element.
+ * @param binary_op          Associative binary operator.
+ * @param unary_transform_op Unary operator to transform each element.
+ * @param init               Initial value for the prefix sum.
+ *
+ * @return The end iterator of the output range (`first_d + (last1 - first1)`).
+ *
+ * This function applies `unary_transform_op` to each element in the range `[first1, last1)` and
+ * calculates a prefix sum over them. The prefix sum is inclusive, which means that the i-th element
+ * of the prefix sum includes the i-th element in the input range. That is, the i-th element of the
+ * prefix sum is: `init + f(*first1) + ... + f(*(first1 + i))`, where `+` is the associative binary
  * operator (`binary_op`) and `f()` is the transform operator (`unary_transform_op`).
  * The calculated prefix sum is stored in the output range `[first_d, first_d + (last1 - first1))`.
  *
@@ -1401,114 +2074,855 @@ inline ForwardIteratorD inclusive_scan(const ExecutionPolicy& policy,
   return inclusive_scan(policy, first1, last1, first_d, value_type{}, std::plus<>{});
 }
 
-ITYR_TEST_CASE("[ityr::pattern::parallel_loop] reduce and transform_reduce") {
-  ito::init();
-  ori::init();
+namespace internal {
 
-  ITYR_SUBCASE("default cutoff") {
-    long n = 10000;
-    long r = ito::root_exec([=] {
-      return reduce(
-          execution::par,
-          ityr::count_iterator<long>(0),
-          ityr::count_iterator<long>(n));
-    });
-    ITYR_CHECK(r == n * (n - 1) / 2);
+/*
+ * Shared cancellation flag for short-circuiting search algorithms.
+ *
+ * The flag holds the smallest index of an element found so far (or `n` if not found) and is
+ * allocated in global memory so that tasks migrated to other processes can see it. It is accessed
+ * only by atomic operations bypassing the cache, and is updated by a fetch-and-min (CAS loop).
+ * It is only used as a hint to skip leaf ranges, and the actual result is always determined by the
+ * reduction over leaf results.
+ */
+class search_cancel_flag {
+public:
+  search_cancel_flag(std::size_t n, bool enabled)
+    : n_(n), flag_(enabled && ori::support_atomic ? ori::malloc<std::size_t>(1) : ori::global_ptr<std::size_t>{}) {
+    if (flag_) {
+      ori::atomic_put(n_, flag_);
+    }
   }
 
-  ITYR_SUBCASE("custom cutoff") {
-    long n = 100000;
-    long r = ito::root_exec([=] {
-      return reduce(
-          execution::parallel_policy{.cutoff_count = 100},
-          ityr::count_iterator<long>(0),
-          ityr::count_iterator<long>(n));
-    });
-    ITYR_CHECK(r == n * (n - 1) / 2);
+  void destroy() const {
+    if (flag_) {
+      ori::free(flag_, 1);
+    }
   }
 
-  ITYR_SUBCASE("transform unary") {
-    long n = 100000;
-    long r = ito::root_exec([=] {
-      return transform_reduce(
-          execution::parallel_policy{.cutoff_count = 100},
-          ityr::count_iterator<long>(0),
-          ityr::count_iterator<long>(n),
-          long(0),
-          std::plus<long>{},
-          [](long x) { return x * x; });
-    });
-    ITYR_CHECK(r == n * (n - 1) * (2 * n - 1) / 6);
+  std::size_t get() const {
+    if (!flag_) return n_;
+    return ori::atomic_get(flag_);
   }
 
-  ITYR_SUBCASE("transform binary") {
-    long n = 100000;
-    long r = ito::root_exec([=] {
-      return transform_reduce(
-          execution::parallel_policy{.cutoff_count = 100},
-          ityr::count_iterator<long>(0),
-          ityr::count_iterator<long>(n),
-          ityr::count_iterator<long>(0),
-          long(0),
-          std::plus<long>{},
-          [](long x, long y) { return x * y; });
-    });
-    ITYR_CHECK(r == n * (n - 1) * (2 * n - 1) / 6);
+  void notify(std::size_t index) const {
+    if (!flag_) return;
+    std::size_t cur = get();
+    while (index < cur) {
+      std::size_t prev = ori::atomic_cas(index, cur, flag_);
+      if (prev == cur) break;
+      cur = prev;
+    }
   }
 
-  ITYR_SUBCASE("zero elements") {
-    long r = ito::root_exec([=] {
-      return reduce(
-          execution::parallel_policy{.cutoff_count = 100},
-          ityr::count_iterator<long>(0),
-          ityr::count_iterator<long>(0),
-          long(30));
-    });
-    ITYR_CHECK(r == 30);
+private:
+  std::size_t                   n_;
+  ori::global_ptr<std::size_t> flag_;
+};
+
+/*
+ * Returns the index of the first element in `[first + b, first + e)` that satisfies `pred`, or `n`
+ * if not found. Before checking out each chunk, the leaf consults the cancellation flag and stops
+ * if a preceding element (or any element if `AnyHit` is true) has already been found.
+ */
+template <bool AnyHit, typename ForwardIterator, typename Pred>
+inline std::size_t search_leaf(const execution::sequenced_policy& policy,
+                               const search_cancel_flag&          cflag,
+                               std::size_t                        n,
+                               ForwardIterator                    first,
+                               std::size_t                        b,
+                               std::size_t                        e,
+                               Pred                               pred) {
+  std::size_t c = policy.checkout_count;
+
+  for (std::size_t d = b; d < e; d += c) {
+    std::size_t found = cflag.get();
+    if (AnyHit ? found != n : found < d) {
+      return n;
+    }
+
+    auto n_ = std::min(e - d, c);
+    auto it = std::next(first, d);
+
+    std::size_t idx = n;
+    for_each_chunk_aux(policy, [&](auto first_, auto last_) {
+      std::size_t i = d;
+      for (; first_ != last_; ++first_, ++i) {
+        if (pred(*first_)) {
+          idx = i;
+          break;
+        }
+      }
+    }, it, std::next(it, n_));
+
+    if (idx != n) {
+      cflag.notify(idx);
+      return idx;
+    }
   }
 
-  ori::fini();
-  ito::fini();
+  return n;
 }
 
-ITYR_TEST_CASE("[ityr::pattern::parallel_loop] parallel reduce with global_ptr") {
-  ito::init();
-  ori::init();
+template <bool AnyHit, typename ExecutionPolicy, typename ForwardIterator, typename Pred>
+inline std::size_t search_generic(const ExecutionPolicy& policy,
+                                  ForwardIterator        first,
+                                  ForwardIterator        last,
+                                  Pred                   pred) {
+  std::size_t n = std::distance(first, last);
+  if (n == 0) return 0;
 
-  long n = 100000;
-  ori::global_ptr<long> p = ori::malloc_coll<long>(n);
+  constexpr bool is_parallel = std::is_same_v<ExecutionPolicy, execution::parallel_policy>;
+  search_cancel_flag cflag(n, is_parallel);
 
-  ito::root_exec([=] {
-    long count = 0;
-    for_each(
-        execution::sequenced_policy{.checkout_count = 100},
-        make_global_iterator(p    , checkout_mode::write),
-        make_global_iterator(p + n, checkout_mode::write),
-        [&](long& v) { v = count++; });
+  auto seq_policy = execution::internal::to_sequenced_policy(policy);
+
+  // Leaf ranges are given as indices so that global iterators are checked out inside `search_leaf()`
+  // only if the search is not cancelled.
+  auto accumulate_op = make_chunk_op([=](std::size_t& acc, count_iterator<std::size_t> b,
+                                                           count_iterator<std::size_t> e) {
+    // Skip if already found in the preceding range (serialized execution)
+    if (acc == n) {
+      acc = search_leaf<AnyHit>(seq_policy, cflag, n, first, *b, *e, pred);
+    }
   });
 
-  ITYR_SUBCASE("default cutoff") {
-    long r = ito::root_exec([=] {
-      return reduce(
-          execution::par,
-          p, p + n);
-    });
-    ITYR_CHECK(r == n * (n - 1) / 2);
-  }
+  auto combine_op = [](std::size_t acc1, std::size_t acc2,
+                       count_iterator<std::size_t>, count_iterator<std::size_t>, count_iterator<std::size_t>) {
+    return std::min(acc1, acc2);
+  };
 
-  ITYR_SUBCASE("custom cutoff and checkout count") {
-    long r = ito::root_exec([=] {
-      return reduce(
-          execution::parallel_policy{.cutoff_count = 100, .checkout_count = 50},
-          p, p + n);
-    });
-    ITYR_CHECK(r == n * (n - 1) / 2);
-  }
+  std::size_t ret = reduce_generic(policy, accumulate_op, combine_op, n, n,
+                                   count_iterator<std::size_t>(0), count_iterator<std::size_t>(n));
 
-  ITYR_SUBCASE("without auto checkout") {
-    long r = ito::root_exec([=] {
-      return transform_reduce(
-          execution::par,
+  cflag.destroy();
+
+  return ret;
+}
+
+template <typename T>
+struct element_acc {
+  std::size_t index;
+  T           value;
+};
+
+/*
+ * Reduction for `min_element()`/`max_element()`. `Better(a, b)` returns true if the value `a` at a
+ * larger index should replace the value `b` at a smaller index.
+ */
+template <typename ExecutionPolicy, typename ForwardIterator, typename Better>
+inline std::size_t select_element_generic(const ExecutionPolicy& policy,
+                                          ForwardIterator        first,
+                                          ForwardIterator        last,
+                                          Better                 better) {
+  using value_type = typename std::iterator_traits<ForwardIterator>::value_type;
+  using acc_t = element_acc<value_type>;
+
+  std::size_t n = std::distance(first, last);
+
+  auto accumulate_op = [=](acc_t& acc, std::size_t i, const auto& v) {
+    if (acc.index == n || better(v, acc.value)) {
+      acc = acc_t{i, v};
+    }
+  };
+
+  auto combine_op = [=](const acc_t& acc1, const acc_t& acc2,
+                        count_iterator<std::size_t>, count_iterator<std::size_t>, count_iterator<std::size_t>,
+                        ForwardIterator) {
+    if (acc1.index == n) return acc2;
+    if (acc2.index == n) return acc1;
+    return better(acc2.value, acc1.value) ? acc2 : acc1;
+  };
+
+  acc_t identity {n, value_type{}};
+
+  acc_t ret = reduce_generic(policy, accumulate_op, combine_op, identity, identity,
+                             count_iterator<std::size_t>(0), count_iterator<std::size_t>(n), first);
+  return ret.index;
+}
+
+}
+
+/**
+ * @brief Find the first element that satisfies a given predicate.
+ *
+ * @param policy Execution policy (`ityr::execution`).
+ * @param first  Begin iterator.
+ * @param last   End iterator.
+ * @param pred   Unary predicate.
+ *
+ * @return The iterator to the first element in `[first, last)` that satisfies `pred`, or `last` if
+ *         no such element is found.
+ *
+ * If global pointers are provided as iterators, they are automatically checked out with the read-only
+ * mode in the specified granularity (`ityr::execution::sequenced_policy::checkout_count` if serial,
+ * or `ityr::execution::parallel_policy::checkout_count` if parallel) without explicitly passing them
+ * as global iterators.
+ *
+ * The search is short-circuited. In parallel execution, leaf tasks share a cancellation flag that
+ * records the smallest index found so far, and they check it before checking out each chunk.
+ * Tasks working on the range after an already found element stop fetching remote data.
+ *
+ * Example:
+ * ```
+ * ityr::global_vector<int> v = {1, 2, 3, 4, 5};
+ * auto it = ityr::find_if(ityr::execution::par, v.begin(), v.end(), [](int x) { return x % 2 == 0; });
+ * // it = v.begin() + 1
+ * ```
+ *
+ * @see [std::find_if -- cppreference.com](https://en.cppreference.com/w/cpp/algorithm/find)
+ * @see `ityr::find()`
+ * @see `ityr::any_of()`
+ * @see `ityr::execution::sequenced_policy`, `ityr::execution::seq`,
+ *      `ityr::execution::parallel_policy`, `ityr::execution::par`
+ */
+template <typename ExecutionPolicy, typename ForwardIterator, typename Pred>
+inline ForwardIterator find_if(const ExecutionPolicy& policy,
+                               ForwardIterator        first,
+                               ForwardIterator        last,
+                               Pred                   pred) {
+  execution::internal::assert_policy(policy);
+
+  if constexpr (is_global_iterator_v<ForwardIterator>) {
+    static_assert(std::is_same_v<typename ForwardIterator::mode, checkout_mode::read_t> ||
+                  std::is_same_v<typename ForwardIterator::mode, checkout_mode::no_access_t>);
+
+  } else if constexpr (ori::is_global_ptr_v<ForwardIterator>) {
+    // automatically convert global pointers to global iterators with read-only access
+    auto first_ = make_global_iterator(first, checkout_mode::read);
+    auto last_  = make_global_iterator(last , checkout_mode::read);
+    return std::next(first, std::distance(first_, find_if(policy, first_, last_, pred)));
+  }
+
+  return std::next(first, internal::search_generic<false>(policy, first, last, pred));
+}
+
+/**
+ * @brief Find the first element that is equal to a given value.
+ *
+ * @param policy Execution policy (`ityr::execution`).
+ * @param first  Begin iterator.
+ * @param last   End iterator.
+ * @param value  Value to be compared.
+ *
+ * @return The iterator to the first element in `[first, last)` that is equal to `value`, or `last`
+ *         if no such element is found.
+ *
+ * Equivalent to `ityr::find_if(policy, first, last, [=](const auto& v) { return v == value; })`.
+ *
+ * @see [std::find -- cppreference.com](https://en.cppreference.com/w/cpp/algorithm/find)
+ * @see `ityr::find_if()`
+ */
+template <typename ExecutionPolicy, typename ForwardIterator, typename T>
+inline ForwardIterator find(const ExecutionPolicy& policy,
+                            ForwardIterator        first,
+                            ForwardIterator        last,
+                            const T&               value) {
+  return find_if(policy, first, last, [=](const auto& v) { return v == value; });
+}
+
+/**
+ * @brief Check if any element in a range satisfies a given predicate.
+ *
+ * @param policy Execution policy (`ityr::execution`).
+ * @param first  Begin iterator.
+ * @param last   End iterator.
+ * @param pred   Unary predicate.
+ *
+ * @return True if `pred` returns true for at least one element in `[first, last)`.
+ *
+ * Unlike `ityr::find_if()`, finding any element cancels the entire search, regardless of its
+ * position in the range.
+ *
+ * Example:
+ * ```
+ * ityr::global_vector<int> v = {1, 2, 3, 4, 5};
+ * bool r = ityr::any_of(ityr::execution::par, v.begin(), v.end(), [](int x) { return x > 3; });
+ * // r = true
+ * ```
+ *
+ * @see [std::any_of -- cppreference.com](https://en.cppreference.com/w/cpp/algorithm/all_any_none_of)
+ * @see `ityr::all_of()`
+ * @see `ityr::find_if()`
+ */
+template <typename ExecutionPolicy, typename ForwardIterator, typename Pred>
+inline bool any_of(const ExecutionPolicy& policy,
+                   ForwardIterator        first,
+                   ForwardIterator        last,
+                   Pred                   pred) {
+  execution::internal::assert_policy(policy);
+
+  if constexpr (is_global_iterator_v<ForwardIterator>) {
+    static_assert(std::is_same_v<typename ForwardIterator::mode, checkout_mode::read_t> ||
+                  std::is_same_v<typename ForwardIterator::mode, checkout_mode::no_access_t>);
+
+  } else if constexpr (ori::is_global_ptr_v<ForwardIterator>) {
+    // automatically convert global pointers to global iterators with read-only access
+    auto first_ = make_global_iterator(first, checkout_mode::read);
+    auto last_  = make_global_iterator(last , checkout_mode::read);
+    return any_of(policy, first_, last_, pred);
+  }
+
+  std::size_t n = std::distance(first, last);
+  return internal::search_generic<true>(policy, first, last, pred) < n;
+}
+
+/**
+ * @brief Check if all elements in a range satisfy a given predicate.
+ *
+ * @param policy Execution policy (`ityr::execution`).
+ * @param first  Begin iterator.
+ * @param last   End iterator.
+ * @param pred   Unary predicate.
+ *
+ * @return True if `pred` returns true for all elements in `[first, last)` (or the range is empty).
+ *
+ * Equivalent to `!ityr::any_of(policy, first, last, [=](const auto& v) { return !pred(v); })`.
+ *
+ * @see [std::all_of -- cppreference.com](https://en.cppreference.com/w/cpp/algorithm/all_any_none_of)
+ * @see `ityr::any_of()`
+ */
+template <typename ExecutionPolicy, typename ForwardIterator, typename Pred>
+inline bool all_of(const ExecutionPolicy& policy,
+                   ForwardIterator        first,
+                   ForwardIterator        last,
+                   Pred                   pred) {
+  return !any_of(policy, first, last, [=](const auto& v) { return !pred(v); });
+}
+
+/**
+ * @brief Count the number of elements that satisfy a given predicate.
+ *
+ * @param policy Execution policy (`ityr::execution`).
+ * @param first  Begin iterator.
+ * @param last   End iterator.
+ * @param pred   Unary predicate.
+ *
+ * @return The number of elements in `[first, last)` for which `pred` returns true.
+ *
+ * Example:
+ * ```
+ * ityr::global_vector<int> v = {1, 2, 3, 4, 5};
+ * auto c = ityr::count_if(ityr::execution::par, v.begin(), v.end(), [](int x) { return x % 2 == 1; });
+ * // c = 3
+ * ```
+ *
+ * @see [std::count_if -- cppreference.com](https://en.cppreference.com/w/cpp/algorithm/count)
+ * @see `ityr::transform_reduce()`
+ */
+template <typename ExecutionPolicy, typename ForwardIterator, typename Pred>
+inline typename std::iterator_traits<ForwardIterator>::difference_type
+count_if(const ExecutionPolicy& policy,
+         ForwardIterator        first,
+         ForwardIterator        last,
+         Pred                   pred) {
+  using difference_type = typename std::iterator_traits<ForwardIterator>::difference_type;
+  return transform_reduce(policy, first, last, difference_type(0), std::plus<difference_type>{},
+                          [=](const auto& v) { return pred(v) ? difference_type(1) : difference_type(0); });
+}
+
+/**
+ * @brief Find the smallest element in a range.
+ *
+ * @param policy Execution policy (`ityr::execution`).
+ * @param first  Begin iterator.
+ * @param last   End iterator.
+ * @param comp   Comparison operator (`comp(a, b)` returns true if `a` is less than `b`).
+ *
+ * @return The iterator to the first smallest element in `[first, last)`, or `last` if the range is empty.
+ *
+ * The value type of the iterator must be copy-constructible and default-constructible, as the
+ * reduction keeps a copy of the current smallest element as an accumulator.
+ *
+ * Example:
+ * ```
+ * ityr::global_vector<int> v = {3, 1, 4, 1, 5};
+ * auto it = ityr::min_element(ityr::execution::par, v.begin(), v.end());
+ * // it = v.begin() + 1
+ * ```
+ *
+ * @see [std::min_element -- cppreference.com](https://en.cppreference.com/w/cpp/algorithm/min_element)
+ * @see `ityr::max_element()`
+ * @see `ityr::minmax_element()`
+ */
+template <typename ExecutionPolicy, typename ForwardIterator, typename Compare = std::less<>>
+inline ForwardIterator min_element(const ExecutionPolicy& policy,
+                                   ForwardIterator        first,
+                                   ForwardIterator        last,
+                                   Compare                comp = {}) {
+  if constexpr (is_global_iterator_v<ForwardIterator>) {
+    static_assert(std::is_same_v<typename ForwardIterator::mode, checkout_mode::read_t> ||
+                  std::is_same_v<typename ForwardIterator::mode, checkout_mode::no_access_t>);
+
+  } else if constexpr (ori::is_global_ptr_v<ForwardIterator>) {
+    // automatically convert global pointers to global iterators with read-only access
+    auto first_ = make_global_iterator(first, checkout_mode::read);
+    auto last_  = make_global_iterator(last , checkout_mode::read);
+    return std::next(first, std::distance(first_, min_element(policy, first_, last_, comp)));
+  }
+
+  return std::next(first, internal::select_element_generic(policy, first, last,
+      [=](const auto& a, const auto& b) { return comp(a, b); }));
+}
+
+/**
+ * @brief Find the largest element in a range.
+ *
+ * @param policy Execution policy (`ityr::execution`).
+ * @param first  Begin iterator.
+ * @param last   End iterator.
+ * @param comp   Comparison operator (`comp(a, b)` returns true if `a` is less than `b`).
+ *
+ * @return The iterator to the first largest element in `[first, last)`, or `last` if the range is empty.
+ *
+ * @see [std::max_element -- cppreference.com](https://en.cppreference.com/w/cpp/algorithm/max_element)
+ * @see `ityr::min_element()`
+ * @see `ityr::minmax_element()`
+ */
+template <typename ExecutionPolicy, typename ForwardIterator, typename Compare = std::less<>>
+inline ForwardIterator max_element(const ExecutionPolicy& policy,
+                                   ForwardIterator        first,
+                                   ForwardIterator        last,
+                                   Compare                comp = {}) {
+  if constexpr (is_global_iterator_v<ForwardIterator>) {
+    static_assert(std::is_same_v<typename ForwardIterator::mode, checkout_mode::read_t> ||
+                  std::is_same_v<typename ForwardIterator::mode, checkout_mode::no_access_t>);
+
+  } else if constexpr (ori::is_global_ptr_v<ForwardIterator>) {
+    // automatically convert global pointers to global iterators with read-only access
+    auto first_ = make_global_iterator(first, checkout_mode::read);
+    auto last_  = make_global_iterator(last , checkout_mode::read);
+    return std::next(first, std::distance(first_, max_element(policy, first_, last_, comp)));
+  }
+
+  return std::next(first, internal::select_element_generic(policy, first, last,
+      [=](const auto& a, const auto& b) { return comp(b, a); }));
+}
+
+/**
+ * @brief Find the smallest and largest elements in a range.
+ *
+ * @param policy Execution policy (`ityr::execution`).
+ * @param first  Begin iterator.
+ * @param last   End iterator.
+ * @param comp   Comparison operator (`comp(a, b)` returns true if `a` is less than `b`).
+ *
+ * @return A pair of iterators to the first smallest element and the last largest element in
+ *         `[first, last)`, or `(last, last)` if the range is empty.
+ *
+ * Both elements are computed in a single pass with two accumulators.
+ *
+ * Example:
+ * ```
+ * ityr::global_vector<int> v = {3, 1, 4, 1, 5, 5};
+ * auto [it_min, it_max] = ityr::minmax_element(ityr::execution::par, v.begin(), v.end());
+ * // it_min = v.begin() + 1, it_max = v.begin() + 5
+ * ```
+ *
+ * @see [std::minmax_element -- cppreference.com](https://en.cppreference.com/w/cpp/algorithm/minmax_element)
+ * @see `ityr::min_element()`
+ * @see `ityr::max_element()`
+ */
+template <typename ExecutionPolicy, typename ForwardIterator, typename Compare = std::less<>>
+inline std::pair<ForwardIterator, ForwardIterator>
+minmax_element(const ExecutionPolicy& policy,
+               ForwardIterator        first,
+               ForwardIterator        last,
+               Compare                comp = {}) {
+  if constexpr (is_global_iterator_v<ForwardIterator>) {
+    static_assert(std::is_same_v<typename ForwardIterator::mode, checkout_mode::read_t> ||
+                  std::is_same_v<typename ForwardIterator::mode, checkout_mode::no_access_t>);
+
+  } else if constexpr (ori::is_global_ptr_v<ForwardIterator>) {
+    // automatically convert global pointers to global iterators with read-only access
+    auto first_ = make_global_iterator(first, checkout_mode::read);
+    auto last_  = make_global_iterator(last , checkout_mode::read);
+    auto [it_min, it_max] = minmax_element(policy, first_, last_, comp);
+    return std::make_pair(std::next(first, std::distance(first_, it_min)),
+                          std::next(first, std::distance(first_, it_max)));
+  }
+
+  using value_type = typename std::iterator_traits<ForwardIterator>::value_type;
+  using acc_t = internal::element_acc<value_type>;
+  using acc_pair_t = std::pair<acc_t, acc_t>;
+
+  std::size_t n = std::distance(first, last);
+
+  auto accumulate_op = [=](acc_pair_t& acc, std::size_t i, const auto& v) {
+    if (acc.first.index == n || comp(v, acc.first.value)) {
+      acc.first = acc_t{i, v};
+    }
+    // The last largest element is selected
+    if (acc.second.index == n || !comp(v, acc.second.value)) {
+      acc.second = acc_t{i, v};
+    }
+  };
+
+  auto combine_op = [=](const acc_pair_t& acc1, const acc_pair_t& acc2,
+                        count_iterator<std::size_t>, count_iterator<std::size_t>, count_iterator<std::size_t>,
+                        ForwardIterator) {
+    if (acc1.first.index == n) return acc2;
+    if (acc2.first.index == n) return acc1;
+    return acc_pair_t{comp(acc2.first.value, acc1.first.value) ? acc2.first : acc1.first,
+                      comp(acc2.second.value, acc1.second.value) ? acc1.second : acc2.second};
+  };
+
+  acc_pair_t identity {acc_t{n, value_type{}}, acc_t{n, value_type{}}};
+
+  acc_pair_t ret = internal::reduce_generic(policy, accumulate_op, combine_op, identity, identity,
+                                            count_iterator<std::size_t>(0), count_iterator<std::size_t>(n),
+                                            first);
+
+  return std::make_pair(std::next(first, ret.first.index), std::next(first, ret.second.index));
+}
+
+/**
+ * @brief Calculate differences between adjacent elements.
+ *
+ * @param policy    Execution policy (`ityr::execution`).
+ * @param first1    Input begin iterator.
+ * @param last1     Input end iterator.
+ * @param first_d   Output begin iterator.
+ * @param binary_op Binary operator to compute a difference (`binary_op(x_i, x_{i-1})`).
+ *
+ * @return Iterator to the end of the output range (`first_d + (last1 - first1)`).
+ *
+ * This function assigns `*first1` to `*first_d`, and `binary_op(first1[i], first1[i - 1])` to
+ * `first_d[i]` for `i` in `[1, last1 - first1)`.
+ *
+ * The input range is read as two overlapping streams shifted by one element, so each leaf task
+ * reads the element preceding its subrange by itself and no communication is needed at leaf
+ * boundaries. The input and output ranges must not be overlapped.
+ *
+ * If global pointers are provided as iterators, they are automatically checked out with the read-only
+ * mode (input) and the write-only mode (output) in the specified granularity
+ * (`ityr::execution::sequenced_policy::checkout_count` if serial,
+ * or `ityr::execution::parallel_policy::checkout_count` if parallel) without explicitly passing them
+ * as global iterators.
+ *
+ * Example:
+ * ```
+ * ityr::global_vector<int> v1 = {1, 3, 6, 10, 15};
+ * ityr::global_vector<int> v2(v1.size());
+ * ityr::adjacent_difference(ityr::execution::par, v1.begin(), v1.end(), v2.begin());
+ * // v2 = {1, 2, 3, 4, 5}
+ * ```
+ *
+ * @see [std::adjacent_difference -- cppreference.com](https://en.cppreference.com/w/cpp/algorithm/adjacent_difference)
+ * @see `ityr::transform()`
+ * @see `ityr::inclusive_scan()`
+ * @see `ityr::execution::sequenced_policy`, `ityr::execution::seq`,
+ *      `ityr::execution::parallel_policy`, `ityr::execution::par`
+ */
+template <typename ExecutionPolicy, typename ForwardIterator1, typename ForwardIteratorD,
+          typename BinaryOp>
+inline ForwardIteratorD adjacent_difference(const ExecutionPolicy& policy,
+                                            ForwardIterator1       first1,
+                                            ForwardIterator1       last1,
+                                            ForwardIteratorD       first_d,
+                                            BinaryOp               binary_op) {
+  if (first1 == last1) {
+    return first_d;
+  }
+
+  auto d = std::distance(first1, last1);
+
+  // The first element is copied as is
+  transform(execution::sequenced_policy{.checkout_count = 1},
+            first1, std::next(first1), first_d, [](const auto& v) { return v; });
+
+  // Each element is paired with its preceding element read from the shifted input stream
+  transform(policy, std::next(first1), last1, first1, std::next(first_d),
+            [=](const auto& cur, const auto& prev) { return binary_op(cur, prev); });
+
+  return std::next(first_d, d);
+}
+
+/**
+ * @brief Calculate differences between adjacent elements.
+ *
+ * @param policy  Execution policy (`ityr::execution`).
+ * @param first1  Input begin iterator.
+ * @param last1   Input end iterator.
+ * @param first_d Output begin iterator.
+ *
+ * @return Iterator to the end of the output range (`first_d + (last1 - first1)`).
+ *
+ * Equivalent to `ityr::adjacent_difference(policy, first1, last1, first_d, std::minus<>{})`.
+ *
+ * @see [std::adjacent_difference -- cppreference.com](https://en.cppreference.com/w/cpp/algorithm/adjacent_difference)
+ * @see `ityr::execution::sequenced_policy`, `ityr::execution::seq`,
+ *      `ityr::execution::parallel_policy`, `ityr::execution::par`
+ */
+template <typename ExecutionPolicy, typename ForwardIterator1, typename ForwardIteratorD>
+inline ForwardIteratorD adjacent_difference(const ExecutionPolicy& policy,
+                                            ForwardIterator1       first1,
+                                            ForwardIterator1       last1,
+                                            ForwardIteratorD       first_d) {
+  return adjacent_difference(policy, first1, last1, first_d, std::minus<>{});
+}
+
+/**
+ * @brief Calculate an inner product of two ranges.
+ *
+ * @param policy              Execution policy (`ityr::execution`).
+ * @param first1              1st begin iterator.
+ * @param last1               1st end iterator.
+ * @param first2              2nd begin iterator.
+ * @param identity            Identity element.
+ * @param binary_reduce_op    Associative binary operator to accumulate products.
+ * @param binary_transform_op Binary operator to compute a product of each pair of elements.
+ *
+ * @return The reduced result.
+ *
+ * This function has the same argument order as the standard `std::inner_product()`, but the fourth
+ * argument is an identity element of `binary_reduce_op` (see `ityr::reduce()`), rather than an
+ * initial value, and `binary_reduce_op` must be associative.
+ * Equivalent to `ityr::transform_reduce(policy, first1, last1, first2, identity, binary_reduce_op, binary_transform_op)`.
+ *
+ * Example:
+ * ```
+ * ityr::global_vector<int> v1 = {1, 2, 3, 4, 5};
+ * ityr::global_vector<int> v2 = {5, 4, 3, 2, 1};
+ * int max_prod = ityr::inner_product(ityr::execution::par, v1.begin(), v1.end(), v2.begin(), 0,
+ *                                    [](int x, int y) { return std::max(x, y); }, std::multiplies<>{});
+ * // max_prod = 9
+ * ```
+ *
+ * @see [std::inner_product -- cppreference.com](https://en.cppreference.com/w/cpp/algorithm/inner_product)
+ * @see `ityr::transform_reduce()`
+ * @see `ityr::execution::sequenced_policy`, `ityr::execution::seq`,
+ *      `ityr::execution::parallel_policy`, `ityr::execution::par`
+ */
+template <typename ExecutionPolicy, typename ForwardIterator1, typename ForwardIterator2, typename T,
+          typename BinaryReduceOp, typename BinaryTransformOp>
+inline T inner_product(const ExecutionPolicy& policy,
+                       ForwardIterator1       first1,
+                       ForwardIterator1       last1,
+                       ForwardIterator2       first2,
+                       T                      identity,
+                       BinaryReduceOp         binary_reduce_op,
+                       BinaryTransformOp      binary_transform_op) {
+  return transform_reduce(policy, first1, last1, first2, identity, binary_reduce_op, binary_transform_op);
+}
+
+/**
+ * @brief Calculate an inner product of two ranges.
+ *
+ * @param policy   Execution policy (`ityr::execution`).
+ * @param first1   1st begin iterator.
+ * @param last1    1st end iterator.
+ * @param first2   2nd begin iterator.
+ * @param identity Identity element.
+ *
+ * @return The reduced result.
+ *
+ * Equivalent to `ityr::inner_product(policy, first1, last1, first2, identity, std::plus<>{}, std::multiplies<>{})`.
+ *
+ * Example:
+ * ```
+ * ityr::global_vector<double> v1 = {1.0, 2.0, 3.0};
+ * ityr::global_vector<double> v2 = {4.0, 5.0, 6.0};
+ * double dot = ityr::inner_product(ityr::execution::par, v1.begin(), v1.end(), v2.begin(), 0.0);
+ * // dot = 32.0
+ * ```
+ *
+ * @see [std::inner_product -- cppreference.com](https://en.cppreference.com/w/cpp/algorithm/inner_product)
+ * @see `ityr::transform_reduce()`
+ */
+template <typename ExecutionPolicy, typename ForwardIterator1, typename ForwardIterator2, typename T>
+inline T inner_product(const ExecutionPolicy& policy,
+                       ForwardIterator1       first1,
+                       ForwardIterator1       last1,
+                       ForwardIterator2       first2,
+                       T                      identity) {
+  return inner_product(policy, first1, last1, first2, identity, std::plus<>{}, std::multiplies<>{});
+}
+
+/**
+ * @brief Count the number of elements that fall into each bin.
+ *
+ * @tparam NBins  Number of bins.
+ * @param  policy Execution policy (`ityr::execution`).
+ * @param  first  Begin iterator.
+ * @param  last   End iterator.
+ * @param  bin_op Unary operator that returns the bin index of an element.
+ *
+ * @return An array of `NBins` counts. The i-th count is the number of elements `x` in `[first, last)`
+ *         such that `bin_op(x) == i`. Elements for which `bin_op` returns an index out of `[0, NBins)`
+ *         are ignored.
+ *
+ * Each leaf task counts elements into its own local bins, and the bins are added element-wise when
+ * child tasks are joined. Thus, no global atomic operation is issued for counting.
+ * Because the bins are held in task-local memory and returned by value when tasks are joined across
+ * processes, `NBins` should be moderately small (e.g., up to a few thousand).
+ *
+ * If global pointers are provided as iterators, they are automatically checked out with the read-only
+ * mode in the specified granularity (`ityr::execution::sequenced_policy::checkout_count` if serial,
+ * or `ityr::execution::parallel_policy::checkout_count` if parallel) without explicitly passing them
+ * as global iterators.
+ *
+ * Example:
+ * ```
+ * ityr::global_vector<double> v = {0.1, 0.5, 0.7, 0.2, 0.9};
+ * auto bins = ityr::histogram<4>(ityr::execution::par, v.begin(), v.end(),
+ *                                [](double x) { return static_cast<std::size_t>(x * 4); });
+ * // bins = {2, 0, 2, 1}
+ * ```
+ *
+ * @see `ityr::count_if()`
+ * @see `ityr::transform_reduce()`
+ * @see `ityr::execution::sequenced_policy`, `ityr::execution::seq`,
+ *      `ityr::execution::parallel_policy`, `ityr::execution::par`
+ */
+template <std::size_t NBins, typename ExecutionPolicy, typename ForwardIterator, typename BinOp>
+inline std::array<std::size_t, NBins> histogram(const ExecutionPolicy& policy,
+                                                ForwardIterator        first,
+                                                ForwardIterator        last,
+                                                BinOp                  bin_op) {
+  if constexpr (is_global_iterator_v<ForwardIterator>) {
+    static_assert(std::is_same_v<typename ForwardIterator::mode, checkout_mode::read_t> ||
+                  std::is_same_v<typename ForwardIterator::mode, checkout_mode::no_access_t>);
+
+  } else if constexpr (ori::is_global_ptr_v<ForwardIterator>) {
+    // automatically convert global pointers to global iterators with read-only access
+    auto first_ = make_global_iterator(first, checkout_mode::read);
+    auto last_  = make_global_iterator(last , checkout_mode::read);
+    return histogram<NBins>(policy, first_, last_, bin_op);
+  }
+
+  using bins_t = std::array<std::size_t, NBins>;
+
+  auto accumulate_op = [=](bins_t& acc, const auto& v) {
+    std::size_t b = bin_op(v);
+    if (b < NBins) {
+      acc[b]++;
+    }
+  };
+
+  auto combine_op = [](const bins_t& acc1, const bins_t& acc2,
+                       ForwardIterator, ForwardIterator, ForwardIterator) {
+    bins_t ret;
+    for (std::size_t b = 0; b < NBins; b++) {
+      ret[b] = acc1[b] + acc2[b];
+    }
+    return ret;
+  };
+
+  bins_t identity {};
+
+  return internal::reduce_generic(policy, accumulate_op, combine_op, identity,
+                                  identity, first, last);
+}
+
+ITYR_TEST_CASE("[ityr::pattern::parallel_loop] reduce and transform_reduce") {
+  ito::init();
+  ori::init();
+
+  ITYR_SUBCASE("default cutoff") {
+    long n = 10000;
+    long r = ito::root_exec([=] {
+      return reduce(
+          execution::par,
+          ityr::count_iterator<long>(0),
+          ityr::count_iterator<long>(n));
+    });
+    ITYR_CHECK(r == n * (n - 1) / 2);
+  }
+
+  ITYR_SUBCASE("custom cutoff") {
+    long n = 100000;
+    long r = ito::root_exec([=] {
+      return reduce(
+          execution::parallel_policy{.cutoff_count = 100},
+          ityr::count_iterator<long>(0),
+          ityr::count_iterator<long>(n));
+    });
+    ITYR_CHECK(r == n * (n - 1) / 2);
+  }
+
+  ITYR_SUBCASE("transform unary") {
+    long n = 100000;
+    long r = ito::root_exec([=] {
+      return transform_reduce(
+          execution::parallel_policy{.cutoff_count = 100},
+          ityr::count_iterator<long>(0),
+          ityr::count_iterator<long>(n),
+          long(0),
+          std::plus<long>{},
+          [](long x) { return x * x; });
+    });
+    ITYR_CHECK(r == n * (n - 1) * (2 * n - 1) / 6);
+  }
+
+  ITYR_SUBCASE("transform binary") {
+    long n = 100000;
+    long r = ito::root_exec([=] {
+      return transform_reduce(
+          execution::parallel_policy{.cutoff_count = 100},
+          ityr::count_iterator<long>(0),
+          ityr::count_iterator<long>(n),
+          ityr::count_iterator<long>(0),
+          long(0),
+          std::plus<long>{},
+          [](long x, long y) { return x * y; });
+    });
+    ITYR_CHECK(r == n * (n - 1) * (2 * n - 1) / 6);
+  }
+
+  ITYR_SUBCASE("zero elements") {
+    long r = ito::root_exec([=] {
+      return reduce(
+          execution::parallel_policy{.cutoff_count = 100},
+          ityr::count_iterator<long>(0),
+          ityr::count_iterator<long>(0),
+          long(30));
+    });
+    ITYR_CHECK(r == 30);
+  }
+
+  ori::fini();
+  ito::fini();
+}
+
+ITYR_TEST_CASE("[ityr::pattern::parallel_loop] parallel reduce with global_ptr") {
+  ito::init();
+  ori::init();
+
+  long n = 100000;
+  ori::global_ptr<long> p = ori::malloc_coll<long>(n);
+
+  ito::root_exec([=] {
+    long count = 0;
+    for_each(
+        execution::sequenced_policy{.checkout_count = 100},
+        make_global_iterator(p    , checkout_mode::write),
+        make_global_iterator(p + n, checkout_mode::write),
+        [&](long& v) { v = count++; });
+  });
+
+  ITYR_SUBCASE("default cutoff") {
+    long r = ito::root_exec([=] {
+      return reduce(
+          execution::par,
+          p, p + n);
+    });
+    ITYR_CHECK(r == n * (n - 1) / 2);
+  }
+
+  ITYR_SUBCASE("custom cutoff and checkout count") {
+    long r = ito::root_exec([=] {
+      return reduce(
+          execution::parallel_policy{.cutoff_count = 100, .checkout_count = 50},
+          p, p + n);
+    });
+    ITYR_CHECK(r == n * (n - 1) / 2);
+  }
+
+  ITYR_SUBCASE("without auto checkout") {
+    long r = ito::root_exec([=] {
+      return transform_reduce(
+          execution::par,
           make_global_iterator(p    , checkout_mode::no_access),
           make_global_iterator(p + n, checkout_mode::no_access),
           long(0),
@@ -1564,6 +2978,31 @@ ITYR_TEST_CASE("[ityr::pattern::parallel_loop] parallel transform with global_pt
     });
   }
 
+  ITYR_SUBCASE("chunk") {
+    ito::root_exec([=] {
+      auto r = transform_chunk(
+          execution::parallel_policy{.cutoff_count = 100, .checkout_count = 100},
+          count_iterator<long>(0), count_iterator<long>(n), p1,
+          [](count_iterator<long> first, count_iterator<long> last, long* d) {
+            for (; first != last; ++first, ++d) *d = *first * 2;
+          });
+      ITYR_CHECK(r == p1 + n);
+
+      transform_chunk(
+          execution::parallel_policy{.cutoff_count = 100, .checkout_count = 100},
+          count_iterator<long>(0), count_iterator<long>(n), p1, p2,
+          [](count_iterator<long> first1, count_iterator<long> last1, const long* first2, long* d) {
+            for (; first1 != last1; ++first1, ++first2, ++d) *d = *first1 * *first2;
+          });
+
+      auto sum = reduce(
+          execution::parallel_policy{.cutoff_count = 100, .checkout_count = 100},
+          p2, p2 + n);
+
+      ITYR_CHECK(sum == n * (n - 1) * (2 * n - 1) / 3);
+    });
+  }
+
   ITYR_SUBCASE("serial") {
     ito::root_exec([=] {
       auto r = transform(
@@ -1617,6 +3056,69 @@ ITYR_TEST_CASE("[ityr::pattern::parallel_loop] parallel fill") {
   ito::fini();
 }
 
+ITYR_TEST_CASE("[ityr::pattern::parallel_loop] parallel generate, iota, and fill_random") {
+  ito::init();
+  ori::init();
+
+  long n = 100000;
+  ori::global_ptr<long> p = ori::malloc_coll<long>(n);
+
+  execution::parallel_policy par_policy {.cutoff_count = 100, .checkout_count = 100};
+
+  ITYR_SUBCASE("generate") {
+    ito::root_exec([=] {
+      generate(par_policy, p, p + n, [] { return 5L; });
+      ITYR_CHECK(reduce(par_policy, p, p + n) == n * 5);
+    });
+  }
+
+  ITYR_SUBCASE("iota") {
+    ito::root_exec([=] {
+      iota(par_policy, p, p + n, 10L);
+      ITYR_CHECK(reduce(par_policy, p, p + n) == n * (n - 1) / 2 + n * 10);
+      ITYR_CHECK(p[n - 1].get() == n - 1 + 10);
+
+      iota(execution::sequenced_policy{.checkout_count = 100}, p, p + n, 0L);
+      ITYR_CHECK(reduce(par_policy, p, p + n) == n * (n - 1) / 2);
+    });
+  }
+
+  ITYR_SUBCASE("fill_random") {
+    long m = 1000;
+    ori::global_ptr<long> q = ori::malloc_coll<long>(n);
+
+    ito::root_exec([=] {
+      std::uniform_int_distribution<long> dist(0, m - 1);
+      fill_random(par_policy, p, p + n, 42, dist);
+      auto in_range = [=](long x) { return 0 <= x && x < m; };
+      ITYR_CHECK(all_of(par_policy, p, p + n, in_range));
+
+      // deterministic regardless of the execution policy
+      fill_random(execution::sequenced_policy{.checkout_count = 37}, q, q + n, 42, dist);
+      ITYR_CHECK(transform_reduce(par_policy, p, p + n, q, true,
+                                  std::logical_and<>{}, std::equal_to<>{}));
+
+      // roughly uniform
+      long sum = reduce(par_policy, p, p + n);
+      double mean = static_cast<double>(sum) / n;
+      ITYR_CHECK(std::abs(mean - (m - 1) / 2.0) < m * 0.01);
+
+      // different seeds
+      fill_random(par_policy, q, q + n, 43, dist);
+      auto eq = [](long x, long y) { return long(x == y); };
+      long n_eq = transform_reduce(par_policy, p, p + n, q, long(0), std::plus<>{}, eq);
+      ITYR_CHECK(n_eq < n / 100);
+    });
+
+    ori::free_coll(q);
+  }
+
+  ori::free_coll(p);
+
+  ori::fini();
+  ito::fini();
+}
+
 ITYR_TEST_CASE("[ityr::pattern::parallel_loop] inclusive scan") {
   ito::init();
   ori::init();
@@ -1664,4 +3166,207 @@ ITYR_TEST_CASE("[ityr::pattern::parallel_loop] inclusive scan") {
   ito::fini();
 }
 
+ITYR_TEST_CASE("[ityr::pattern::parallel_loop] find and min/max element") {
+  ito::init();
+  ori::init();
+
+  long n = 100000;
+  ori::global_ptr<long> p = ori::malloc_coll<long>(n);
+
+  // p[0], ..., p[n - 2] is a permutation of 0, ..., n - 2 (7 and n - 1 are coprime), and p[n - 1] = 0
+  ito::root_exec([=] {
+    transform(
+        execution::parallel_policy{.cutoff_count = 100, .checkout_count = 100},
+        count_iterator<long>(0), count_iterator<long>(n), p,
+        [=](long i) { return (i * 7) % (n - 1); });
+  });
+
+  execution::parallel_policy par_policy {.cutoff_count = 100, .checkout_count = 50};
+  execution::sequenced_policy seq_policy {.checkout_count = 100};
+
+  ITYR_SUBCASE("find") {
+    ito::root_exec([=] {
+      // The first occurrence is returned even if later elements are found by other tasks
+      long v = (77 * 7) % (n - 1);
+      ITYR_CHECK(find(par_policy, p, p + n, v) == p + 77);
+      ITYR_CHECK(find(seq_policy, p, p + n, v) == p + 77);
+      ITYR_CHECK(find(par_policy, p, p + n, 0) == p);
+      ITYR_CHECK(find(par_policy, p, p + n, n) == p + n);
+      ITYR_CHECK(find(par_policy, p, p, 0) == p);
+
+      auto it = find_if(par_policy,
+                        make_global_iterator(p    , checkout_mode::read),
+                        make_global_iterator(p + n, checkout_mode::read),
+                        [=](long x) { return x >= n - 10; });
+      long i = 0;
+      while ((i * 7) % (n - 1) < n - 10) i++;
+      ITYR_CHECK(it == make_global_iterator(p + i, checkout_mode::read));
+    });
+  }
+
+  ITYR_SUBCASE("find with matches in many leaves") {
+    ito::root_exec([=] {
+      // Matches are spread over leaves executed by different processes, and the first one must be
+      // returned regardless of the order in which they are found
+      auto is_match = [](long x) { return x % 97 == 96; };
+      long i = 0;
+      while (!is_match((i * 7) % (n - 1))) i++;
+
+      execution::parallel_policy fine_policy {.cutoff_count = 10, .checkout_count = 10};
+      for (int r = 0; r < 5; r++) {
+        ITYR_CHECK(find_if(fine_policy, p, p + n, is_match) == p + i);
+        ITYR_CHECK(find_if(par_policy, p + i + 1, p + n, is_match) ==
+                   find_if(seq_policy, p + i + 1, p + n, is_match));
+      }
+
+      // concurrent fetch-and-min on the cancellation flag
+      internal::search_cancel_flag cflag(n, true);
+      for_each(par_policy, count_iterator<long>(0), count_iterator<long>(n), [=](long j) {
+        if (j % 3 == 1) cflag.notify(j + 10);
+      });
+      ITYR_CHECK(cflag.get() == (ori::support_atomic ? 11 : std::size_t(n)));
+      cflag.destroy();
+    });
+  }
+
+  ITYR_SUBCASE("any_of and all_of") {
+    ito::root_exec([=] {
+      auto is_neg      = [](long x) { return x < 0; };
+      auto is_pos      = [](long x) { return x > 0; };
+      auto is_last     = [=](long x) { return x == n - 2; };
+      auto is_in_range = [=](long x) { return x < n; };
+      ITYR_CHECK(any_of(par_policy, p, p + n, is_last));
+      ITYR_CHECK(!any_of(par_policy, p, p + n, is_neg));
+      ITYR_CHECK(all_of(par_policy, p, p + n, is_in_range));
+      ITYR_CHECK(!all_of(par_policy, p, p + n, is_pos));
+      ITYR_CHECK(!any_of(seq_policy, p, p + n, is_neg));
+      ITYR_CHECK(all_of(par_policy, p, p, is_pos));
+    });
+  }
+
+  ITYR_SUBCASE("count_if") {
+    ito::root_exec([=] {
+      auto is_zero = [](long x) { return x == 0; };
+      auto is_even = [](long x) { return x % 2 == 0; };
+      // 0 appears twice since p[n - 1] = ((n - 1) * 7) % (n - 1) = 0
+      ITYR_CHECK(count_if(par_policy, p, p + n, is_zero) == 2);
+      ITYR_CHECK(count_if(par_policy, p, p + n, is_even) == count_if(seq_policy, p, p + n, is_even));
+    });
+  }
+
+  ITYR_SUBCASE("min_element and max_element") {
+    ito::root_exec([=] {
+      ITYR_CHECK(min_element(par_policy, p, p + n) == p);
+      ITYR_CHECK(min_element(seq_policy, p, p + n) == p);
+      ITYR_CHECK(min_element(par_policy, p + 1, p + n) == p + n - 1);
+      ITYR_CHECK(min_element(par_policy, p, p) == p);
+
+      auto it_max = max_element(par_policy, p, p + n);
+      ITYR_CHECK(it_max == max_element(seq_policy, p, p + n));
+      ITYR_CHECK((*it_max).get() == n - 2);
+
+      // reversed comparison
+      ITYR_CHECK(max_element(par_policy, p, p + n, std::greater<>{}) == p);
+    });
+  }
+
+  ITYR_SUBCASE("minmax_element") {
+    ito::root_exec([=] {
+      // The first smallest and the last largest elements are returned
+      auto [it_min, it_max] = minmax_element(par_policy, p, p + n);
+      ITYR_CHECK(it_min == p);
+      ITYR_CHECK(it_max == max_element(par_policy, p, p + n));
+
+      auto [it_min2, it_max2] = minmax_element(par_policy, p, p + n, std::greater<>{});
+      ITYR_CHECK(it_min2 == it_max);
+      ITYR_CHECK(it_max2 == p + n - 1);
+
+      auto [it_min3, it_max3] = minmax_element(seq_policy, p, p + n);
+      ITYR_CHECK(it_min3 == it_min);
+      ITYR_CHECK(it_max3 == it_max);
+    });
+  }
+
+  ori::free_coll(p);
+
+  ori::fini();
+  ito::fini();
+}
+
+ITYR_TEST_CASE("[ityr::pattern::parallel_loop] adjacent_difference, inner_product, and histogram") {
+  ito::init();
+  ori::init();
+
+  long n = 100000;
+  ori::global_ptr<long> p1 = ori::malloc_coll<long>(n);
+  ori::global_ptr<long> p2 = ori::malloc_coll<long>(n);
+
+  execution::parallel_policy par_policy {.cutoff_count = 100, .checkout_count = 30};
+
+  ito::root_exec([=] {
+    // p1 = {0, 1, 3, 6, 10, ...} (triangular numbers)
+    transform(par_policy, count_iterator<long>(0), count_iterator<long>(n), p1,
+              [](long i) { return i * (i + 1) / 2; });
+  });
+
+  ITYR_SUBCASE("adjacent_difference") {
+    ito::root_exec([=] {
+      auto ret = adjacent_difference(par_policy, p1, p1 + n, p2);
+      ITYR_CHECK(ret == p2 + n);
+
+      // p2 = {0, 1, 2, 3, ...}
+      auto is_index = [](long x, long i) { return x == i; };
+      ITYR_CHECK(transform_reduce(par_policy, p2, p2 + n, count_iterator<long>(0), true,
+                                  std::logical_and<>{}, is_index));
+
+      adjacent_difference(execution::sequenced_policy{.checkout_count = 7}, p2, p2 + n, p1,
+                          std::plus<>{});
+      ITYR_CHECK(p1[0].get() == 0);
+      ITYR_CHECK(reduce(par_policy, p1, p1 + n) == (n - 1) * (n - 1));
+
+      ITYR_CHECK(adjacent_difference(par_policy, p1, p1, p2) == p2);
+    });
+  }
+
+  ITYR_SUBCASE("inner_product") {
+    ito::root_exec([=] {
+      iota(par_policy, p2, p2 + n, 0L);
+      auto r1 = inner_product(par_policy, p2, p2 + n, p2, 0L);
+      ITYR_CHECK(r1 == (n - 1) * n * (2 * n - 1) / 6);
+
+      auto max_op = [](long x, long y) { return std::max(x, y); };
+      auto r2 = inner_product(par_policy, p1, p1 + n, p2, 0L, max_op, std::minus<>{});
+      ITYR_CHECK(r2 == (n - 1) * (n - 2) / 2);
+    });
+  }
+
+  ITYR_SUBCASE("histogram") {
+    ito::root_exec([=] {
+      iota(par_policy, p2, p2 + n, 0L);
+
+      auto bin_op = [](long x) { return static_cast<std::size_t>(x % 10); };
+      auto bins = histogram<10>(par_policy, p2, p2 + n, bin_op);
+      for (std::size_t b = 0; b < 10; b++) {
+        ITYR_CHECK(bins[b] == static_cast<std::size_t>(n / 10));
+      }
+
+      // out-of-range bins are ignored
+      auto bin_op2 = [=](long x) { return static_cast<std::size_t>(x * 4 / n) + 1; };
+      auto bins2 = histogram<4>(par_policy, p2, p2 + n, bin_op2);
+      ITYR_CHECK(bins2[0] == 0);
+      ITYR_CHECK(bins2[1] == static_cast<std::size_t>(n / 4));
+      ITYR_CHECK(bins2[3] == static_cast<std::size_t>(n / 4));
+
+      auto bins3 = histogram<10>(execution::sequenced_policy{.checkout_count = 100}, p2, p2 + n, bin_op);
+      ITYR_CHECK(bins3 == bins);
+    });
+  }
+
+  ori::free_coll(p1);
+  ori::free_coll(p2);
+
+  ori::fini();
+  ito::fini();
+}
+
 }
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "ityr/common/util.hpp"
+#include "ityr/ito/ito.hpp"
+#include "ityr/ori/ori.hpp"
+#include "ityr/pattern/root_exec.hpp"
+#include "ityr/pattern/count_iterator.hpp"
+#include "ityr/pattern/parallel_loop.hpp"
+
+namespace ityr {
+
+/**
+ * @brief Execute a function at the owner process of a global object.
+ *
+ * @param ptr     Global pointer to the object to be accessed.
+ * @param fn      Function object to be called as `fn(obj, args...)` at the owner of `ptr`.
+ * @param args... Arguments to be passed to `fn` (optional).
+ *
+ * @return The return value of `fn(obj, args...)`.
+ *
+ * This function ships `fn` and `args...` to the process owning the object at `ptr` (function
+ * shipping), which executes `fn(obj, args...)` with a reference `obj` to its local (home) copy of
+ * the object, and returns the result to the caller. For small updates on remote data (e.g.,
+ * incrementing a counter in a remote hash table bucket), this is much cheaper than transferring
+ * the data to the caller by checkout/checkin, which would also require a lock for atomicity.
+ *
+ * `fn`, `args...`, and the return value must be trivially copyable, and their total size must be
+ * small (at most `ityr::ito::remote_invoke_mailbox::max_size` bytes). The request is processed
+ * when the owner process polls its mailbox (i.e., in the scheduling loop or at parallel loops),
+ * and the caller thread blocks until it is completed. `fn` must run to completion without
+ * forking threads, calling `ityr::remote_invoke()`, or otherwise suspending the execution.
+ *
+ * Remote invocations on the same object are serialized at the owner process, and thus they are
+ * atomic to each other. As `fn` directly accesses the home copy of the object, cached copies of
+ * the object checked out by other threads are not updated until they are invalidated by an acquire
+ * fence (e.g., at the end of `ityr::root_exec()`). Thus, objects should not be updated with both
+ * `ityr::remote_invoke()` and checkout/checkin in the same parallel region.
+ *
+ * This function must be called by threads (within `ityr::root_exec()`).
+ *
+ * Example:
+ * ```
+ * ityr::global_vector<long> counts({.collective = true}, n);
+ * ityr::global_span<long> counts_s(counts.begin(), counts.end());
+ * ityr::root_exec([=] {
+ *   // Increment counts_s[i] at the owner of counts_s[i] and get the old value
+ *   long old = ityr::remote_invoke(counts_s.data() + i, [](long& c, long v) {
+ *     return std::exchange(c, c + v);
+ *   }, 1);
+ * });
+ * ```
+ */
+template <typename T, typename Fn, typename... Args>
+inline auto remote_invoke(ori::global_ptr<T> ptr, Fn fn, Args... args) {
+  using mode_t = std::conditional_t<std::is_const_v<T>, ori::mode::read_t, ori::mode::read_write_t>;
+
+  auto ptr_ = ori::const_pointer_cast<std::remove_const_t<T>>(ptr);
+  auto target_rank = ori::get_owner(ptr_);
+
+  return ito::remote_invoke(target_rank, [=] {
+    auto p = ori::checkout(ptr_, 1, mode_t{});
+
+    using retval_t = std::invoke_result_t<Fn, decltype(*p), Args...>;
+    if constexpr (std::is_void_v<retval_t>) {
+      fn(*p, args...);
+      ori::checkin(p, 1, mode_t{});
+    } else {
+      auto ret = fn(*p, args...);
+      ori::checkin(p, 1, mode_t{});
+      return ret;
+    }
+  });
+}
+
+ITYR_TEST_CASE("[ityr::remote_invoke] increment counters") {
+  ito::init();
+  ori::init();
+
+  long n_counters   = 100;
+  long n_increments = 10;
+  ori::global_ptr<long> counters = ori::malloc_coll<long>(n_counters);
+
+  root_exec([=] {
+    for_each(
+        execution::par,
+        count_iterator<long>(0),
+        count_iterator<long>(n_counters),
+        [=](long i) {
+          counters[i].put(0);
+        });
+  });
+
+  root_exec([=] {
+    long old_sum = transform_reduce(
+        execution::par,
+        count_iterator<long>(0),
+        count_iterator<long>(n_counters * n_increments),
+        long(0),
+        std::plus<long>{},
+        [=](long i) {
+          return remote_invoke(counters + i % n_counters,
+                               [](long& c, long v) { long old = c; c += v; return old; }, 1);
+        });
+
+    // old values of each counter are 0, 1, ..., n_increments - 1
+    ITYR_CHECK(old_sum == n_counters * n_increments * (n_increments - 1) / 2);
+
+    remote_invoke(counters, [](long& c) { c = -1; });
+    long v = remote_invoke(ori::const_pointer_cast<const long>(counters), [](const long& c) { return c; });
+    ITYR_CHECK(v == -1);
+  });
+
+  root_exec([=] {
+    for (long i = 1; i < n_counters; i++) {
+      ITYR_CHECK(counters[i].get() == n_increments);
+    }
+  });
+
+  ori::free_coll(counters);
+
+  ori::fini();
+  ito::fini();
+}
+
+}
@@ -49,6 +49,7 @@ inline auto root_exec(Fn&& fn, Args&&... args) {
 
   ori::release();
   common::mpi_barrier(common::topology::mpicomm());
+  ori::migrate_homes();
   ori::acquire();
 
   using retval_t = std::invoke_result_t<Fn, Args...>;
@@ -59,6 +60,7 @@ inline auto root_exec(Fn&& fn, Args&&... args) {
     // TODO: release() is needed only for the last worker which executed the root thread
     ori::release();
     common::mpi_barrier(common::topology::mpicomm());
+    ori::migrate_homes();
     ori::acquire();
   } else {
     auto ret = ito::root_exec(ito::with_callback,
@@ -66,6 +68,7 @@ inline auto root_exec(Fn&& fn, Args&&... args) {
                               std::forward<Fn>(fn), std::forward<Args>(args)...);
     ori::release();
     common::mpi_barrier(common::topology::mpicomm());
+    ori::migrate_homes();
     ori::acquire();
     return ret;
   }
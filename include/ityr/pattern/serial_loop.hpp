@@ -143,6 +143,87 @@ inline auto checkout_global_iterators(std::size_t n, ForwardIterators... its) {
   return ret;
 }
 
+template <typename ForwardIterator>
+inline constexpr std::size_t checkout_elem_size() {
+  if constexpr (is_global_iterator_v<ForwardIterator>) {
+    if constexpr (ForwardIterator::auto_checkout) {
+      return sizeof(typename ForwardIterator::value_type);
+    }
+  }
+  return 0;
+}
+
+// Upper bound of the cache size occupied by checking out `n` elements for each global iterator
+// (a region not aligned to cache blocks may span one more block)
+template <typename ForwardIterator>
+inline std::size_t checkout_cache_footprint_aux(std::size_t n) {
+  constexpr std::size_t elem_size = checkout_elem_size<ForwardIterator>();
+  if constexpr (elem_size == 0) {
+    return 0;
+  } else {
+    std::size_t bs = ori::block_size;
+    return common::round_up_pow2(n * elem_size, bs) + bs;
+  }
+}
+
+template <typename... ForwardIterators>
+inline std::size_t checkout_cache_footprint(std::size_t n) {
+  return (checkout_cache_footprint_aux<ForwardIterators>(n) + ...);
+}
+
+/*
+ * Iterate over chunks of at most `policy.checkout_count` elements, calling `apply_chunk(n, its)`
+ * with the checked-out iterators `its` of each chunk. The checkout of the next chunk is issued
+ * (without completion) before the current chunk is processed, so that fetching data for the next
+ * chunk overlaps with the computation on the current one (software pipelining). As the checkout
+ * increments the reference counts of the cache blocks, both chunks stay resident in the cache.
+ * If two chunks can occupy more than half of the cache, chunks are checked out one by one instead.
+ */
+template <typename ApplyChunk, typename ForwardIterator, typename... ForwardIterators>
+inline void for_each_checkout_pipelined(const execution::sequenced_policy& policy,
+                                        ApplyChunk                         apply_chunk,
+                                        ForwardIterator                    first,
+                                        ForwardIterator                    last,
+                                        ForwardIterators...                firsts) {
+  std::size_t n = std::distance(first, last);
+  std::size_t c = policy.checkout_count;
+
+  if (n == 0) return;
+
+  if (2 * checkout_cache_footprint<ForwardIterator, ForwardIterators...>(std::min(n, c)) >
+      ori::cache_size() / 2) {
+    for (std::size_t d = 0; d < n; d += c) {
+      std::size_t n_ = std::min(n - d, c);
+      auto [css, its] = checkout_global_iterators(n_, first, firsts...);
+      apply_chunk(n_, its);
+      ((first = std::next(first, n_)), ..., (firsts = std::next(firsts, n_)));
+    }
+    return;
+  }
+
+  std::size_t n_cur = std::min(n, c);
+  auto cur = checkout_global_iterators(n_cur, first, firsts...);
+
+  for (std::size_t d = 0; d < n; d += c) {
+    n_cur = std::min(n - d, c);
+    ((first = std::next(first, n_cur)), ..., (firsts = std::next(firsts, n_cur)));
+
+    if (d + n_cur < n) {
+      std::size_t n_next = std::min(n - d - n_cur, c);
+      auto next = checkout_global_iterators_aux(n_next, first, firsts...);
+
+      apply_chunk(n_cur, std::get<1>(cur));
+
+      // check in the current chunk and wait for the next chunk
+      cur = std::move(next);
+      ori::checkout_complete();
+
+    } else {
+      apply_chunk(n_cur, std::get<1>(cur));
+    }
+  }
+}
+
 template <typename Op, typename... ForwardIterators>
 inline void apply_iterators(Op                  op,
                             std::size_t         n,
@@ -161,19 +242,11 @@ inline void for_each_aux(const execution::sequenced_policy& policy,
   if constexpr ((is_global_iterator_v<ForwardIterator> || ... ||
                  is_global_iterator_v<ForwardIterators>)) {
     // perform automatic checkout for global iterators
-    std::size_t n = std::distance(first, last);
-    std::size_t c = policy.checkout_count;
-
-    for (std::size_t d = 0; d < n; d += c) {
-      auto n_ = std::min(n - d, c);
-
-      auto [css, its] = checkout_global_iterators(n_, first, firsts...);
+    for_each_checkout_pipelined(policy, [&](std::size_t n_, auto&& its) {
       std::apply([&](auto&&... args) {
         apply_iterators(op, n_, std::forward<decltype(args)>(args)...);
       }, its);
-
-      ((first = std::next(first, n_)), ..., (firsts = std::next(firsts, n_)));
-    }
+    }, first, last, firsts...);
 
   } else {
     for (; first != last; (++first, ..., ++firsts)) {
@@ -182,6 +255,99 @@ inline void for_each_aux(const execution::sequenced_policy& policy,
   }
 }
 
+template <typename Op, typename ForwardIterator, typename... ForwardIterators>
+inline void apply_iterators_chunk(Op                  op,
+                                  std::size_t         n,
+                                  ForwardIterator     first,
+                                  ForwardIterators... firsts) {
+  op(first, std::next(first, n), firsts...);
+}
+
+template <typename Op, typename ForwardIterator, typename... ForwardIterators>
+inline void for_each_chunk_aux(const execution::sequenced_policy& policy,
+                               Op                                 op,
+                               ForwardIterator                    first,
+                               ForwardIterator                    last,
+                               ForwardIterators...                firsts) {
+  if constexpr ((is_global_iterator_v<ForwardIterator> || ... ||
+                 is_global_iterator_v<ForwardIterators>)) {
+    // The same chunking as `for_each_aux()`, but the op is applied to each checked-out chunk
+    // as a whole, so that the inner loop over raw pointers can be vectorized
+    for_each_checkout_pipelined(policy, [&](std::size_t n_, auto&& its) {
+      std::apply([&](auto&&... args) {
+        apply_iterators_chunk(op, n_, std::forward<decltype(args)>(args)...);
+      }, its);
+    }, first, last, firsts...);
+
+  } else {
+    op(first, last, firsts...);
+  }
+}
+
+/*
+ * A loop operator wrapped by `chunk_op` is given ranges of iterators (`first, last, firsts...`)
+ * instead of individual elements. Loop skeletons dispatch to `for_each_chunk_aux()` for them.
+ */
+template <typename Op>
+struct chunk_op {
+  Op op;
+
+  template <typename... Args>
+  auto operator()(Args&&... args) const {
+    return op(std::forward<Args>(args)...);
+  }
+};
+
+template <typename Op>
+inline chunk_op<Op> make_chunk_op(Op op) {
+  return chunk_op<Op>{op};
+}
+
+template <typename Op>
+struct is_chunk_op : public std::false_type {};
+
+template <typename Op>
+struct is_chunk_op<chunk_op<Op>> : public std::true_type {};
+
+template <typename Op>
+inline constexpr bool is_chunk_op_v = is_chunk_op<Op>::value;
+
+template <bool Chunked, typename Op, typename ForwardIterator, typename... ForwardIterators>
+inline void for_each_leaf_aux(const execution::sequenced_policy& policy,
+                              Op                                 op,
+                              ForwardIterator                    first,
+                              ForwardIterator                    last,
+                              ForwardIterators...                firsts) {
+  if constexpr (Chunked) {
+    for_each_chunk_aux(policy, op, first, last, firsts...);
+  } else {
+    for_each_aux(policy, op, first, last, firsts...);
+  }
+}
+
+/*
+ * Iterators that become random-access iterators over contiguous (or computable) elements of
+ * an arithmetic type after automatic checkout. Loop functions use chunked leaf loops for them.
+ */
+template <typename T>
+struct is_contiguous_leaf_iterator : public std::is_pointer<T> {};
+
+template <typename T, typename Mode>
+struct is_contiguous_leaf_iterator<global_iterator<T, Mode>>
+  : public std::bool_constant<global_iterator<T, Mode>::auto_checkout> {};
+
+template <typename T>
+struct is_contiguous_leaf_iterator<count_iterator<T>> : public std::true_type {};
+
+template <typename ForwardIterator>
+struct has_arithmetic_value_type
+  : public std::is_arithmetic<typename std::iterator_traits<ForwardIterator>::value_type> {};
+
+template <typename... ForwardIterators>
+inline constexpr bool is_vectorizable_leaf_v =
+  (std::conjunction_v<is_contiguous_leaf_iterator<ForwardIterators>,
+                      has_arithmetic_value_type<ForwardIterators>> && ...);
+
 }
 
 }
@@ -0,0 +1,296 @@
+#pragma once
+
+#include <cstring>
+#include <vector>
+
+#include "ityr/common/util.hpp"
+#include "ityr/ito/ito.hpp"
+#include "ityr/ori/ori.hpp"
+#include "ityr/pattern/root_exec.hpp"
+
+namespace ityr {
+
+/**
+ * @brief Group of a dynamic number of child tasks.
+ *
+ * Tasks are registered to a task group by `ityr::task_group::run()` and executed in parallel by
+ * `ityr::task_group::wait()`, which blocks the current thread until all of the registered tasks are
+ * completed. This is useful when the number of child tasks is determined at runtime (e.g., one task
+ * for each child of a tree node or for each graph partition).
+ *
+ * Unlike forking `ityr::ito::thread`s one by one and joining them sequentially, `wait()` arranges
+ * the registered tasks as a balanced binary spawn tree, in which both forks and joins have
+ * logarithmic depth. Release and acquire fences for global memory are issued once per task group
+ * (and at forks/joins only if tasks are actually migrated), in the same manner as `ityr::for_each()`.
+ * The amount of work of each task can be optionally given to `run()`, which is used as work hints
+ * for the ADWS scheduler to distribute tasks over processes in proportion to their work.
+ *
+ * Registered tasks are kept in global memory until `wait()` is called, so that they can be executed
+ * by any process. Thus, task function objects must be trivially copyable, and their size must be
+ * at most `ityr::task_group::max_task_size` bytes. As with other fork/join functions, tasks must not
+ * refer to objects on the parent thread's stack, but they can create nested task groups.
+ *
+ * The executing process can be changed across `wait()` (due to thread migration), but not across
+ * `run()`.
+ *
+ * Example:
+ * ```
+ * ityr::root_exec([=] {
+ *   ityr::task_group tg;
+ *   for (std::size_t i = 0; i < n_children; i++) {
+ *     tg.run([=] { process_child(i); });
+ *   }
+ *   // or with the amount of work for each task
+ *   tg.run([=] { process_large_child(); }, 10.0);
+ *   tg.wait();
+ * });
+ * ```
+ *
+ * @see `ityr::parallel_invoke()`
+ */
+class task_group {
+public:
+  /**
+   * @brief The maximum size of task function objects.
+   */
+  static constexpr std::size_t max_task_size = 128;
+
+  task_group() {}
+
+  ~task_group() {
+    ITYR_CHECK_MESSAGE(n_tasks_ == 0, "ityr::task_group must be waited for before destruction");
+    if (tasks_) {
+      ori::free(tasks_, capacity_);
+    }
+  }
+
+  task_group(const task_group&) = delete;
+  task_group& operator=(const task_group&) = delete;
+
+  /**
+   * @brief Register a task to the task group.
+   *
+   * @param fn   Function object to be called as `fn()` in parallel.
+   * @param work Amount of work of the task (relative to other tasks in the task group).
+   *
+   * The task is not started until `ityr::task_group::wait()` is called.
+   */
+  template <typename Fn>
+  void run(Fn fn, double work = 1.0) {
+    static_assert(std::is_trivially_copyable_v<Fn>,
+                  "Tasks in ityr::task_group must be trivially copyable");
+    static_assert(sizeof(Fn) <= max_task_size,
+                  "Tasks in ityr::task_group are too large");
+    static_assert(alignof(Fn) <= alignof(std::max_align_t));
+    ITYR_CHECK(work > 0);
+
+    if (n_tasks_ == capacity_) {
+      grow();
+    }
+
+    total_work_ += work;
+    uniform_work_ &= (work == 1.0);
+
+    task_entry t;
+    t.handler  = &handler<Fn>;
+    t.work_end = total_work_;
+    std::memcpy(t.payload, &fn, sizeof(Fn));
+    ori::put(&t, tasks_ + n_tasks_, 1);
+
+    n_tasks_++;
+  }
+
+  /**
+   * @brief Execute all of the registered tasks in parallel and wait for their completion.
+   *
+   * The task group can be reused after this call.
+   */
+  void wait() {
+    if (n_tasks_ == 0) return;
+
+    auto rh = ori::release_lazy();
+    run_tasks(tasks_, uniform_work_, rh, 0, n_tasks_, 0.0, total_work_);
+
+    n_tasks_      = 0;
+    total_work_   = 0.0;
+    uniform_work_ = true;
+  }
+
+  /**
+   * @brief The number of tasks registered but not yet waited for.
+   */
+  std::size_t size() const { return n_tasks_; }
+
+private:
+  using handler_t = void (*)(const void*);
+
+  template <typename Fn>
+  static void handler(const void* payload) {
+    (*reinterpret_cast<const Fn*>(payload))();
+  }
+
+  struct task_entry {
+    handler_t                           handler;
+    double                              work_end; // cumulative amount of work up to this task
+    alignas(std::max_align_t) std::byte payload[max_task_size];
+  };
+
+  static constexpr std::size_t initial_capacity = 16;
+
+  void grow() {
+    std::size_t new_capacity = std::max(capacity_ * 2, initial_capacity);
+    ori::global_ptr<task_entry> new_tasks = ori::malloc<task_entry>(new_capacity);
+
+    if (tasks_) {
+      // No thread migration happens here, so local buffers can be used
+      std::vector<task_entry> buf(n_tasks_);
+      ori::get(tasks_, buf.data(), n_tasks_);
+      ori::put(buf.data(), new_tasks, n_tasks_);
+      ori::free(tasks_, capacity_);
+    }
+
+    tasks_    = new_tasks;
+    capacity_ = new_capacity;
+  }
+
+  // `tasks` and other states are passed by value, as the task group object on the parent's stack
+  // cannot be accessed by tasks migrated to other processes
+  static void run_tasks(ori::global_ptr<task_entry> tasks,
+                        bool                        uniform_work,
+                        ori::release_handler        rh,
+                        std::size_t                 b,
+                        std::size_t                 e,
+                        double                      w_b,
+                        double                      w_e) {
+    ori::poll();
+
+    // for immediately executing cross-worker tasks in ADWS
+    ito::poll([] { return ori::release_lazy(); },
+              [&](ori::release_handler rh_) { ori::acquire(rh); ori::acquire(rh_); });
+
+    if (e - b == 1) {
+      task_entry t = tasks[b].get();
+      t.handler(t.payload);
+      return;
+    }
+
+    std::size_t mid = b + (e - b) / 2;
+    double w_mid = uniform_work ? static_cast<double>(mid)
+                                : ((tasks + (mid - 1))->*(&task_entry::work_end)).get();
+
+    auto tgdata = ito::task_group_begin();
+
+    ito::thread<void> th(
+        ito::with_callback, [=] { ori::acquire(rh); }, [] { ori::release(); },
+        ito::with_workhint, w_mid - w_b, w_e - w_mid,
+        [=] {
+          run_tasks(tasks, uniform_work, rh, b, mid, w_b, w_mid);
+        });
+
+    run_tasks(tasks, uniform_work, rh, mid, e, w_mid, w_e);
+
+    if (!th.serialized()) {
+      ori::release();
+    }
+
+    th.join();
+
+    ito::task_group_end(tgdata, [] { ori::release(); }, [] { ori::acquire(); });
+
+    if (!th.serialized()) {
+      ori::acquire();
+    }
+  }
+
+  ori::global_ptr<task_entry> tasks_;
+  std::size_t                 capacity_     = 0;
+  std::size_t                 n_tasks_      = 0;
+  double                      total_work_   = 0.0;
+  bool                        uniform_work_ = true;
+};
+
+ITYR_TEST_CASE("[ityr::task_group] run and wait") {
+  ito::init();
+  ori::init();
+
+  long n = 1000;
+  ori::global_ptr<long> p = ori::malloc_coll<long>(n);
+
+  ITYR_SUBCASE("uniform tasks") {
+    root_exec([=] {
+      task_group tg;
+      for (long i = 0; i < n; i++) {
+        tg.run([=] { p[i].put(i); });
+      }
+      ITYR_CHECK(tg.size() == std::size_t(n));
+      tg.wait();
+      ITYR_CHECK(tg.size() == 0);
+
+      for (long i = 0; i < n; i++) {
+        ITYR_CHECK(p[i].get() == i);
+      }
+
+      // reuse the task group
+      for (long i = 0; i < n; i++) {
+        tg.run([=] { p[i].put(i * 2); });
+      }
+      tg.wait();
+
+      for (long i = 0; i < n; i++) {
+        ITYR_CHECK(p[i].get() == i * 2);
+      }
+    });
+  }
+
+  ITYR_SUBCASE("weighted tasks") {
+    root_exec([=] {
+      task_group tg;
+      for (long i = 0; i < n; i++) {
+        tg.run([=] { p[i].put(i + 1); }, static_cast<double>(i % 7 + 1));
+      }
+      tg.wait();
+    });
+
+    root_exec([=] {
+      for (long i = 0; i < n; i++) {
+        ITYR_CHECK(p[i].get() == i + 1);
+      }
+    });
+  }
+
+  ITYR_SUBCASE("nested task groups") {
+    root_exec([=] {
+      task_group tg;
+      long m = 10;
+      for (long i = 0; i < n; i += m) {
+        tg.run([=] {
+          task_group tg_inner;
+          for (long j = i; j < std::min(i + m, n); j++) {
+            tg_inner.run([=] { p[j].put(-j); });
+          }
+          tg_inner.wait();
+        });
+      }
+      tg.wait();
+
+      for (long i = 0; i < n; i++) {
+        ITYR_CHECK(p[i].get() == -i);
+      }
+    });
+  }
+
+  ITYR_SUBCASE("empty task group") {
+    root_exec([=] {
+      task_group tg;
+      tg.wait();
+      ITYR_CHECK(tg.size() == 0);
+    });
+  }
+
+  ori::free_coll(p);
+
+  ori::fini();
+  ito::fini();
+}
+
+}
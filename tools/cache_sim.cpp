@@ -0,0 +1,458 @@
+/*
+ * Offline cache simulator for global memory access traces
+ *
+ * Replays access traces recorded by programs compiled with `-DITYR_ORI_ACCESS_TRACE=enabled`
+ * (`ityr_access_trace_<rank>.ignore` written by each process in the working directory) and
+ * reports the predicted amount of communication and cache hit rates for every combination of
+ * the given cache sizes, block sizes, sub-block sizes, eviction policies, and memory mappers of
+ * collective memory. Accesses are recorded only between `ityr::profiler_begin()` and
+ * `ityr::profiler_end()`.
+ *
+ * The trace of each process is replayed on its own cache model, which follows the cache manager
+ * of Itoyori: data at remote processes are fetched in units of sub-blocks into cache blocks,
+ * write-only checkouts skip fetching, dirty data are written back at release fences (or when
+ * too many blocks are dirty), and all cache blocks are invalidated at acquire fences. Data at
+ * the processes within the same node (`-n`) are accessed directly without caching. Reference
+ * counts of cache blocks are not simulated, and thus the cache never becomes exhausted.
+ *
+ * Example:
+ *   ./cache_sim.out -c 16M,64M -s 4K,16K -e lru,fifo -m cyclic,block ityr_access_trace_*.ignore
+ */
+
+#include <unistd.h>
+#include <list>
+#include <map>
+#include <random>
+#include <unordered_map>
+
+#include "ityr/ori/access_trace.hpp"
+#include "ityr/ori/block_regions.hpp"
+#include "ityr/ori/mem_mapper.hpp"
+
+using ityr::ori::block_size_t;
+using ityr::ori::block_region;
+using ityr::ori::block_regions;
+using ityr::ori::access_trace_event;
+using ityr::ori::access_trace_mode;
+using ityr::ori::access_trace_record;
+using ityr::ori::access_trace_reader;
+
+enum class eviction_policy { lru, fifo, random };
+
+struct sim_config {
+  std::size_t     cache_size;
+  block_size_t    block_size;
+  block_size_t    sub_block_size;
+  eviction_policy policy;
+  std::string     mapper;
+};
+
+struct sim_stats {
+  std::size_t requested_bytes    = 0; // requested by checkout/get/put calls to remote data
+  std::size_t home_bytes         = 0; // requested to data within the same node (not cached)
+  std::size_t fetched_bytes      = 0;
+  std::size_t written_back_bytes = 0;
+  std::size_t block_hit_count    = 0;
+  std::size_t block_miss_count   = 0;
+  std::size_t eviction_count     = 0;
+
+  sim_stats& operator+=(const sim_stats& s) {
+    requested_bytes    += s.requested_bytes;
+    home_bytes         += s.home_bytes;
+    fetched_bytes      += s.fetched_bytes;
+    written_back_bytes += s.written_back_bytes;
+    block_hit_count    += s.block_hit_count;
+    block_miss_count   += s.block_miss_count;
+    eviction_count     += s.eviction_count;
+    return *this;
+  }
+};
+
+std::vector<std::size_t> cache_sizes;
+std::vector<std::size_t> block_sizes;
+std::vector<std::size_t> sub_block_sizes = {4096};
+std::vector<std::string> policies        = {"lru"};
+std::vector<std::string> mappers         = {"cyclic"};
+int                      ranks_per_node  = 1;
+
+template <block_size_t BlockSize>
+class cache_model {
+public:
+  cache_model(const sim_config& cfg, int rank, int n_ranks)
+    : cfg_(cfg),
+      rank_(rank),
+      n_ranks_(n_ranks),
+      n_entries_(std::max(std::size_t(1), cfg.cache_size / BlockSize)),
+      max_dirty_blocks_(std::max(std::size_t(1), n_entries_ / 2)) {}
+
+  void replay(const access_trace_record& r) {
+    switch (r.event) {
+      case access_trace_event::checkout:
+      case access_trace_event::get:
+        access(r, false);
+        break;
+      case access_trace_event::checkin:
+        access(r, true);
+        break;
+      case access_trace_event::put:
+        access(r, false);
+        access(r, true);
+        break;
+      case access_trace_event::release:
+        writeback_all();
+        break;
+      case access_trace_event::acquire:
+        writeback_all();
+        for (auto& [key, e] : entries_) {
+          e.valid.clear();
+        }
+        break;
+      case access_trace_event::alloc_coll:
+        allocs_[r.addr] = {r.size, make_mapper(r.size)};
+        break;
+      case access_trace_event::free_coll:
+        writeback_all();
+        evict_range(r.addr, r.addr + r.size);
+        allocs_.erase(r.addr);
+        break;
+    }
+  }
+
+  const sim_stats& stats() const { return stats_; }
+
+private:
+  struct entry {
+    block_regions                  valid;
+    block_regions                  dirty;
+    std::list<uintptr_t>::iterator order_it;
+    std::size_t                    key_idx;
+  };
+
+  std::unique_ptr<ityr::ori::mem_mapper::base> make_mapper(std::size_t size) const {
+    if (cfg_.mapper == "block") {
+      return std::make_unique<ityr::ori::mem_mapper::block<BlockSize>>(size, n_ranks_);
+    } else if (cfg_.mapper == "cyclic") {
+      return std::make_unique<ityr::ori::mem_mapper::cyclic<BlockSize>>(size, n_ranks_);
+    } else {
+      ITYR_CHECK(cfg_.mapper == "block_adws");
+      return std::make_unique<ityr::ori::mem_mapper::block_adws<BlockSize>>(size, n_ranks_);
+    }
+  }
+
+  // Returns -1 if the address does not belong to any collective allocation
+  int get_coll_owner(uintptr_t addr) const {
+    auto it = allocs_.upper_bound(addr);
+    if (it == allocs_.begin()) return -1;
+    --it;
+    auto& [size, mapper] = it->second;
+    std::size_t offset = addr - it->first;
+    if (offset >= mapper->effective_size()) return -1;
+    return mapper->get_segment(offset).owner;
+  }
+
+  void access(const access_trace_record& r, bool checkin) {
+    uintptr_t addr_b = r.addr;
+    uintptr_t addr_e = r.addr + r.size;
+
+    for (uintptr_t blk_addr = ityr::common::round_down_pow2(addr_b, uintptr_t(BlockSize));
+         blk_addr < addr_e; blk_addr += BlockSize) {
+      block_region br = {std::max(addr_b, blk_addr) - blk_addr,
+                         std::min(addr_e, blk_addr + BlockSize) - blk_addr};
+
+      int owner = r.owner >= 0 ? r.owner : get_coll_owner(blk_addr + br.begin);
+      if (owner < 0) continue;
+
+      if (owner / ranks_per_node == rank_ / ranks_per_node) {
+        if (!checkin) {
+          stats_.home_bytes += br.size();
+        }
+        continue;
+      }
+
+      if (!checkin) {
+        checkout_blk(blk_addr, br, r.mode);
+      } else if (r.mode != access_trace_mode::read) {
+        checkin_blk(blk_addr, br);
+      }
+    }
+  }
+
+  void checkout_blk(uintptr_t blk_addr, block_region br, access_trace_mode mode) {
+    entry& e = get_entry(blk_addr);
+
+    stats_.requested_bytes += br.size();
+
+    if (mode == access_trace_mode::write) {
+      e.valid.add(br);
+      stats_.block_hit_count++;
+    } else if (e.valid.include(br)) {
+      stats_.block_hit_count++;
+    } else {
+      block_region br_pad = {ityr::common::round_down_pow2(br.begin, cfg_.sub_block_size),
+                             ityr::common::round_up_pow2(br.end, cfg_.sub_block_size)};
+      stats_.fetched_bytes += e.valid.inverse(br_pad).size();
+      e.valid.add(br_pad);
+      stats_.block_miss_count++;
+    }
+  }
+
+  void checkin_blk(uintptr_t blk_addr, block_region br) {
+    entry& e = get_entry(blk_addr);
+
+    if (e.dirty.empty()) {
+      dirty_keys_.push_back(blk_addr);
+    }
+    e.dirty.add(br);
+
+    if (dirty_keys_.size() >= max_dirty_blocks_) {
+      writeback_all();
+    }
+  }
+
+  entry& get_entry(uintptr_t blk_addr) {
+    auto it = entries_.find(blk_addr);
+    if (it != entries_.end()) {
+      if (cfg_.policy == eviction_policy::lru) {
+        order_.splice(order_.end(), order_, it->second.order_it);
+      }
+      return it->second;
+    }
+
+    if (entries_.size() >= n_entries_) {
+      evict(choose_victim());
+      stats_.eviction_count++;
+    }
+
+    entry& e = entries_[blk_addr];
+    e.order_it = order_.insert(order_.end(), blk_addr);
+    e.key_idx  = keys_.size();
+    keys_.push_back(blk_addr);
+    return e;
+  }
+
+  uintptr_t choose_victim() {
+    if (cfg_.policy == eviction_policy::random) {
+      return keys_[std::uniform_int_distribution<std::size_t>(0, keys_.size() - 1)(rng_)];
+    } else {
+      return order_.front();
+    }
+  }
+
+  void evict(uintptr_t blk_addr) {
+    auto it = entries_.find(blk_addr);
+    ITYR_CHECK(it != entries_.end());
+
+    entry& e = it->second;
+    if (!e.dirty.empty()) {
+      // The cache manager writes back all dirty blocks if no evictable block is found
+      writeback_all();
+    }
+
+    order_.erase(e.order_it);
+    keys_[e.key_idx] = keys_.back();
+    entries_[keys_[e.key_idx]].key_idx = e.key_idx;
+    keys_.pop_back();
+    entries_.erase(it);
+  }
+
+  void evict_range(uintptr_t addr_b, uintptr_t addr_e) {
+    for (uintptr_t blk_addr = ityr::common::round_down_pow2(addr_b, uintptr_t(BlockSize));
+         blk_addr < addr_e; blk_addr += BlockSize) {
+      if (entries_.count(blk_addr)) {
+        evict(blk_addr);
+      }
+    }
+  }
+
+  void writeback_all() {
+    for (uintptr_t blk_addr : dirty_keys_) {
+      entry& e = entries_[blk_addr];
+      stats_.written_back_bytes += e.dirty.size();
+      e.dirty.clear();
+    }
+    dirty_keys_.clear();
+  }
+
+  sim_config                               cfg_;
+  int                                      rank_;
+  int                                      n_ranks_;
+  std::size_t                              n_entries_;
+  std::size_t                              max_dirty_blocks_;
+  std::unordered_map<uintptr_t, entry>     entries_;
+  std::list<uintptr_t>                     order_; // the front is the victim for LRU/FIFO
+  std::vector<uintptr_t>                   keys_;  // for random eviction
+  std::vector<uintptr_t>                   dirty_keys_;
+  std::mt19937                             rng_{0};
+  sim_stats                                stats_;
+
+  // collective allocations: address -> (size, memory mapper)
+  std::map<uintptr_t, std::pair<std::size_t, std::unique_ptr<ityr::ori::mem_mapper::base>>> allocs_;
+};
+
+template <block_size_t BlockSize>
+sim_stats simulate_impl(const sim_config& cfg, const std::vector<std::string>& trace_files) {
+  sim_stats total;
+  for (const auto& filename : trace_files) {
+    access_trace_reader reader(filename);
+    cache_model<BlockSize> cm(cfg, reader.header().rank, reader.header().n_ranks);
+
+    access_trace_record r;
+    while (reader.next(r)) {
+      cm.replay(r);
+    }
+    total += cm.stats();
+  }
+  return total;
+}
+
+constexpr block_size_t min_block_size = block_size_t(1) << 12;
+constexpr block_size_t max_block_size = block_size_t(1) << 22;
+
+// The memory mappers require compile-time block sizes
+template <block_size_t BlockSize = min_block_size>
+sim_stats simulate(const sim_config& cfg, const std::vector<std::string>& trace_files) {
+  if constexpr (BlockSize < max_block_size) {
+    if (cfg.block_size != BlockSize) {
+      return simulate<BlockSize * 2>(cfg, trace_files);
+    }
+  }
+  ITYR_CHECK(cfg.block_size == BlockSize);
+  return simulate_impl<BlockSize>(cfg, trace_files);
+}
+
+eviction_policy parse_policy(const std::string& s) {
+  if (s == "fifo") return eviction_policy::fifo;
+  if (s == "random") return eviction_policy::random;
+  if (s != "lru") {
+    ityr::common::die("Unknown eviction policy: %s", s.c_str());
+  }
+  return eviction_policy::lru;
+}
+
+std::vector<std::string> split(const std::string& s) {
+  std::vector<std::string> ret;
+  std::stringstream ss(s);
+  std::string item;
+  while (std::getline(ss, item, ',')) {
+    if (!item.empty()) ret.push_back(item);
+  }
+  return ret;
+}
+
+// Accepts K/M/G suffixes (e.g., 64K)
+std::vector<std::size_t> parse_sizes(const std::string& s) {
+  std::vector<std::size_t> ret;
+  for (const auto& item : split(s)) {
+    std::size_t v = std::stoull(item);
+    switch (item.back()) {
+      case 'K': case 'k': v *= std::size_t(1) << 10; break;
+      case 'M': case 'm': v *= std::size_t(1) << 20; break;
+      case 'G': case 'g': v *= std::size_t(1) << 30; break;
+    }
+    ret.push_back(v);
+  }
+  return ret;
+}
+
+void show_help_and_exit(int argc [[maybe_unused]], char** argv) {
+  printf("Usage: %s [options] trace_files...\n"
+         "  options (comma-separated lists are simulated for all combinations):\n"
+         "    -c : cache sizes per process (default: 16M)\n"
+         "    -b : block sizes (default: the block size of the traced program)\n"
+         "    -s : sub-block sizes (default: 4K)\n"
+         "    -e : eviction policies (lru, fifo, random) (default: lru)\n"
+         "    -m : memory mappers of collective memory (block, cyclic, block_adws) (default: cyclic)\n"
+         "    -n : # of processes per node, whose data are accessed without caching (default: 1)\n", argv[0]);
+  exit(1);
+}
+
+int main(int argc, char** argv) {
+  int opt;
+  while ((opt = getopt(argc, argv, "c:b:s:e:m:n:h")) != EOF) {
+    switch (opt) {
+      case 'c':
+        cache_sizes = parse_sizes(optarg);
+        break;
+      case 'b':
+        block_sizes = parse_sizes(optarg);
+        break;
+      case 's':
+        sub_block_sizes = parse_sizes(optarg);
+        break;
+      case 'e':
+        policies = split(optarg);
+        break;
+      case 'm':
+        mappers = split(optarg);
+        break;
+      case 'n':
+        ranks_per_node = atoi(optarg);
+        break;
+      case 'h':
+      default:
+        show_help_and_exit(argc, argv);
+    }
+  }
+
+  std::vector<std::string> trace_files(argv + optind, argv + argc);
+  if (trace_files.empty() || ranks_per_node <= 0) {
+    show_help_and_exit(argc, argv);
+  }
+
+  if (cache_sizes.empty()) {
+    cache_sizes = {std::size_t(16) * 1024 * 1024};
+  }
+  if (block_sizes.empty()) {
+    block_sizes = {access_trace_reader(trace_files[0]).header().block_size};
+  }
+
+  for (std::size_t bs : block_sizes) {
+    if (!ityr::common::is_pow2(bs) || bs < min_block_size || bs > max_block_size) {
+      ityr::common::die("Block sizes must be powers of two within [%u, %u] (%ld given)",
+                        min_block_size, max_block_size, bs);
+    }
+  }
+
+  for (const auto& policy : policies) {
+    parse_policy(policy);
+  }
+
+  for (const auto& mapper : mappers) {
+    if (mapper != "block" && mapper != "cyclic" && mapper != "block_adws") {
+      ityr::common::die("Unknown memory mapper: %s", mapper.c_str());
+    }
+  }
+
+  setlocale(LC_NUMERIC, "en_US.UTF-8");
+  printf("# of trace files: %ld\n\n", trace_files.size());
+  printf("%12s %10s %10s %7s %11s %18s %18s %18s %18s %9s\n",
+         "cache size", "block", "sub-block", "policy", "mapper",
+         "requested (B)", "home (B)", "fetched (B)", "written back (B)", "hit rate");
+
+  for (std::size_t cache_size : cache_sizes) {
+    for (std::size_t block_size : block_sizes) {
+      for (std::size_t sub_block_size : sub_block_sizes) {
+        if (!ityr::common::is_pow2(sub_block_size) || sub_block_size > block_size) continue;
+
+        for (const auto& policy : policies) {
+          for (const auto& mapper : mappers) {
+            sim_config cfg {cache_size, block_size_t(block_size), block_size_t(sub_block_size),
+                            parse_policy(policy), mapper};
+            sim_stats s = simulate(cfg, trace_files);
+
+            std::size_t n_blk_accesses = s.block_hit_count + s.block_miss_count;
+            double hit_rate = n_blk_accesses ? static_cast<double>(s.block_hit_count) / n_blk_accesses : 0;
+
+            printf("%12ld %10ld %10ld %7s %11s %'18ld %'18ld %'18ld %'18ld %8.2f%%\n",
+                   cache_size, block_size, sub_block_size, policy.c_str(), mapper.c_str(),
+                   s.requested_bytes, s.home_bytes, s.fetched_bytes, s.written_back_bytes,
+                   hit_rate * 100);
+            fflush(stdout);
+          }
+        }
+      }
+    }
+  }
+
+  return 0;
+}